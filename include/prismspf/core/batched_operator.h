@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef batched_operator_h
+#define batched_operator_h
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/matrix_free_operator.h>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Block diagonal operator for a batch of decoupled fields that are solved
+ * together. Each block is applied with the operator of its field, so the user
+ * implementation is evaluated exactly as for single solves. All blocks are handled in a
+ * single loop over the cells, so the ghost exchanges of the blocks overlap. Each operator
+ * still evaluates its own FEEvaluation data on each cell batch.
+ */
+template <int dim, int degree, typename number>
+class batchedOperator
+{
+public:
+  using OperatorType    = matrixFreeOperator<dim, degree, number>;
+  using VectorType      = dealii::LinearAlgebra::distributed::Vector<number>;
+  using BlockVectorType = dealii::LinearAlgebra::distributed::BlockVector<number>;
+  using size_type       = dealii::VectorizedArray<number>;
+
+  /**
+   * \brief Constructor. The operators must share the matrix-free object.
+   */
+  explicit batchedOperator(const std::vector<const OperatorType *> &_operators);
+
+  /**
+   * \brief Matrix-vector multiplication.
+   */
+  void
+  vmult(BlockVectorType &dst, const BlockVectorType &src) const;
+
+  /**
+   * \brief Matrix-vector multiplication of the active blocks. The other blocks of dst
+   * are set to zero.
+   */
+  void
+  vmult(BlockVectorType         &dst,
+        const BlockVectorType   &src,
+        const std::vector<bool> &active) const;
+
+private:
+  /**
+   * \brief Operators of the fields, in the order of the blocks.
+   */
+  std::vector<const OperatorType *> operators;
+};
+
+template <int dim, int degree, typename number>
+batchedOperator<dim, degree, number>::batchedOperator(
+  const std::vector<const OperatorType *> &_operators)
+  : operators(_operators)
+{
+  Assert(!operators.empty(), dealii::ExcMessage("The batch must not be empty."));
+  for (const auto *op : operators)
+    {
+      Assert(op->get_matrix_free() == operators.front()->get_matrix_free(),
+             dealii::ExcMessage(
+               "The operators of a batch must share the matrix-free object."));
+    }
+}
+
+template <int dim, int degree, typename number>
+inline void
+batchedOperator<dim, degree, number>::vmult(BlockVectorType       &dst,
+                                            const BlockVectorType &src) const
+{
+  vmult(dst, src, std::vector<bool>(operators.size(), true));
+}
+
+template <int dim, int degree, typename number>
+inline void
+batchedOperator<dim, degree, number>::vmult(BlockVectorType         &dst,
+                                            const BlockVectorType   &src,
+                                            const std::vector<bool> &active) const
+{
+  Assert(dst.n_blocks() == operators.size() && src.n_blocks() == operators.size(),
+         dealii::ExcMessage("The number of blocks must match the number of operators."));
+  Assert(active.size() == operators.size(),
+         dealii::ExcMessage("There must be one active flag per block."));
+
+  const std::function<void(const dealii::MatrixFree<dim, number, size_type> &,
+                           BlockVectorType &,
+                           const BlockVectorType &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    local_vmult = [&](const dealii::MatrixFree<dim, number, size_type> &data,
+                      BlockVectorType                                  &local_dst,
+                      const BlockVectorType                            &local_src,
+                      const std::pair<unsigned int, unsigned int>      &cell_range)
+  {
+    for (unsigned int block = 0; block < operators.size(); ++block)
+      {
+        if (active[block])
+          {
+            operators[block]->local_vmult(data,
+                                          local_dst.block(block),
+                                          local_src.block(block),
+                                          cell_range);
+          }
+      }
+  };
+
+  operators.front()->get_matrix_free()->cell_loop(local_vmult, dst, src, true);
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -12,6 +12,7 @@
 #include <prismspf/user_inputs/user_input_parameters.h>
 
 #include <map>
+#include <utility>
 #include <vector>
 
 PRISMS_PF_BEGIN_NAMESPACE
@@ -23,6 +24,12 @@ template <int dim>
 class dofHandler
 {
 public:
+  /**
+   * \brief Finite element systems, keyed by the field type and the degree reduction of
+   * the fields that use them.
+   */
+  using FESystemMap = std::map<std::pair<fieldType, unsigned int>, dealii::FESystem<dim>>;
+
   /**
    * \brief Constructor.
    */
@@ -37,8 +44,14 @@ public:
    * \brief Initialize the DoFHandlers
    */
   void
-  init(const triangulationHandler<dim>                  &triangulation_handler,
-       const std::map<fieldType, dealii::FESystem<dim>> &fe_system);
+  init(const triangulationHandler<dim> &triangulation_handler,
+       const FESystemMap               &fe_system);
+
+  /**
+   * \brief Redistribute the DoFs after the triangulation has been refined or coarsened.
+   */
+  void
+  reinit(const FESystemMap &fe_system);
 
   /**
    * \brief Collection of the triangulation DoFs. The number of DoFHandlers should be
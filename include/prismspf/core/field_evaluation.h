@@ -0,0 +1,564 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef field_evaluation_h
+#define field_evaluation_h
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/matrix_free/evaluation_flags.h>
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+
+#include <memory>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Evaluation of a field on the cells of the matrix-free object. Fields with the
+ * degree of the problem use an FEEvaluation with a compile-time degree. Fields with a
+ * reduced degree use one with a runtime degree, which is slower but is still evaluated
+ * at the quadrature points of the problem degree. This way, kernels read and submit all
+ * fields at the same points, regardless of their degree.
+ *
+ * Every call checks which of the two evaluations is set. The check is fixed for the
+ * lifetime of the object, so the branch is always predicted correctly and its cost is
+ * negligible next to the sum factorization of the cell-level calls. The members are
+ * inline, so the per quadrature point calls are the calls of the FEEvaluation, behind
+ * one predictable branch. Fields with the degree of the problem keep the compile-time
+ * kernels, which is where the runtime degree would cost the most.
+ */
+template <int dim, int degree, int n_components, typename number>
+class fieldEvaluation
+{
+public:
+  using FastEvaluation =
+    dealii::FEEvaluation<dim, degree, degree + 1, n_components, number>;
+  using ReducedEvaluation = dealii::FEEvaluation<dim, -1, 0, n_components, number>;
+  using size_type         = dealii::VectorizedArray<number>;
+  using value_type        = typename FastEvaluation::value_type;
+  using gradient_type     = typename FastEvaluation::gradient_type;
+
+  /**
+   * \brief Constructor.
+   */
+  fieldEvaluation(const dealii::MatrixFree<dim, number, size_type> &data,
+                  const unsigned int                               &dof_index);
+
+  /**
+   * \brief Initialize the cell batch.
+   */
+  void
+  reinit(const unsigned int &cell);
+
+  /**
+   * \brief Read the dof values of the given vector, without the constraints.
+   */
+  template <typename VectorType>
+  void
+  read_dof_values_plain(const VectorType &src);
+
+  /**
+   * \brief Read the dof values of the given vector and resolve the constraints, such as
+   * hanging nodes.
+   */
+  template <typename VectorType>
+  void
+  read_dof_values(const VectorType &src);
+
+  /**
+   * \brief Evaluate the given quantities at the quadrature points.
+   */
+  void
+  evaluate(const dealii::EvaluationFlags::EvaluationFlags &flags);
+
+  /**
+   * \brief Integrate the submitted quantities.
+   */
+  void
+  integrate(const dealii::EvaluationFlags::EvaluationFlags &flags);
+
+  /**
+   * \brief Integrate the submitted quantities and add them to the given vector.
+   */
+  template <typename VectorType>
+  void
+  integrate_scatter(const dealii::EvaluationFlags::EvaluationFlags &flags,
+                    VectorType                                     &dst);
+
+  /**
+   * \brief Add the dof values to the given vector.
+   */
+  template <typename VectorType>
+  void
+  distribute_local_to_global(VectorType &dst) const;
+
+  /**
+   * \brief Return a pointer to the dof values.
+   */
+  [[nodiscard]] size_type *
+  begin_dof_values();
+
+  /**
+   * \brief Return a pointer to the values at the quadrature points.
+   */
+  [[nodiscard]] size_type *
+  begin_values();
+
+  /**
+   * \brief Return a pointer to the gradients at the quadrature points.
+   */
+  [[nodiscard]] size_type *
+  begin_gradients();
+
+  /**
+   * \brief Return the value of the given dof.
+   */
+  [[nodiscard]] value_type
+  get_dof_value(const unsigned int &dof) const;
+
+  /**
+   * \brief Set the value of the given dof.
+   */
+  void
+  submit_dof_value(const value_type &value, const unsigned int &dof);
+
+  /**
+   * \brief Return the value at the given quadrature point.
+   */
+  [[nodiscard]] value_type
+  get_value(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the gradient at the given quadrature point.
+   */
+  [[nodiscard]] gradient_type
+  get_gradient(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the hessian at the given quadrature point.
+   */
+  [[nodiscard]] auto
+  get_hessian(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the diagonal of the hessian at the given quadrature point.
+   */
+  [[nodiscard]] auto
+  get_hessian_diagonal(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the laplacian at the given quadrature point.
+   */
+  [[nodiscard]] auto
+  get_laplacian(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the divergence at the given quadrature point.
+   */
+  [[nodiscard]] auto
+  get_divergence(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the symmetric gradient at the given quadrature point.
+   */
+  [[nodiscard]] auto
+  get_symmetric_gradient(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return the curl at the given quadrature point.
+   */
+  [[nodiscard]] auto
+  get_curl(const unsigned int &q_point) const;
+
+  /**
+   * \brief Submit a value at the given quadrature point.
+   */
+  void
+  submit_value(const value_type &value, const unsigned int &q_point);
+
+  /**
+   * \brief Submit a gradient at the given quadrature point.
+   */
+  void
+  submit_gradient(const gradient_type &gradient, const unsigned int &q_point);
+
+  /**
+   * \brief Return the location of the given quadrature point.
+   */
+  [[nodiscard]] dealii::Point<dim, size_type>
+  quadrature_point(const unsigned int &q_point) const;
+
+  /**
+   * \brief Return whether the field has a reduced degree.
+   */
+  [[nodiscard]] bool
+  is_reduced() const;
+
+  /**
+   * \brief Number of dofs per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+  /**
+   * \brief Number of quadrature points per cell.
+   */
+  const unsigned int n_q_points;
+
+private:
+  /**
+   * \brief Evaluation for fields with the degree of the problem.
+   */
+  std::unique_ptr<FastEvaluation> fast;
+
+  /**
+   * \brief Evaluation for fields with a reduced degree.
+   */
+  std::unique_ptr<ReducedEvaluation> reduced;
+};
+
+template <int dim, int degree, int n_components, typename number>
+fieldEvaluation<dim, degree, n_components, number>::fieldEvaluation(
+  const dealii::MatrixFree<dim, number, size_type> &data,
+  const unsigned int                               &dof_index)
+  : dofs_per_cell(data.get_dofs_per_cell(dof_index))
+  , n_q_points(data.get_n_q_points())
+{
+  const auto fe_degree =
+    static_cast<int>(data.get_dof_handler(dof_index).get_fe().degree);
+  if (fe_degree == degree)
+    {
+      fast = std::make_unique<FastEvaluation>(data, dof_index);
+    }
+  else
+    {
+      Assert(fe_degree < degree,
+             dealii::ExcMessage("The degree of a field can't exceed the degree of the "
+                                "problem."));
+      reduced = std::make_unique<ReducedEvaluation>(data, dof_index);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::reinit(const unsigned int &cell)
+{
+  if (fast)
+    {
+      fast->reinit(cell);
+    }
+  else
+    {
+      reduced->reinit(cell);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+template <typename VectorType>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::read_dof_values_plain(
+  const VectorType &src)
+{
+  if (fast)
+    {
+      fast->read_dof_values_plain(src);
+    }
+  else
+    {
+      reduced->read_dof_values_plain(src);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+template <typename VectorType>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::read_dof_values(
+  const VectorType &src)
+{
+  if (fast)
+    {
+      fast->read_dof_values(src);
+    }
+  else
+    {
+      reduced->read_dof_values(src);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::evaluate(
+  const dealii::EvaluationFlags::EvaluationFlags &flags)
+{
+  if (fast)
+    {
+      fast->evaluate(flags);
+    }
+  else
+    {
+      reduced->evaluate(flags);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::integrate(
+  const dealii::EvaluationFlags::EvaluationFlags &flags)
+{
+  if (fast)
+    {
+      fast->integrate(flags);
+    }
+  else
+    {
+      reduced->integrate(flags);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+template <typename VectorType>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::integrate_scatter(
+  const dealii::EvaluationFlags::EvaluationFlags &flags,
+  VectorType                                     &dst)
+{
+  if (fast)
+    {
+      fast->integrate_scatter(flags, dst);
+    }
+  else
+    {
+      reduced->integrate_scatter(flags, dst);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+template <typename VectorType>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::distribute_local_to_global(
+  VectorType &dst) const
+{
+  if (fast)
+    {
+      fast->distribute_local_to_global(dst);
+    }
+  else
+    {
+      reduced->distribute_local_to_global(dst);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline typename fieldEvaluation<dim, degree, n_components, number>::size_type *
+fieldEvaluation<dim, degree, n_components, number>::begin_dof_values()
+{
+  if (fast)
+    {
+      return fast->begin_dof_values();
+    }
+  return reduced->begin_dof_values();
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline typename fieldEvaluation<dim, degree, n_components, number>::size_type *
+fieldEvaluation<dim, degree, n_components, number>::begin_values()
+{
+  if (fast)
+    {
+      return fast->begin_values();
+    }
+  return reduced->begin_values();
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline typename fieldEvaluation<dim, degree, n_components, number>::size_type *
+fieldEvaluation<dim, degree, n_components, number>::begin_gradients()
+{
+  if (fast)
+    {
+      return fast->begin_gradients();
+    }
+  return reduced->begin_gradients();
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline typename fieldEvaluation<dim, degree, n_components, number>::value_type
+fieldEvaluation<dim, degree, n_components, number>::get_dof_value(
+  const unsigned int &dof) const
+{
+  if (fast)
+    {
+      return fast->get_dof_value(dof);
+    }
+  return reduced->get_dof_value(dof);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::submit_dof_value(
+  const value_type   &value,
+  const unsigned int &dof)
+{
+  if (fast)
+    {
+      fast->submit_dof_value(value, dof);
+    }
+  else
+    {
+      reduced->submit_dof_value(value, dof);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline typename fieldEvaluation<dim, degree, n_components, number>::value_type
+fieldEvaluation<dim, degree, n_components, number>::get_value(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_value(q_point);
+    }
+  return reduced->get_value(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline typename fieldEvaluation<dim, degree, n_components, number>::gradient_type
+fieldEvaluation<dim, degree, n_components, number>::get_gradient(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_gradient(q_point);
+    }
+  return reduced->get_gradient(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline auto
+fieldEvaluation<dim, degree, n_components, number>::get_hessian(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_hessian(q_point);
+    }
+  return reduced->get_hessian(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline auto
+fieldEvaluation<dim, degree, n_components, number>::get_hessian_diagonal(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_hessian_diagonal(q_point);
+    }
+  return reduced->get_hessian_diagonal(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline auto
+fieldEvaluation<dim, degree, n_components, number>::get_laplacian(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_laplacian(q_point);
+    }
+  return reduced->get_laplacian(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline auto
+fieldEvaluation<dim, degree, n_components, number>::get_divergence(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_divergence(q_point);
+    }
+  return reduced->get_divergence(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline auto
+fieldEvaluation<dim, degree, n_components, number>::get_symmetric_gradient(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_symmetric_gradient(q_point);
+    }
+  return reduced->get_symmetric_gradient(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline auto
+fieldEvaluation<dim, degree, n_components, number>::get_curl(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->get_curl(q_point);
+    }
+  return reduced->get_curl(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::submit_value(
+  const value_type   &value,
+  const unsigned int &q_point)
+{
+  if (fast)
+    {
+      fast->submit_value(value, q_point);
+    }
+  else
+    {
+      reduced->submit_value(value, q_point);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline void
+fieldEvaluation<dim, degree, n_components, number>::submit_gradient(
+  const gradient_type &gradient,
+  const unsigned int  &q_point)
+{
+  if (fast)
+    {
+      fast->submit_gradient(gradient, q_point);
+    }
+  else
+    {
+      reduced->submit_gradient(gradient, q_point);
+    }
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline dealii::Point<dim, dealii::VectorizedArray<number>>
+fieldEvaluation<dim, degree, n_components, number>::quadrature_point(
+  const unsigned int &q_point) const
+{
+  if (fast)
+    {
+      return fast->quadrature_point(q_point);
+    }
+  return reduced->quadrature_point(q_point);
+}
+
+template <int dim, int degree, int n_components, typename number>
+inline bool
+fieldEvaluation<dim, degree, n_components, number>::is_reduced() const
+{
+  return reduced != nullptr;
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef grid_refiner_h
+#define grid_refiner_h
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/refinement_criterion.h>
+#include <prismspf/core/solution_handler.h>
+#include <prismspf/core/triangulation_handler.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief This class marks the cells of the triangulation for refinement and coarsening
+ * according to the refinement criteria of the user inputs.
+ */
+template <int dim, int degree>
+class gridRefiner
+{
+public:
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+  /**
+   * \brief Constructor.
+   */
+  gridRefiner(const userInputParameters<dim>  &_user_inputs,
+              const triangulationHandler<dim> &_triangulation_handler,
+              const matrixfreeHandler<dim>    &_matrix_free_handler,
+              const solutionHandler<dim>      &_solution_handler);
+
+  /**
+   * \brief Set the refinement and coarsening flags of the locally owned cells. A cell is
+   * flagged for refinement if any criterion is met at one of its nodes and for
+   * coarsening otherwise, within the minimum and maximum refinement levels. The ghost
+   * values of the solutions must be up to date.
+   */
+  void
+  mark_cells() const;
+
+  /**
+   * \brief Compute the weights of the cells of the current mesh for the partitioning. A
+   * bulk cell has a fixed weight, and every scalar field that varies over a cell adds
+   * the active field cost, relative to that weight. This must be called before the mesh
+   * is refined, because the weights of the refined mesh are taken from the current one.
+   */
+  void
+  compute_cell_weights();
+
+  /**
+   * \brief Fit the active field cost to the measured cost of each process on the current
+   * partitioning, and update the cell weights with it. The cost of a process is modeled
+   * as the number of its cells plus the active field cost times the number of active
+   * fields summed over its cells, in units of a bulk cell. The fit is a least squares
+   * fit over all processes, so it needs processes with a different share of active
+   * fields. Otherwise, the active field cost is kept. This must be called after
+   * compute_cell_weights on the mesh where the cost was measured.
+   */
+  void
+  calibrate_active_field_cost(const double &local_cost);
+
+  /**
+   * \brief Return the active field cost, which is either the user input or the result of
+   * the last calibration.
+   */
+  [[nodiscard]] double
+  get_active_field_cost() const;
+
+  /**
+   * \brief Return the weight of a cell of the refined mesh, given whether the cell
+   * persists, is refined, or is coarsened.
+   */
+  [[nodiscard]] unsigned int
+  get_cell_weight(const typename dealii::Triangulation<dim>::cell_iterator &cell,
+                  const typename triangulationHandler<dim>::CellStatus     &status) const;
+
+  /**
+   * \brief Return the load imbalance that the cell weights predict for the current
+   * partitioning.
+   */
+  [[nodiscard]] double
+  get_predicted_load_imbalance() const;
+
+  /**
+   * \brief Return the load imbalance of the given cost of each process, which is the
+   * ratio of the maximum to the average over all processes.
+   */
+  [[nodiscard]] double
+  compute_load_imbalance(const double &local_cost) const;
+
+private:
+  /**
+   * \brief Evaluate the given criterion at the nodes of the locally owned cells and set
+   * the indicator of the cells where it is met. The cells are processed in batches with
+   * FEEvaluation, so the criterion is checked for several cells per instruction.
+   */
+  void
+  evaluate_criterion(const RefinementCriterion &criterion,
+                     std::vector<bool>         &indicator) const;
+
+  /**
+   * \brief Set the cell weights from the number of active fields of each cell and the
+   * active field cost.
+   */
+  void
+  update_cell_weights();
+
+  /**
+   * \brief User-inputs.
+   */
+  const userInputParameters<dim> &user_inputs;
+
+  /**
+   * \brief Triangulation handler.
+   */
+  const triangulationHandler<dim> &triangulation_handler;
+
+  /**
+   * \brief Matrix-free object handler.
+   */
+  const matrixfreeHandler<dim> &matrix_free_handler;
+
+  /**
+   * \brief Solution handler.
+   */
+  const solutionHandler<dim> &solution_handler;
+
+  /**
+   * \brief Weight of a cell without any varying field. The partitioner takes integer
+   * weights, so this sets the resolution of the relative costs to 1/1000 of a bulk cell.
+   */
+  static constexpr unsigned int bulk_cell_weight = 1000;
+
+  /**
+   * \brief Extra cost of a cell for each field that varies over it, relative to a bulk
+   * cell.
+   */
+  double active_field_cost;
+
+  /**
+   * \brief Number of scalar fields that vary over each cell of the current mesh, by
+   * active cell index.
+   */
+  std::vector<unsigned int> n_active_fields;
+
+  /**
+   * \brief Weights of the cells of the current mesh, by active cell index.
+   */
+  std::vector<unsigned int> cell_weights;
+};
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
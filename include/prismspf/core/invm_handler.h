@@ -13,12 +13,14 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 
 PRISMS_PF_BEGIN_NAMESPACE
 
 /**
  * \brief This class handles the computation and access of the inverted mass matrix for
- * explicit solves.
+ * explicit solves. There is one inverted mass matrix for each combination of field type
+ * and degree reduction that the explicit fields use.
  */
 template <int dim, int degree, typename number = double>
 class invmHandler
@@ -26,6 +28,7 @@ class invmHandler
 public:
   using VectorType = dealii::LinearAlgebra::distributed::Vector<number>;
   using size_type  = dealii::VectorizedArray<number>;
+  using KeyType    = std::pair<fieldType, unsigned int>;
 
   /**
    * \brief Constructor.
@@ -40,14 +43,14 @@ public:
   initialize(std::shared_ptr<dealii::MatrixFree<dim, number, size_type>> _data);
 
   /**
-   * \brief Compute the mass matrix for scalar/vector fields.
+   * \brief Compute the mass matrix for scalar/vector fields of each degree.
    */
   void
   compute_invm();
 
   /**
-   * \brief Recompute the mass matrix for scalar/vector fields. This just points to
-   * compute_invm() and is used for style.
+   * \brief Recompute the mass matrix for scalar/vector fields of each degree. This just
+   * points to compute_invm() and is used for style.
    */
   void
   recompute_invm();
@@ -78,36 +81,23 @@ private:
   std::shared_ptr<dealii::MatrixFree<dim, number, size_type>> data;
 
   /**
-   * \brief Inverse of the mass matrix for scalar fields.
+   * \brief Compute the inverse of the mass matrix of the given field.
    */
-  VectorType invm_scalar;
-
-  /**
-   * \brief Inverse of the mass matrix for vector fields.
-   */
-  VectorType invm_vector;
-
-  /**
-   * \brief Whether a scalar invm is needed.
-   */
-  bool scalar_needed = false;
-
-  /**
-   * \brief Whether a vector invm is needed.
-   */
-  bool vector_needed = false;
+  template <unsigned int n_components>
+  void
+  compute_field_invm(VectorType &field_invm, const unsigned int &index) const;
 
   /**
-   * \brief Field index of the first occuring scalar field. This is the index for which we
-   * attached the FEEvaluation objects to evaluate and initialize the invm vector.
+   * \brief Field index of the first occuring explicit field for each field type and
+   * degree reduction. This is the index for which we attached the FEEvaluation objects
+   * to evaluate and initialize the invm vector.
    */
-  unsigned int scalar_index = numbers::invalid_index;
+  std::map<KeyType, unsigned int> invm_index;
 
   /**
-   * \brief Field index of the first occuring vector field. This is the index for which we
-   * attached the FEEvaluation objects to evaluate and initialize the invm vector.
+   * \brief Inverse of the mass matrix for each field type and degree reduction.
    */
-  unsigned int vector_index = numbers::invalid_index;
+  std::map<KeyType, VectorType> invm;
 };
 
 PRISMS_PF_END_NAMESPACE
@@ -6,6 +6,9 @@
 
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/vectorization.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/operators.h>
@@ -30,9 +33,10 @@ template <int dim, int degree, typename number>
 class matrixFreeOperator : public dealii::Subscriptor
 {
 public:
-  using VectorType = dealii::LinearAlgebra::distributed::Vector<number>;
-  using value_type = number;
-  using size_type  = dealii::VectorizedArray<number>;
+  using VectorType      = dealii::LinearAlgebra::distributed::Vector<number>;
+  using BlockVectorType = dealii::LinearAlgebra::distributed::BlockVector<number>;
+  using value_type      = number;
+  using size_type       = dealii::VectorizedArray<number>;
 
   /**
    * \brief Default constructor.
@@ -128,6 +132,16 @@ public:
   void
   vmult(VectorType &dst, const VectorType &src) const;
 
+  /**
+   * \brief Matrix-vector multiplication on a range of cells. This is the local operation
+   * of vmult(), which lets several operators share a single loop over the cells.
+   */
+  void
+  local_vmult(const dealii::MatrixFree<dim, number, size_type> &data,
+              VectorType                                       &dst,
+              const VectorType                                 &src,
+              const std::pair<unsigned int, unsigned int>      &cell_range) const;
+
   /**
    * \brief Transpose matrix-vector multiplication.
    */
@@ -167,6 +181,55 @@ public:
   void
   compute_diagonal(unsigned int field_index);
 
+  /**
+   * \brief Assemble the sparse matrix of this operator. This evaluates the operator once
+   * for every shape function of every cell, so it is only meant for small problems, like
+   * the coarsest level of multigrid.
+   */
+  template <typename MatrixType>
+  void
+  compute_system_matrix(
+    MatrixType                                                      &matrix,
+    const dealii::AffineConstraints<typename MatrixType::value_type> &constraints,
+    unsigned int                                                     field_index) const;
+
+  /**
+   * \brief Linearize the LHS about the current src solution subset and cache the
+   * coefficients at each quadrature point. Until the cache is cleared, vmult applies the
+   * cached coefficients to the change instead of evaluating the user LHS, so the
+   * dependencies of the LHS are not read or evaluated and the nonlinear coefficients are
+   * not recomputed.
+   */
+  void
+  compute_linearization();
+
+  /**
+   * \brief Clear the cached linearization of the LHS.
+   */
+  void
+  clear_linearization();
+
+  /**
+   * \brief Matrix-vector multiplication for concurrent solves. Each block holds the
+   * change of one of the selected fields.
+   */
+  void
+  vmult(BlockVectorType &dst, const BlockVectorType &src) const;
+
+  /**
+   * \brief Compute the residual of this operator for concurrent solves. Each block holds
+   * the residual of one of the selected fields.
+   */
+  void
+  compute_residual(BlockVectorType &dst) const;
+
+  /**
+   * \brief Compute the inverse of the diagonal of the diagonal blocks of this operator
+   * for concurrent solves.
+   */
+  void
+  compute_block_diagonal(BlockVectorType &inverse_diagonal) const;
+
 protected:
   /**
    * \brief User-implemented class for the RHS of explicit equations.
@@ -257,6 +320,17 @@ private:
     const VectorType                                 &src,
     const std::pair<unsigned int, unsigned int>      &cell_range) const;
 
+  /**
+   * \brief Local computation of the newton update of the operator with the cached
+   * linearization.
+   */
+  void
+  compute_local_linearized_newton_update(
+    const dealii::MatrixFree<dim, number, size_type> &data,
+    VectorType                                       &dst,
+    const VectorType                                 &src,
+    const std::pair<unsigned int, unsigned int>      &cell_range) const;
+
   /**
    * \brief Local computation of the diagonal of the operator.
    */
@@ -266,6 +340,37 @@ private:
                          const unsigned int                               &dummy,
                          const std::pair<unsigned int, unsigned int> &cell_range) const;
 
+  /**
+   * \brief Local computation of the residual of the operator for concurrent solves.
+   */
+  void
+  compute_local_block_residual(
+    const dealii::MatrixFree<dim, number, size_type> &data,
+    BlockVectorType                                  &dst,
+    const std::vector<VectorType *>                  &src,
+    const std::pair<unsigned int, unsigned int>      &cell_range) const;
+
+  /**
+   * \brief Local computation of the newton update of the operator for concurrent solves.
+   */
+  void
+  compute_local_block_newton_update(
+    const dealii::MatrixFree<dim, number, size_type> &data,
+    BlockVectorType                                  &dst,
+    const BlockVectorType                            &src,
+    const std::pair<unsigned int, unsigned int>      &cell_range) const;
+
+  /**
+   * \brief Local computation of the block diagonal of the operator for concurrent
+   * solves.
+   */
+  void
+  local_compute_block_diagonal(
+    const dealii::MatrixFree<dim, number, size_type> &data,
+    BlockVectorType                                  &dst,
+    const unsigned int                               &dummy,
+    const std::pair<unsigned int, unsigned int>      &cell_range) const;
+
   /**
    * \brief The attribute list of the relevant variables.
    */
@@ -306,6 +411,12 @@ private:
    * \brief The inverse diagonal matrix.
    */
   std::shared_ptr<dealii::DiagonalMatrix<VectorType>> inverse_diagonal_entries;
+
+  /**
+   * \brief Cached linearization of the LHS. This is empty unless compute_linearization()
+   * has been called.
+   */
+  dealii::AlignedVector<size_type> linearization;
 };
 
 template <int dim, int degree, typename number>
@@ -395,6 +506,7 @@ matrixFreeOperator<dim, degree, number>::clear()
   data.reset();
   inverse_diagonal_entries.reset();
   global_to_local_solution.clear();
+  linearization.clear();
 }
 
 template <int dim, int degree, typename number>
@@ -562,11 +674,24 @@ matrixFreeOperator<dim, degree, number>::vmult(VectorType       &dst,
   Assert(src.size() != 0,
          dealii::ExcMessage("The src vector should not have size equal to 0"));
 
-  this->data->cell_loop(&matrixFreeOperator::compute_local_newton_update,
-                        this,
-                        dst,
-                        src,
-                        true);
+  this->data->cell_loop(&matrixFreeOperator::local_vmult, this, dst, src, true);
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::local_vmult(
+  const dealii::MatrixFree<dim, number>       &data,
+  VectorType                                  &dst,
+  const VectorType                            &src,
+  const std::pair<unsigned int, unsigned int> &cell_range) const
+{
+  if (!linearization.empty())
+    {
+      compute_local_linearized_newton_update(data, dst, src, cell_range);
+      return;
+    }
+
+  compute_local_newton_update(data, dst, src, cell_range);
 }
 
 template <int dim, int degree, typename number>
@@ -709,6 +834,24 @@ matrixFreeOperator<dim, degree, number>::compute_local_newton_update(
     cell_range);
 }
 
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::compute_local_linearized_newton_update(
+  const dealii::MatrixFree<dim, number>       &data,
+  VectorType                                  &dst,
+  const VectorType                            &src,
+  const std::pair<unsigned int, unsigned int> &cell_range) const
+{
+  // Constructor for FEEvaluation objects
+  variableContainer<dim, degree, number> variable_list(data,
+                                                       attributes_list,
+                                                       global_to_local_solution,
+                                                       solveType::NONEXPLICIT_LHS);
+
+  // Apply the cached coefficients to the change term
+  variable_list.apply_local_linearization(linearization, dst, src, cell_range);
+}
+
 template <int dim, int degree, typename number>
 void
 matrixFreeOperator<dim, degree, number>::compute_diagonal(unsigned int field_index)
@@ -759,6 +902,265 @@ matrixFreeOperator<dim, degree, number>::local_compute_diagonal(
     cell_range);
 }
 
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::vmult(BlockVectorType       &dst,
+                                               const BlockVectorType &src) const
+{
+  Assert(!global_to_local_solution.empty(),
+         dealii::ExcMessage(
+           "The global to local solution mapping must not be empty. Make sure to call "
+           "add_global_to_local_mapping() prior to any computations."));
+  Assert(dst.size() != 0,
+         dealii::ExcMessage("The dst vector should not have size equal to 0"));
+  Assert(src.size() != 0,
+         dealii::ExcMessage("The src vector should not have size equal to 0"));
+
+  this->data->cell_loop(&matrixFreeOperator::compute_local_block_newton_update,
+                        this,
+                        dst,
+                        src,
+                        true);
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::compute_residual(BlockVectorType &dst) const
+{
+  Assert(!global_to_local_solution.empty(),
+         dealii::ExcMessage(
+           "The global to local solution mapping must not be empty. Make sure to call "
+           "add_global_to_local_mapping() prior to any computations."));
+  Assert(!src_solution_subset.empty(),
+         dealii::ExcMessage("The src_solution_subset vector must not be empty"));
+  Assert(dst.size() != 0,
+         dealii::ExcMessage("The dst vector should not have size equal to 0"));
+
+  this->data->cell_loop(&matrixFreeOperator::compute_local_block_residual,
+                        this,
+                        dst,
+                        src_solution_subset,
+                        true);
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::compute_block_diagonal(
+  BlockVectorType &inverse_diagonal) const
+{
+  Assert(inverse_diagonal.n_blocks() == selected_fields.size(),
+         dealii::ExcMessage(
+           "The number of blocks must match the number of selected fields"));
+
+  unsigned int dummy = 0;
+  data->cell_loop(&matrixFreeOperator::local_compute_block_diagonal,
+                  this,
+                  inverse_diagonal,
+                  dummy,
+                  true);
+
+  for (unsigned int block = 0; block < inverse_diagonal.n_blocks(); ++block)
+    {
+      VectorType &diagonal = inverse_diagonal.block(block);
+
+      for (const auto constrained_dof :
+           data->get_constrained_dofs(selected_fields[block]))
+        {
+          diagonal.local_element(constrained_dof) = 1.0;
+        }
+
+      // Unlike the single field case, the coupled operator need not be positive
+      // definite and a block may have zeros on its diagonal (e.g., a saddle point
+      // system). Those entries are left unscaled instead of being inverted.
+      for (unsigned int i = 0; i < diagonal.locally_owned_size(); ++i)
+        {
+          diagonal.local_element(i) = diagonal.local_element(i) != 0.0
+                                        ? 1.0 / diagonal.local_element(i)
+                                        : 1.0;
+        }
+    }
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::compute_local_block_residual(
+  const dealii::MatrixFree<dim, number>       &data,
+  BlockVectorType                             &dst,
+  const std::vector<VectorType *>             &src,
+  const std::pair<unsigned int, unsigned int> &cell_range) const
+{
+  // Constructor for FEEvaluation objects
+  variableContainer<dim, degree, number> variable_list(data,
+                                                       attributes_list,
+                                                       global_to_local_solution,
+                                                       solveType::NONEXPLICIT_RHS);
+
+  // Initialize, evaluate, and submit based on user function.
+  variable_list.eval_local_operator(
+    [this](variableContainer<dim, degree, number> &var_list,
+           const dealii::Point<dim, size_type>    &q_point_loc)
+    {
+      this->compute_nonexplicit_RHS(var_list, q_point_loc);
+    },
+    dst,
+    src,
+    cell_range);
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::compute_local_block_newton_update(
+  const dealii::MatrixFree<dim, number>       &data,
+  BlockVectorType                             &dst,
+  const BlockVectorType                       &src,
+  const std::pair<unsigned int, unsigned int> &cell_range) const
+{
+  // Constructor for FEEvaluation objects
+  variableContainer<dim, degree, number> variable_list(data,
+                                                       attributes_list,
+                                                       global_to_local_solution,
+                                                       solveType::NONEXPLICIT_LHS);
+
+  // Initialize, evaluate, and submit based on user function. The change terms are read
+  // from the src blocks and everything else from the src solution subset.
+  variable_list.eval_local_operator(
+    [this](variableContainer<dim, degree, number> &var_list,
+           const dealii::Point<dim, size_type>    &q_point_loc)
+    {
+      this->compute_nonexplicit_LHS(var_list, q_point_loc);
+    },
+    dst,
+    src,
+    src_solution_subset,
+    cell_range);
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::local_compute_block_diagonal(
+  const dealii::MatrixFree<dim, number>       &data,
+  BlockVectorType                             &dst,
+  [[maybe_unused]] const unsigned int         &dummy,
+  const std::pair<unsigned int, unsigned int> &cell_range) const
+{
+  // Constructor for FEEvaluation objects
+  variableContainer<dim, degree, number> variable_list(data,
+                                                       attributes_list,
+                                                       global_to_local_solution,
+                                                       solveType::NONEXPLICIT_LHS);
+
+  // Initialize, evaluate, and submit diagonal based on user function.
+  variable_list.eval_local_diagonal(
+    [this](variableContainer<dim, degree, number> &var_list,
+           const dealii::Point<dim, size_type>    &q_point_loc)
+    {
+      this->compute_nonexplicit_LHS(var_list, q_point_loc);
+    },
+    dst,
+    src_solution_subset,
+    cell_range);
+}
+
+template <int dim, int degree, typename number>
+template <typename MatrixType>
+void
+matrixFreeOperator<dim, degree, number>::compute_system_matrix(
+  MatrixType                                                      &matrix,
+  const dealii::AffineConstraints<typename MatrixType::value_type> &constraints,
+  unsigned int                                                     field_index) const
+{
+  const unsigned int               n_dofs_per_cell = data->get_dofs_per_cell(field_index);
+  const std::vector<unsigned int> &lexicographic_numbering =
+    data->get_shape_info(field_index).lexicographic_numbering;
+
+  std::vector<dealii::types::global_dof_index>        dof_indices(n_dofs_per_cell);
+  dealii::FullMatrix<typename MatrixType::value_type> cell_matrix(n_dofs_per_cell,
+                                                                  n_dofs_per_cell);
+
+  // The src subset is read outside of a cell_loop, so we have to update the ghosts
+  for (const auto *vector : src_solution_subset)
+    {
+      vector->update_ghost_values();
+    }
+
+  // Constructor for FEEvaluation objects
+  variableContainer<dim, degree, number> variable_list(*data,
+                                                       attributes_list,
+                                                       global_to_local_solution,
+                                                       solveType::NONEXPLICIT_LHS);
+
+  // Compute the element matrices based on user function and distribute each cell of the
+  // batch to the global matrix.
+  variable_list.eval_local_matrix(
+    [this](variableContainer<dim, degree, number> &var_list,
+           const dealii::Point<dim, size_type>    &q_point_loc)
+    {
+      this->compute_nonexplicit_LHS(var_list, q_point_loc);
+    },
+    [&](const unsigned int &cell, const dealii::AlignedVector<size_type> &local_matrix)
+    {
+      for (unsigned int lane = 0; lane < data->n_active_entries_per_cell_batch(cell);
+           ++lane)
+        {
+          data->get_cell_iterator(cell, lane, field_index)->get_dof_indices(dof_indices);
+          for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+            {
+              for (unsigned int j = 0; j < n_dofs_per_cell; ++j)
+                {
+                  cell_matrix(lexicographic_numbering[j], lexicographic_numbering[i]) =
+                    local_matrix[i * n_dofs_per_cell + j][lane];
+                }
+            }
+          constraints.distribute_local_to_global(cell_matrix, dof_indices, matrix);
+        }
+    },
+    src_solution_subset,
+    std::make_pair(0U, data->n_cell_batches()));
+
+  matrix.compress(dealii::VectorOperation::add);
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::compute_linearization()
+{
+  Assert(data.get() != nullptr, dealii::ExcNotInitialized());
+
+  // The src subset is read outside of a cell_loop, so we have to update the ghosts
+  for (const auto *vector : src_solution_subset)
+    {
+      vector->update_ghost_values();
+    }
+
+  // Constructor for FEEvaluation objects
+  variableContainer<dim, degree, number> variable_list(*data,
+                                                       attributes_list,
+                                                       global_to_local_solution,
+                                                       solveType::NONEXPLICIT_LHS);
+
+  linearization.resize_fast(data->n_cell_batches() *
+                            variable_list.get_n_linearization_coefficients());
+
+  // Evaluate the user function for each component of the change at every quadrature
+  // point
+  variable_list.eval_local_linearization(
+    [this](variableContainer<dim, degree, number> &var_list,
+           const dealii::Point<dim, size_type>    &q_point_loc)
+    {
+      this->compute_nonexplicit_LHS(var_list, q_point_loc);
+    },
+    linearization,
+    src_solution_subset,
+    std::make_pair(0U, data->n_cell_batches()));
+}
+
+template <int dim, int degree, typename number>
+void
+matrixFreeOperator<dim, degree, number>::clear_linearization()
+{
+  linearization.clear();
+}
+
 PRISMS_PF_END_NAMESPACE
 
-#endif
\ No newline at end of file
+#endif
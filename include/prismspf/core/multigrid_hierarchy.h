@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef multigrid_hierarchy_h
+#define multigrid_hierarchy_h
+
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/dof_handler.h>
+#include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/triangulation_handler.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Geometric and polynomial multigrid hierarchy of a field. This holds everything
+ * that only depends on the finite element and boundary conditions of the field: the
+ * coarse triangulations, the level DoFHandlers, constraints, matrix-free objects, and the
+ * transfer between levels. The level operators, which depend on the PDE of the field, are
+ * owned by the solvers.
+ */
+template <int dim>
+class mgHierarchy
+{
+public:
+  using MGVectorType = dealii::LinearAlgebra::distributed::Vector<float>;
+
+  /**
+   * \brief Constructor. The finite element and boundary conditions are taken from the
+   * field with the given index.
+   */
+  mgHierarchy(const userInputParameters<dim>  &_user_inputs,
+              const triangulationHandler<dim> &_triangulation_handler,
+              const dofHandler<dim>           &_dof_handler,
+              const unsigned int              &_field_index);
+
+  /**
+   * \brief Get the minimum multigrid level.
+   */
+  [[nodiscard]] unsigned int
+  get_min_level() const;
+
+  /**
+   * \brief Get the maximum multigrid level.
+   */
+  [[nodiscard]] unsigned int
+  get_max_level() const;
+
+  /**
+   * \brief Get the polynomial degree of the given level.
+   */
+  [[nodiscard]] unsigned int
+  get_level_degree(const unsigned int &level) const;
+
+  /**
+   * \brief Get the DoFHandler of the given level.
+   */
+  [[nodiscard]] const dealii::DoFHandler<dim> &
+  get_dof_handler(const unsigned int &level) const;
+
+  /**
+   * \brief Get the constraints of the given level.
+   */
+  [[nodiscard]] const dealii::AffineConstraints<float> &
+  get_constraint(const unsigned int &level) const;
+
+  /**
+   * \brief Get the matrix-free object of the given level.
+   */
+  [[nodiscard]] std::shared_ptr<dealii::MatrixFree<dim, float>>
+  get_matrix_free(const unsigned int &level) const;
+
+  /**
+   * \brief Get the transfer operator between the levels.
+   */
+  [[nodiscard]] const dealii::MGTransferGlobalCoarsening<dim, MGVectorType> &
+  get_transfer() const;
+
+private:
+  /**
+   * \brief Create the levels, where h is the refinement and p is the polynomial degree.
+   * The finest mesh is first coarsened in p, down to the coarsest degree, and then in h.
+   */
+  void
+  create_levels(const unsigned int &fe_degree);
+
+  /**
+   * \brief Make the homogeneous constraints of the given level.
+   */
+  void
+  make_level_constraints(const unsigned int &level);
+
+  /**
+   * \brief User-inputs.
+   */
+  const userInputParameters<dim> &user_inputs;
+
+  /**
+   * \brief Field index whose finite element and boundary conditions are used.
+   */
+  unsigned int field_index;
+
+  /**
+   * \brief Mappings to and from reference cell.
+   */
+  const dealii::MappingQ1<dim> mapping;
+
+  /**
+   * \brief Refinement level and polynomial degree of each multigrid level, ordered from
+   * coarse to fine.
+   */
+  std::vector<std::pair<unsigned int, unsigned int>> levels;
+
+  /**
+   * \brief Minimum multigrid level
+   */
+  unsigned int min_level = 0;
+
+  /**
+   * \brief Maximum multigrid level
+   */
+  unsigned int max_level = 0;
+
+  /**
+   * \brief Collection of triangulations for each refinement level.
+   */
+  std::vector<std::shared_ptr<const dealii::Triangulation<dim>>> coarse_triangulations;
+
+  /**
+   * \brief Collection of DoFhandlers for each multigrid level.
+   */
+  dealii::MGLevelObject<dealii::DoFHandler<dim>> mg_dof_handlers;
+
+  /**
+   * \brief Collection of constraints for each multigrid level.
+   */
+  dealii::MGLevelObject<dealii::AffineConstraints<float>> level_constraints;
+
+  /**
+   * \brief Matrix-free object handler for each multigrid level.
+   */
+  dealii::MGLevelObject<matrixfreeHandler<dim, float>> mg_matrix_free_handler;
+
+  /**
+   * \brief Collection of transfer operators for each multigrid level.
+   */
+  dealii::MGLevelObject<dealii::MGTwoLevelTransfer<dim, MGVectorType>>
+    mg_transfer_operators;
+
+  /**
+   * \brief Transfer operator for global coarsening.
+   */
+  std::unique_ptr<dealii::MGTransferGlobalCoarsening<dim, MGVectorType>> mg_transfer;
+};
+
+/**
+ * \brief This class handles the multigrid hierarchies of the fields that are solved with
+ * a GMG preconditioner. Fields with the same finite element, polynomial coarsening, and
+ * boundary conditions share a hierarchy, so it is only built and stored once.
+ */
+template <int dim>
+class mgHierarchyHandler
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  mgHierarchyHandler(const userInputParameters<dim>  &_user_inputs,
+                     const triangulationHandler<dim> &_triangulation_handler,
+                     const dofHandler<dim>           &_dof_handler);
+
+  /**
+   * \brief Get the hierarchy of the given field, which is built if no other field with
+   * the same signature has requested it yet. The solvers keep the shared_ptr for as long
+   * as their level operators use the hierarchy.
+   */
+  [[nodiscard]] std::shared_ptr<const mgHierarchy<dim>>
+  get_hierarchy(const unsigned int &field_index);
+
+  /**
+   * \brief Release the hierarchies, so that they are rebuilt on the next request. This
+   * must be called when the mesh changes. Hierarchies that are still held by a solver are
+   * destroyed once that solver releases them.
+   */
+  void
+  clear();
+
+private:
+  /**
+   * \brief Signature of the boundary conditions of a field. Only the type of each
+   * condition matters, because the level constraints are homogeneous.
+   */
+  using BoundarySignature = std::map<std::pair<unsigned int, dealii::types::boundary_id>,
+                                     boundaryCondition::type>;
+
+  /**
+   * \brief Key of a hierarchy, which is the degree of the finite element, the field type,
+   * the polynomial coarsening, and the boundary signature.
+   */
+  using KeyType =
+    std::tuple<unsigned int, fieldType, polynomialCoarseningType, BoundarySignature>;
+
+  /**
+   * \brief Compute the key of the given field.
+   */
+  [[nodiscard]] KeyType
+  compute_key(const unsigned int &field_index) const;
+
+  /**
+   * \brief User-inputs.
+   */
+  const userInputParameters<dim> &user_inputs;
+
+  /**
+   * \brief Triangulation handler.
+   */
+  const triangulationHandler<dim> &triangulation_handler;
+
+  /**
+   * \brief DoF handler.
+   */
+  const dofHandler<dim> &dof_handler;
+
+  /**
+   * \brief Hierarchies by their key.
+   */
+  std::map<KeyType, std::shared_ptr<const mgHierarchy<dim>>> hierarchies;
+};
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
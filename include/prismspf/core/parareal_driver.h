@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef parareal_driver_h
+#define parareal_driver_h
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <prismspf/config.h>
+#include <prismspf/user_inputs/parareal_parameters.h>
+
+#include <functional>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Class that handles parareal parallel-in-time solves.
+ *
+ * The MPI processes are split evenly into groups, one per time slice. Each group holds a
+ * complete copy of the spatial problem on its slice communicator. Because every group
+ * has the same number of processes and the same mesh, corresponding processes own the
+ * same degrees of freedom, so the slice boundary states can be exchanged by simply
+ * sending the locally owned entries along a second "time" communicator.
+ *
+ * The coarse sweep is repeated redundantly on every group, which avoids a sequential
+ * chain of messages at the cost of some extra coarse propagations.
+ */
+class pararealDriver
+{
+public:
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+  /**
+   * \brief Function that advances the state from the start of the given time slice to
+   * the start of the next.
+   */
+  using Propagator = std::function<void(const unsigned int &time_slice)>;
+
+  /**
+   * \brief Constructor. Splits MPI_COMM_WORLD into time slices if parareal is enabled.
+   */
+  explicit pararealDriver(const pararealParameters &_parameters);
+
+  /**
+   * \brief Destructor.
+   */
+  ~pararealDriver();
+
+  pararealDriver(const pararealDriver &)            = delete;
+  pararealDriver &operator=(const pararealDriver &) = delete;
+
+  /**
+   * \brief Return the communicator for the spatial problem of this time slice. This is
+   * MPI_COMM_WORLD if parareal is disabled.
+   */
+  [[nodiscard]] const MPI_Comm &
+  get_slice_communicator() const;
+
+  /**
+   * \brief Return the time slice that belongs to this process.
+   */
+  [[nodiscard]] unsigned int
+  get_time_slice() const;
+
+  /**
+   * \brief Run the parareal iterations. The state vectors must fully describe the
+   * solution at a time slice boundary and hold the initial condition on entry. On exit,
+   * they hold the converged state at the start of this process' time slice. Returns the
+   * number of iterations.
+   */
+  unsigned int
+  solve(const std::vector<VectorType *> &_state,
+        const Propagator                &coarse_propagator,
+        const Propagator                &fine_propagator);
+
+  /**
+   * \brief Copy the converged state at the end of the last time slice into the state
+   * vectors. This is available on every time slice after solve().
+   */
+  void
+  load_final_state() const;
+
+private:
+  /**
+   * \brief Copy the locally owned entries of the state vectors into a buffer.
+   */
+  void
+  pack(std::vector<double> &buffer) const;
+
+  /**
+   * \brief Copy a buffer into the locally owned entries of the state vectors.
+   */
+  void
+  unpack(const std::vector<double> &buffer) const;
+
+  /**
+   * \brief Parareal parameters.
+   */
+  const pararealParameters &parameters;
+
+  /**
+   * \brief Communicator of the processes that share a time slice.
+   */
+  MPI_Comm slice_communicator = MPI_COMM_WORLD;
+
+  /**
+   * \brief Communicator of the processes with the same rank in each time slice.
+   */
+  MPI_Comm time_communicator = MPI_COMM_SELF;
+
+  /**
+   * \brief Time slice that belongs to this process.
+   */
+  unsigned int time_slice = 0;
+
+  /**
+   * \brief State vectors.
+   */
+  std::vector<VectorType *> state;
+
+  /**
+   * \brief Locally owned entries of the converged state at the end of the last time
+   * slice.
+   */
+  std::vector<double> final_state;
+};
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -5,17 +5,25 @@
 #define pde_problem_h
 
 #include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/distributed/solution_transfer.h>
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_system.h>
 #include <deal.II/fe/mapping_q1.h>
+#include <deal.II/numerics/vector_tools.h>
 
 #include <prismspf/config.h>
 #include <prismspf/core/conditional_ostreams.h>
 #include <prismspf/core/constraint_handler.h>
 #include <prismspf/core/dof_handler.h>
 #include <prismspf/core/element_volume.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/core/grid_refiner.h>
+#include <prismspf/core/initial_conditions.h>
 #include <prismspf/core/invm_handler.h>
 #include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/multigrid_hierarchy.h>
+#include <prismspf/core/parareal_driver.h>
 #include <prismspf/core/solution_handler.h>
 #include <prismspf/core/solution_output.h>
 #include <prismspf/core/timer.h>
@@ -25,11 +33,18 @@
 #include <prismspf/solvers/explicit_postprocess_solver.h>
 #include <prismspf/solvers/explicit_solver.h>
 #include <prismspf/solvers/nonexplicit_auxiliary_solver.h>
+#include <prismspf/solvers/nonexplicit_co_nonlinear_solver.h>
 #include <prismspf/solvers/nonexplicit_linear_solver.h>
 #include <prismspf/solvers/nonexplicit_self_nonlinear_solver.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <filesystem>
+#include <fstream>
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #ifdef PRISMS_PF_WITH_CALIPER
 #  include <caliper/cali.h>
@@ -45,6 +60,8 @@ template <int dim, int degree>
 class PDEProblem
 {
 public:
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
   /**
    * \brief Constructor.
    */
@@ -69,12 +86,64 @@ private:
   void
   solve();
 
+  /**
+   * \brief Parareal variant of the time-stepping loop. The coarse propagator takes
+   * larger timesteps and the fine propagators solve the time slices concurrently.
+   */
+  void
+  solve_parareal();
+
+  /**
+   * \brief Advance the solution over the given parareal time slice with a timestep
+   * that is the given multiple of the user timestep.
+   */
+  void
+  propagate_time_slice(const unsigned int &time_slice,
+                       const unsigned int &timestep_ratio,
+                       const bool         &with_output);
+
   /**
    * \brief Solve a single increment of the given PDEs.
    */
   void
   solve_increment();
 
+  /**
+   * \brief Solve the postprocessed fields, write the solution to file, and print the
+   * l2-norms of each solution.
+   */
+  void
+  output_results();
+
+  /**
+   * \brief Print the l2-norms of each solution.
+   */
+  void
+  print_solution_norms() const;
+
+  /**
+   * \brief Return whether all explicit fields have a relative change below the
+   * steady-state tolerance. This should only be called after an increment where the
+   * relative change was requested from the explicit solver.
+   */
+  [[nodiscard]] bool
+  is_steady_state() const;
+
+  /**
+   * \brief Save the mesh, the solutions, and the time to the restart files. The files of
+   * the previous checkpoint are kept with an ".old" suffix.
+   */
+  void
+  write_checkpoint();
+
+  /**
+   * \brief Return the solution vectors of each field that make up the state of the
+   * simulation, which is every vector apart from the newton updates. They are sorted so
+   * that the ordering is identical across processes.
+   */
+  [[nodiscard]] std::map<unsigned int, std::vector<VectorType *>>
+  get_field_state() const;
+
   /**
    * \brief Initialize the system.
    */
@@ -82,16 +151,30 @@ private:
   init_system();
 
   /**
-   * \brief Reinitialize the system.
+   * \brief Adapt the mesh to the refinement criteria and reinitialize the system on it.
+   * The solutions are transferred to the new mesh.
    */
   void
   reinit_system();
 
+  /**
+   * \brief Interpolate the initial condition of the fields onto the current mesh. This
+   * overwrites the transferred solutions after the initial remeshing.
+   */
+  void
+  apply_initial_condition();
+
   /**
    * \brief User-inputs.
    */
   const userInputParameters<dim> &user_inputs;
 
+  /**
+   * \brief Parareal driver. This also owns the MPI communicator for the spatial problem
+   * so it must be constructed before the triangulation.
+   */
+  pararealDriver parareal_driver;
+
   /**
    * \brief Triangulation handler.
    */
@@ -108,9 +191,9 @@ private:
   matrixfreeHandler<dim> matrix_free_handler;
 
   /**
-   * \brief Matrix-free object handler for multigrid data.
+   * \brief Handler of the multigrid hierarchies, which are shared between fields.
    */
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> multigrid_matrix_free_handler;
+  mgHierarchyHandler<dim> multigrid_hierarchy_handler;
 
   /**
    * \brief invm handler.
@@ -128,11 +211,16 @@ private:
   dofHandler<dim> dof_handler;
 
   /**
-   * \brief Collection of finite element systems. This is just a collection of two
-   * FESystem's: one for scalar fields and one for vector fields. For now they both use
-   * FE_Q finite elements.
+   * \brief Grid refiner.
+   */
+  gridRefiner<dim, degree> grid_refiner;
+
+  /**
+   * \brief Collection of finite element systems. There is one FESystem for scalar fields
+   * and one for vector fields for each degree that is used. For now they all use FE_Q
+   * finite elements.
    */
-  std::map<fieldType, dealii::FESystem<dim>> fe_system;
+  typename dofHandler<dim>::FESystemMap fe_system;
 
   /**
    * \brief Mappings to and from reference cell.
@@ -173,18 +261,40 @@ private:
    * \brief Nonexplicit self nonlinear field solver class.
    */
   nonexplicitSelfNonlinearSolver<dim, degree> nonexplicit_self_nonlinear_solver;
+
+  /**
+   * \brief Nonexplicit co-nonlinear field solver class.
+   */
+  nonexplicitCoNonlinearSolver<dim, degree> nonexplicit_co_nonlinear_solver;
+
+  /**
+   * \brief CPU time of the last increment on this process. This is the measured cost
+   * of the local partition, without the time spent idle in communication.
+   */
+  double increment_cpu_time = 0.0;
+
+  /**
+   * \brief Whether the measured load imbalance of a new partitioning should be reported
+   * after the next increment.
+   */
+  bool report_load_imbalance = false;
 };
 
 template <int dim, int degree>
 PDEProblem<dim, degree>::PDEProblem(const userInputParameters<dim> &_user_inputs)
   : user_inputs(_user_inputs)
-  , triangulation_handler(_user_inputs)
+  , parareal_driver(_user_inputs.parareal_parameters)
+  , triangulation_handler(_user_inputs, parareal_driver.get_slice_communicator())
   , constraint_handler(_user_inputs)
   , matrix_free_handler(_user_inputs)
-  , multigrid_matrix_free_handler(0, 0, _user_inputs)
+  , multigrid_hierarchy_handler(_user_inputs, triangulation_handler, dof_handler)
   , invm_handler(_user_inputs.var_attributes)
   , solution_handler(_user_inputs.var_attributes)
   , dof_handler(_user_inputs)
+  , grid_refiner(_user_inputs,
+                 triangulation_handler,
+                 matrix_free_handler,
+                 solution_handler)
   , explicit_constant_solver(user_inputs,
                              matrix_free_handler,
                              invm_handler,
@@ -213,7 +323,7 @@ PDEProblem<dim, degree>::PDEProblem(const userInputParameters<dim> &_user_inputs
                                  constraint_handler,
                                  dof_handler,
                                  mapping,
-                                 multigrid_matrix_free_handler,
+                                 multigrid_hierarchy_handler,
                                  solution_handler)
   , nonexplicit_linear_solver(user_inputs,
                               matrix_free_handler,
@@ -222,7 +332,7 @@ PDEProblem<dim, degree>::PDEProblem(const userInputParameters<dim> &_user_inputs
                               constraint_handler,
                               dof_handler,
                               mapping,
-                              multigrid_matrix_free_handler,
+                              multigrid_hierarchy_handler,
                               solution_handler)
   , nonexplicit_self_nonlinear_solver(user_inputs,
                                       matrix_free_handler,
@@ -231,8 +341,17 @@ PDEProblem<dim, degree>::PDEProblem(const userInputParameters<dim> &_user_inputs
                                       constraint_handler,
                                       dof_handler,
                                       mapping,
-                                      multigrid_matrix_free_handler,
+                                      multigrid_hierarchy_handler,
                                       solution_handler)
+  , nonexplicit_co_nonlinear_solver(user_inputs,
+                                    matrix_free_handler,
+                                    triangulation_handler,
+                                    invm_handler,
+                                    constraint_handler,
+                                    dof_handler,
+                                    mapping,
+                                    multigrid_hierarchy_handler,
+                                    solution_handler)
 {}
 
 template <int dim, int degree>
@@ -254,31 +373,38 @@ PDEProblem<dim, degree>::init_system()
     << "\n"
     << std::flush;
 
+  if (user_inputs.parareal_parameters.is_enabled())
+    {
+      conditionalOStreams::pout_base()
+        << "number of parareal time slices: "
+        << user_inputs.parareal_parameters.n_time_slices << "\n"
+        << std::flush;
+    }
+
   // Create the SCALAR/VECTOR FESystem's, if applicable
   conditionalOStreams::pout_base() << "creating FESystem...\n" << std::flush;
   CALI_MARK_BEGIN("FESystem init");
   for (const auto &[index, variable] : user_inputs.var_attributes)
     {
-      if (variable.field_type == fieldType::SCALAR &&
-          fe_system.find(fieldType::SCALAR) == fe_system.end())
-        {
-          fe_system.emplace(fieldType::SCALAR,
-                            dealii::FESystem<dim>(dealii::FE_Q<dim>(
-                                                    dealii::QGaussLobatto<1>(degree + 1)),
-                                                  1));
-          conditionalOStreams::pout_summary() << "  made FESystem for scalar fields\n"
-                                              << std::flush;
-        }
-      else if (variable.field_type == fieldType::VECTOR &&
-               fe_system.find(fieldType::VECTOR) == fe_system.end())
+      AssertThrow(variable.degree_reduction < degree,
+                  dealii::ExcMessage("The degree reduction of " + variable.name +
+                                     " must be less than the degree of the problem."));
+
+      // Fields with a reduced degree are still evaluated at the quadrature points of the
+      // problem degree, so they share the matrix-free object with the other fields
+      const auto key = std::make_pair(variable.field_type, variable.degree_reduction);
+      if (fe_system.find(key) != fe_system.end())
         {
-          fe_system.emplace(fieldType::VECTOR,
-                            dealii::FESystem<dim>(dealii::FE_Q<dim>(
-                                                    dealii::QGaussLobatto<1>(degree + 1)),
-                                                  dim));
-          conditionalOStreams::pout_summary() << "  made FESystem for vector fields\n"
-                                              << std::flush;
+          continue;
         }
+      const unsigned int field_degree = degree - variable.degree_reduction;
+      const bool         is_scalar    = variable.field_type == fieldType::SCALAR;
+      const dealii::FE_Q<dim> fe_q(dealii::QGaussLobatto<1>(field_degree + 1));
+      fe_system.emplace(key, dealii::FESystem<dim>(fe_q, is_scalar ? 1 : dim));
+      conditionalOStreams::pout_summary()
+        << "  made FESystem for " << (is_scalar ? "scalar" : "vector")
+        << " fields of degree " << field_degree << "\n"
+        << std::flush;
     }
   CALI_MARK_END("FESystem init");
 
@@ -286,6 +412,16 @@ PDEProblem<dim, degree>::init_system()
   conditionalOStreams::pout_base() << "creating triangulation...\n" << std::flush;
   CALI_MARK_BEGIN("Mesh init");
   triangulation_handler.generate_mesh();
+  if (user_inputs.spatial_discretization.has_adaptivity &&
+      user_inputs.spatial_discretization.active_field_cost > 0.0)
+    {
+      triangulation_handler.set_cell_weight(
+        [this](const typename dealii::Triangulation<dim>::cell_iterator &cell,
+               const typename triangulationHandler<dim>::CellStatus     &status)
+        {
+          return grid_refiner.get_cell_weight(cell, status);
+        });
+    }
   CALI_MARK_END("Mesh init");
 
   // Create the dof handlers.
@@ -359,11 +495,34 @@ PDEProblem<dim, degree>::init_system()
   nonexplicit_self_nonlinear_solver.init();
   CALI_MARK_END("Self-nonlinear init");
 
+  CALI_MARK_BEGIN("Co-nonlinear init");
+  nonexplicit_co_nonlinear_solver.init();
+  CALI_MARK_END("Co-nonlinear init");
+
   // Update ghosts
   CALI_MARK_BEGIN("Update ghosts");
   solution_handler.update_ghosts();
   CALI_MARK_END("Update ghosts");
 
+  // Adapt the mesh to the initial condition. Each remeshing refines a cell by at most one
+  // level, so this takes one remeshing per level above the global refinement. The
+  // initial condition is re-applied each time, rather than interpolated from the coarser
+  // mesh, so that the interfaces are resolved at the finest level.
+  if (user_inputs.spatial_discretization.has_adaptivity)
+    {
+      conditionalOStreams::pout_base() << "adapting mesh to initial condition...\n"
+                                       << std::flush;
+      for (unsigned int level = user_inputs.spatial_discretization.global_refinement;
+           level < user_inputs.spatial_discretization.max_refinement;
+           ++level)
+        {
+          CALI_MARK_BEGIN("Initial remeshing");
+          reinit_system();
+          apply_initial_condition();
+          CALI_MARK_END("Initial remeshing");
+        }
+    }
+
   // Solve the auxiliary fields at the 0th step
   conditionalOStreams::pout_base() << "solving auxiliary variables in 0th timestep...\n"
                                    << std::flush;
@@ -387,6 +546,14 @@ PDEProblem<dim, degree>::init_system()
   nonexplicit_self_nonlinear_solver.solve();
   CALI_MARK_END("Self-nonlinear solve");
 
+  // Solve the co-nonlinear time-independent fields at the 0th step
+  conditionalOStreams::pout_base()
+    << "solving co-nonlinear time-independent variables in 0th timestep...\n"
+    << std::flush;
+  CALI_MARK_BEGIN("Co-nonlinear solve");
+  nonexplicit_co_nonlinear_solver.solve();
+  CALI_MARK_END("Co-nonlinear solve");
+
   // Solve the postprocessed fields at the 0th step
   conditionalOStreams::pout_base()
     << "solving postprocessed variables in 0th timestep...\n"
@@ -395,19 +562,192 @@ PDEProblem<dim, degree>::init_system()
   postprocess_explicit_solver.solve();
   CALI_MARK_END("Postprocess solve");
 
-  // Output initial condition
-  conditionalOStreams::pout_base() << "outputting initial condition...\n" << std::flush;
-  CALI_MARK_BEGIN("Solution output");
-  solutionOutput<dim> output_solution(solution_handler.solution_set,
-                                      dof_handler.const_dof_handlers,
-                                      degree,
-                                      "solution",
-                                      user_inputs);
-  CALI_MARK_END("Solution output");
+  // Output initial condition. With parareal, only the first time slice does this.
+  if (parareal_driver.get_time_slice() == 0)
+    {
+      conditionalOStreams::pout_base() << "outputting initial condition...\n"
+                                       << std::flush;
+      CALI_MARK_BEGIN("Solution output");
+      solutionOutput<dim> output_solution(solution_handler.solution_set,
+                                          dof_handler.const_dof_handlers,
+                                          degree,
+                                          "solution",
+                                          user_inputs);
+      CALI_MARK_END("Solution output");
+    }
 
   timer::serial_timer().leave_subsection();
 }
 
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::reinit_system()
+{
+  if constexpr (dim == 1)
+    {
+      AssertThrow(false, FeatureNotImplemented("Adaptive meshing in 1D"));
+    }
+  else
+    {
+      using SolutionTransfer =
+        dealii::parallel::distributed::SolutionTransfer<dim, VectorType>;
+
+      timer::serial_timer().enter_subsection("Reinitialization");
+
+      // Flag the cells according to the refinement criteria
+      CALI_MARK_BEGIN("Mark cells");
+      solution_handler.update_ghosts();
+      grid_refiner.mark_cells();
+      triangulation_handler.prepare_coarsening_and_refinement();
+      CALI_MARK_END("Mark cells");
+
+      // Weigh the cells of the current mesh so that the partitioning of the refined mesh
+      // balances the cost rather than the number of cells
+      const bool weighted = user_inputs.spatial_discretization.active_field_cost > 0.0;
+      if (weighted)
+        {
+          grid_refiner.compute_cell_weights();
+
+          // Fit the cost model to the time of the last increment on this mesh. There is
+          // no measurement during the initial remeshing.
+          if (user_inputs.spatial_discretization.calibrate_active_field_cost &&
+              increment_cpu_time > 0.0)
+            {
+              grid_refiner.calibrate_active_field_cost(increment_cpu_time);
+              conditionalOStreams::pout_summary()
+                << "  calibrated active field cost: "
+                << grid_refiner.get_active_field_cost() << "\n"
+                << std::flush;
+            }
+          conditionalOStreams::pout_summary()
+            << "  load imbalance before remeshing: predicted "
+            << grid_refiner.get_predicted_load_imbalance() << ", measured "
+            << grid_refiner.compute_load_imbalance(increment_cpu_time) << "\n"
+            << std::flush;
+        }
+
+      // The whole state is transferred to the new mesh, including the old solutions of
+      // the time-stepping. The vectors of a field share a DoFHandler, so they are
+      // transferred together.
+      auto field_state = get_field_state();
+
+      CALI_MARK_BEGIN("Refine mesh");
+      std::map<unsigned int, std::unique_ptr<SolutionTransfer>> solution_transfer;
+      for (const auto &[index, vectors] : field_state)
+        {
+          solution_transfer.emplace(index,
+                                    std::make_unique<SolutionTransfer>(
+                                      *dof_handler.const_dof_handlers.at(index)));
+          solution_transfer.at(index)->prepare_for_coarsening_and_refinement(
+            std::vector<const VectorType *>(vectors.begin(), vectors.end()));
+        }
+      triangulation_handler.execute_coarsening_and_refinement();
+      CALI_MARK_END("Refine mesh");
+
+      // Rebuild the DoFs, constraints, and matrix-free object on the new mesh. The
+      // matrix-free object is reinitialized in place, so the solvers keep pointing to it.
+      CALI_MARK_BEGIN("Matrix-free reinit");
+      dof_handler.reinit(fe_system);
+      constraint_handler.make_constraints(mapping, dof_handler.dof_handlers);
+      matrix_free_handler.reinit(mapping,
+                                 dof_handler.const_dof_handlers,
+                                 constraint_handler.get_constraints(),
+                                 dealii::QGaussLobatto<1>(degree + 1));
+      CALI_MARK_END("Matrix-free reinit");
+
+      // Resize the solution vectors and interpolate the solutions onto them
+      CALI_MARK_BEGIN("Solution transfer");
+      solution_handler.init(matrix_free_handler);
+      for (auto &[index, vectors] : field_state)
+        {
+          solution_transfer.at(index)->interpolate(vectors);
+          for (auto *vector : vectors)
+            {
+              constraint_handler.get_constraint(index).distribute(*vector);
+            }
+        }
+      solution_handler.mark_all_changed();
+      solution_handler.update_ghosts();
+      CALI_MARK_END("Solution transfer");
+
+      CALI_MARK_BEGIN("Invm init");
+      invm_handler.recompute_invm();
+      CALI_MARK_END("Invm init");
+
+      CALI_MARK_BEGIN("Element volume init");
+      element_volume.compute_element_volume(fe_system.begin()->second);
+      CALI_MARK_END("Element volume init");
+
+      // Rebuild the operators of the solvers, including the multigrid hierarchies. The
+      // hierarchies of the old mesh are released, so each one is rebuilt once.
+      CALI_MARK_BEGIN("Solver reinit");
+      multigrid_hierarchy_handler.clear();
+      explicit_constant_solver.reinit();
+      explicit_solver.reinit();
+      postprocess_explicit_solver.reinit();
+      nonexplicit_auxiliary_solver.reinit();
+      nonexplicit_linear_solver.reinit();
+      nonexplicit_self_nonlinear_solver.reinit();
+      nonexplicit_co_nonlinear_solver.reinit();
+      CALI_MARK_END("Solver reinit");
+
+      conditionalOStreams::pout_summary()
+        << "  number of active cells: "
+        << triangulation_handler.get_triangulation().n_global_active_cells() << "\n"
+        << std::flush;
+
+      // The measured imbalance of the new partitioning is reported after the next
+      // increment
+      if (weighted)
+        {
+          grid_refiner.compute_cell_weights();
+          conditionalOStreams::pout_summary()
+            << "  predicted load imbalance after remeshing: "
+            << grid_refiner.get_predicted_load_imbalance() << "\n"
+            << std::flush;
+          report_load_imbalance = true;
+        }
+
+      timer::serial_timer().leave_subsection();
+    }
+}
+
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::apply_initial_condition()
+{
+  for (const auto &[index, variable] : user_inputs.var_attributes)
+    {
+      // Like the solvers, only the fields that are not computed from the others get an
+      // initial condition
+      if (variable.is_postprocess || variable.pde_type == PDEType::AUXILIARY)
+        {
+          continue;
+        }
+
+      VectorType *solution =
+        solution_handler.solution_set.at(std::make_pair(index, dependencyType::NORMAL));
+      dealii::VectorTools::interpolate(mapping,
+                                       *(dof_handler.const_dof_handlers.at(index)),
+                                       initialCondition<dim>(index, variable.field_type),
+                                       *solution);
+      constraint_handler.get_constraint(index).distribute(*solution);
+
+      // The nonexplicit solvers start the old solution from the initial condition
+      const auto old_pair = std::make_pair(index, dependencyType::OLD_1);
+      if ((variable.pde_type == PDEType::IMPLICIT_TIME_DEPENDENT ||
+           variable.pde_type == PDEType::TIME_INDEPENDENT) &&
+          solution_handler.solution_set.find(old_pair) !=
+            solution_handler.solution_set.end())
+        {
+          *(solution_handler.solution_set.at(old_pair)) = *solution;
+        }
+    }
+
+  solution_handler.mark_all_changed();
+  solution_handler.update_ghosts();
+}
+
 template <int dim, int degree>
 void
 PDEProblem<dim, degree>::solve_increment()
@@ -435,6 +775,10 @@ PDEProblem<dim, degree>::solve_increment()
   nonexplicit_self_nonlinear_solver.solve();
   CALI_MARK_END("Self-nonlinear solve");
 
+  CALI_MARK_BEGIN("Co-nonlinear solve");
+  nonexplicit_co_nonlinear_solver.solve();
+  CALI_MARK_END("Co-nonlinear solve");
+
   timer::serial_timer().leave_subsection();
 }
 
@@ -457,46 +801,318 @@ PDEProblem<dim, degree>::solve()
        "  Solve\n"
     << "================================================\n"
     << std::flush;
+
+  if (user_inputs.parareal_parameters.is_enabled())
+    {
+      solve_parareal();
+      return;
+    }
+
   while (user_inputs.temporal_discretization.increment <
          user_inputs.temporal_discretization.total_increments)
     {
       user_inputs.temporal_discretization.increment++;
       user_inputs.temporal_discretization.time += user_inputs.temporal_discretization.dt;
 
+      // Request the relative change of the explicit fields if we're checking for
+      // steady-state this increment
+      const bool check_steady_state =
+        user_inputs.temporal_discretization.should_check_steady_state(
+          user_inputs.temporal_discretization.increment);
+      if (check_steady_state)
+        {
+          explicit_solver.request_relative_change();
+        }
+
+      // Adapt the mesh to the current solutions
+      if (user_inputs.spatial_discretization.has_adaptivity &&
+          user_inputs.temporal_discretization.increment %
+              user_inputs.spatial_discretization.remeshing_period ==
+            0)
+        {
+          CALI_MARK_BEGIN("Reinit system");
+          reinit_system();
+          CALI_MARK_END("Reinit system");
+        }
+
       CALI_MARK_BEGIN("Solve increment");
+      const dealii::Timer increment_timer;
       solve_increment();
+      increment_cpu_time = increment_timer.cpu_time();
       CALI_MARK_END("Solve increment");
 
-      if (user_inputs.output_parameters.should_output(
-            user_inputs.temporal_discretization.increment))
+      if (report_load_imbalance)
         {
-          CALI_MARK_BEGIN("Output");
+          conditionalOStreams::pout_summary()
+            << "  measured load imbalance after remeshing: "
+            << grid_refiner.compute_load_imbalance(increment_cpu_time) << "\n"
+            << std::flush;
+          report_load_imbalance = false;
+        }
 
-          CALI_MARK_BEGIN("Postprocess solve");
-          postprocess_explicit_solver.solve();
-          CALI_MARK_END("Postprocess solve");
+      const bool steady_state = check_steady_state && is_steady_state();
 
-          CALI_MARK_BEGIN("Solution output");
-          solutionOutput<dim> output_solution(solution_handler.solution_set,
-                                              dof_handler.const_dof_handlers,
-                                              degree,
-                                              "solution",
-                                              user_inputs);
-          CALI_MARK_END("Solution output");
+      if (user_inputs.output_parameters.should_output(
+            user_inputs.temporal_discretization.increment) ||
+          steady_state)
+        {
+          output_results();
+        }
 
-          // Print the l2-norms of each solution
+      if (steady_state)
+        {
+          write_checkpoint();
           conditionalOStreams::pout_base()
-            << "Iteration: " << user_inputs.temporal_discretization.increment << "\n";
-          for (const auto &[pair, vector] : solution_handler.solution_set)
+            << "Steady-state reached at increment "
+            << user_inputs.temporal_discretization.increment << " (time "
+            << user_inputs.temporal_discretization.time << ")\n\n"
+            << std::flush;
+          break;
+        }
+    }
+}
+
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::propagate_time_slice(const unsigned int &time_slice,
+                                              const unsigned int &timestep_ratio,
+                                              const bool         &with_output)
+{
+  const auto        &temporal_discretization = user_inputs.temporal_discretization;
+  const double       fine_dt                 = temporal_discretization.dt;
+  const unsigned int increments_per_slice =
+    user_inputs.parareal_parameters.increments_per_slice;
+
+  // The parareal driver overwrites the locally owned entries of the solution vectors in
+  // place, so the ghost values are out of date
+  solution_handler.mark_all_changed();
+  solution_handler.update_ghosts();
+
+  // Reset the time to the start of the slice
+  temporal_discretization.increment = time_slice * increments_per_slice;
+  temporal_discretization.time =
+    fine_dt * static_cast<double>(temporal_discretization.increment);
+  temporal_discretization.dt = fine_dt * static_cast<double>(timestep_ratio);
+
+  for (unsigned int step = 0; step < increments_per_slice / timestep_ratio; ++step)
+    {
+      temporal_discretization.increment += timestep_ratio;
+      temporal_discretization.time += temporal_discretization.dt;
+
+      solve_increment();
+
+      if (with_output && user_inputs.output_parameters.should_output(
+                           temporal_discretization.increment))
+        {
+          output_results();
+        }
+    }
+
+  temporal_discretization.dt = fine_dt;
+}
+
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::solve_parareal()
+{
+  // The time slices exchange their states as vectors, so they must share the mesh
+  AssertThrow(!user_inputs.spatial_discretization.has_adaptivity,
+              FeatureNotImplemented("Adaptive meshing with parareal"));
+
+  // The parareal state is the whole state of the simulation, so that each time slice
+  // restarts from exactly the same data as the serial time-stepping
+  std::vector<VectorType *> state;
+  for (const auto &[index, vectors] : get_field_state())
+    {
+      state.insert(state.end(), vectors.begin(), vectors.end());
+    }
+
+  CALI_MARK_BEGIN("Parareal");
+  const unsigned int n_iterations = parareal_driver.solve(
+    state,
+    [this](const unsigned int &time_slice)
+    {
+      propagate_time_slice(time_slice,
+                           user_inputs.parareal_parameters.coarse_timestep_ratio,
+                           false);
+    },
+    [this](const unsigned int &time_slice)
+    {
+      propagate_time_slice(time_slice, 1, false);
+    });
+  CALI_MARK_END("Parareal");
+
+  conditionalOStreams::pout_base()
+    << "parareal finished after " << n_iterations << " iterations\n\n"
+    << std::flush;
+
+  // Rerun the fine propagator from the converged slice states to write the outputs
+  CALI_MARK_BEGIN("Solve increment");
+  propagate_time_slice(parareal_driver.get_time_slice(), 1, true);
+  CALI_MARK_END("Solve increment");
+
+  // Only the first time slice prints, so report the final state from there as well
+  parareal_driver.load_final_state();
+  solution_handler.mark_all_changed();
+  solution_handler.update_ghosts();
+  user_inputs.temporal_discretization.increment =
+    user_inputs.temporal_discretization.total_increments;
+  user_inputs.temporal_discretization.time =
+    user_inputs.temporal_discretization.dt *
+    static_cast<double>(user_inputs.temporal_discretization.total_increments);
+  postprocess_explicit_solver.solve();
+  print_solution_norms();
+}
+
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::output_results()
+{
+  CALI_MARK_BEGIN("Output");
+
+  CALI_MARK_BEGIN("Postprocess solve");
+  postprocess_explicit_solver.solve();
+  CALI_MARK_END("Postprocess solve");
+
+  CALI_MARK_BEGIN("Solution output");
+  solutionOutput<dim> output_solution(solution_handler.solution_set,
+                                      dof_handler.const_dof_handlers,
+                                      degree,
+                                      "solution",
+                                      user_inputs);
+  CALI_MARK_END("Solution output");
+
+  print_solution_norms();
+  CALI_MARK_END("Output");
+}
+
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::print_solution_norms() const
+{
+  conditionalOStreams::pout_base()
+    << "Iteration: " << user_inputs.temporal_discretization.increment << "\n";
+  for (const auto &[pair, vector] : solution_handler.solution_set)
+    {
+      conditionalOStreams::pout_base()
+        << "  Solution index " << pair.first << " type " << to_string(pair.second)
+        << " l2-norm: " << vector->l2_norm() << "\n";
+    }
+  conditionalOStreams::pout_base() << "\n" << std::flush;
+}
+
+template <int dim, int degree>
+bool
+PDEProblem<dim, degree>::is_steady_state() const
+{
+  const auto &relative_change = explicit_solver.get_relative_change();
+
+  // Without any monitored fields we can't say anything about steady-state
+  if (relative_change.empty())
+    {
+      return false;
+    }
+
+  bool converged = true;
+  conditionalOStreams::pout_summary()
+    << "Steady-state check at increment "
+    << user_inputs.temporal_discretization.increment << "\n";
+  for (const auto &[index, change] : relative_change)
+    {
+      conditionalOStreams::pout_summary()
+        << "  " << user_inputs.var_attributes.at(index).name
+        << " relative change: " << change << "\n";
+      converged =
+        converged && change < user_inputs.temporal_discretization.steady_state_tolerance;
+    }
+  conditionalOStreams::pout_summary() << std::flush;
+
+  return converged;
+}
+
+template <int dim, int degree>
+void
+PDEProblem<dim, degree>::write_checkpoint()
+{
+  if constexpr (dim == 1)
+    {
+      AssertThrow(false, FeatureNotImplemented("Checkpoints in 1D"));
+    }
+  else
+    {
+      using SolutionTransfer =
+        dealii::parallel::distributed::SolutionTransfer<dim, VectorType>;
+
+      CALI_MARK_BEGIN("Checkpoint");
+      const MPI_Comm &mpi_communicator = triangulation_handler.get_mpi_communicator();
+      const bool      is_root =
+        dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0;
+
+      // Keep the previous checkpoint as a backup
+      if (is_root)
+        {
+          for (const std::string filename : {"restart.mesh",
+                                             "restart.mesh.info",
+                                             "restart.mesh_fixed.data",
+                                             "restart.mesh_variable.data",
+                                             "restart.time.info"})
             {
-              conditionalOStreams::pout_base()
-                << "  Solution index " << pair.first << " type " << to_string(pair.second)
-                << " l2-norm: " << vector->l2_norm() << "\n";
+              if (std::filesystem::exists(filename))
+                {
+                  std::filesystem::rename(filename, filename + ".old");
+                }
             }
-          conditionalOStreams::pout_base() << "\n" << std::flush;
-          CALI_MARK_END("Output");
         }
+      MPI_Barrier(mpi_communicator);
+
+      // The solutions are attached to the triangulation, so they are written along with
+      // it
+      solution_handler.update_ghosts();
+      const auto field_state = get_field_state();
+      std::map<unsigned int, std::unique_ptr<SolutionTransfer>> solution_transfer;
+      for (const auto &[index, vectors] : field_state)
+        {
+          solution_transfer.emplace(index,
+                                    std::make_unique<SolutionTransfer>(
+                                      *dof_handler.const_dof_handlers.at(index)));
+          solution_transfer.at(index)->prepare_for_serialization(
+            std::vector<const VectorType *>(vectors.begin(), vectors.end()));
+        }
+      triangulation_handler.save("restart.mesh");
+
+      if (is_root)
+        {
+          std::ofstream time_info("restart.time.info");
+          time_info << user_inputs.temporal_discretization.increment << " (increment)\n"
+                    << user_inputs.temporal_discretization.time << " (time)\n";
+        }
+
+      conditionalOStreams::pout_base()
+        << "Checkpoint written at increment "
+        << user_inputs.temporal_discretization.increment << "\n"
+        << std::flush;
+      CALI_MARK_END("Checkpoint");
+    }
+}
+
+template <int dim, int degree>
+std::map<unsigned int, std::vector<typename PDEProblem<dim, degree>::VectorType *>>
+PDEProblem<dim, degree>::get_field_state() const
+{
+  std::map<std::pair<unsigned int, dependencyType>, VectorType *> sorted_state;
+  for (const auto &[pair, vector] : solution_handler.solution_set)
+    {
+      if (pair.second != dependencyType::CHANGE)
+        {
+          sorted_state.emplace(pair, vector);
+        }
+    }
+  std::map<unsigned int, std::vector<VectorType *>> field_state;
+  for (const auto &[pair, vector] : sorted_state)
+    {
+      field_state[pair.first].push_back(vector);
     }
+  return field_state;
 }
 
 template <int dim, int degree>
@@ -52,6 +52,26 @@ public:
   void
   update(const fieldSolveType &field_solve_type, const unsigned int &variable_index = 0);
 
+  /**
+   * \brief Mark the solutions of a field as modified. `update()` does this itself, so
+   * this is only needed when a solution vector is modified in place.
+   */
+  void
+  mark_changed(const unsigned int &index);
+
+  /**
+   * \brief Mark the solutions of all fields as modified.
+   */
+  void
+  mark_all_changed();
+
+  /**
+   * \brief Return a stamp that changes whenever the solutions of the given field are
+   * modified. This allows solvers to skip work that only depends on unchanged fields.
+   */
+  [[nodiscard]] unsigned int
+  get_version(const unsigned int &index) const;
+
   /**
    * \brief The collection of solution vector at the current timestep. This includes
    * current values and old values.
@@ -71,6 +91,17 @@ private:
    * \brief The attribute list of the relevant variables.
    */
   const std::map<unsigned int, variableAttributes> &attributes_list;
+
+  /**
+   * \brief The version stamp of each field. Fields that are not in the map have not
+   * been modified since initialization.
+   */
+  std::unordered_map<unsigned int, unsigned int> versions;
+
+  /**
+   * \brief The total number of modifications. This is used to generate unique stamps.
+   */
+  unsigned int n_modifications = 0;
 };
 
 PRISMS_PF_END_NAMESPACE
@@ -87,7 +87,7 @@ solutionOutput<dim, number>::solutionOutput(const VectorType               &solu
   data_out.write_vtu_with_pvtu_record("./",
                                       name,
                                       user_inputs.temporal_discretization.increment,
-                                      MPI_COMM_WORLD,
+                                      dof_handler.get_communicator(),
                                       n_trailing_digits);
 }
 
@@ -152,7 +152,7 @@ solutionOutput<dim, number>::solutionOutput(
   data_out.write_vtu_with_pvtu_record("./",
                                       name,
                                       user_inputs.temporal_discretization.increment,
-                                      MPI_COMM_WORLD,
+                                      dof_handlers.front()->get_communicator(),
                                       n_trailing_digits);
 }
 
@@ -4,14 +4,18 @@
 #ifndef triangulation_handler_h
 #define triangulation_handler_h
 
-#include <deal.II/distributed/tria.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/distributed/tria_base.h>
 #include <deal.II/grid/tria.h>
 
 #include <prismspf/config.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 PRISMS_PF_BEGIN_NAMESPACE
 
@@ -25,12 +29,18 @@ public:
   using Triangulation =
     std::conditional_t<dim == 1,
                        dealii::Triangulation<dim>,
-                       dealii::parallel::distributed::Triangulation<dim>>;
+                       dealii::parallel::TriangulationBase<dim>>;
+  using CellStatus         = typename dealii::Triangulation<dim>::CellStatus;
+  using CellWeightFunction = std::function<unsigned int(
+    const typename dealii::Triangulation<dim>::cell_iterator &,
+    const CellStatus)>;
 
   /**
-   * \brief Constructor.
+   * \brief Constructor. The triangulation is distributed over the given MPI
+   * communicator.
    */
-  triangulationHandler(const userInputParameters<dim> &_user_inputs);
+  triangulationHandler(const userInputParameters<dim> &_user_inputs,
+                       const MPI_Comm                 &_mpi_communicator = MPI_COMM_WORLD);
 
   /**
    * \brief Getter function for triangulation (constant reference).
@@ -45,11 +55,57 @@ public:
   get_n_global_levels() const;
 
   /**
-   * \brief Generate mesh.
+   * \brief Return the MPI communicator the triangulation is distributed over.
+   */
+  [[nodiscard]] const MPI_Comm &
+  get_mpi_communicator() const;
+
+  /**
+   * \brief Generate mesh. For a fully distributed mesh, each process only creates its
+   * own partition of the mesh and the cells around it, including all levels of the
+   * global refinement.
    */
   void
   generate_mesh();
 
+  /**
+   * \brief Create the triangulations of the geometric multigrid levels, from the
+   * coarsest to the current mesh. deal.II can't coarsen a fully distributed
+   * triangulation, so its levels are created from the description of the globally
+   * refined mesh instead.
+   */
+  [[nodiscard]] std::vector<std::shared_ptr<const dealii::Triangulation<dim>>>
+  create_coarsening_sequence() const;
+
+  /**
+   * \brief Smooth the refinement and coarsening flags of the cells, so that the mesh
+   * stays balanced. This must be called before the solution vectors are prepared for the
+   * transfer.
+   */
+  void
+  prepare_coarsening_and_refinement();
+
+  /**
+   * \brief Refine and coarsen the cells according to their flags. The mesh is then
+   * repartitioned, using the cell weight if one is set.
+   */
+  void
+  execute_coarsening_and_refinement();
+
+  /**
+   * \brief Set the weight of the cells for the partitioning of the mesh. Without it, the
+   * partitioning balances the number of cells.
+   */
+  void
+  set_cell_weight(const CellWeightFunction &cell_weight);
+
+  /**
+   * \brief Save the triangulation, along with any data that is attached to it for
+   * serialization, to the given file.
+   */
+  void
+  save(const std::string &filename) const;
+
   /**
    * \brief Export triangulation to vtk.
    */
@@ -65,16 +121,41 @@ private:
   mark_boundaries() const;
 
   /**
-   * \brief Mark certain faces of the triangulation periodic.
+   * \brief Mark certain faces of the given triangulation periodic.
+   */
+  void
+  mark_periodic(dealii::Triangulation<dim> &_triangulation) const;
+
+  /**
+   * \brief Return whether the mesh is periodic in each cartesian direction.
+   */
+  [[nodiscard]] std::array<bool, dim>
+  get_periodic_directions() const;
+
+  /**
+   * \brief Create the locally relevant part of the rectangular mesh with the given number
+   * of levels of global refinement on a fully distributed triangulation. The coarse cells
+   * are numbered lexicographically and each process owns a contiguous range of them,
+   * along with all of their children.
+   *
+   * The partitions are therefore slabs of the coarse grid, rather than the compact
+   * partitions of the Morton order used by p4est, so they have more ghost cells and
+   * communicate more when there are many more coarse cells than processes.
    */
   void
-  mark_periodic();
+  create_fully_distributed_mesh(dealii::Triangulation<dim> &_triangulation,
+                                const unsigned int         &n_levels) const;
 
   /**
    * \brief User-inputs.
    */
   const userInputParameters<dim> &user_inputs;
 
+  /**
+   * \brief MPI communicator.
+   */
+  MPI_Comm mpi_communicator;
+
   /**
    * \brief Triangulation.
    */
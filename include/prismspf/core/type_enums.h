@@ -107,7 +107,76 @@ enum solverToleranceType : std::uint8_t
 enum preconditionerType : std::uint8_t
 {
   NONE,
-  GMG
+  GMG,
+  JACOBI,
+  CHEBYSHEV,
+  CELL_PATCH
+};
+
+/**
+ * \brief Krylov method for the linear solve.
+ */
+enum linearSolverType : std::uint8_t
+{
+  SOLVER_CG,
+  SOLVER_GMRES,
+  SOLVER_FGMRES,
+  SOLVER_BICGSTAB,
+  SOLVER_PIPELINED_CG
+};
+
+/**
+ * \brief Initial guess for the Krylov solve of the newton update.
+ */
+enum initialGuessType : std::uint8_t
+{
+  ZERO_INITIAL_GUESS,
+  LINEAR_EXTRAPOLATION,
+  QUADRATIC_EXTRAPOLATION,
+  POD_PROJECTION
+};
+
+/**
+ * \brief Criterion that decides whether a time-independent field is solved again in an
+ * increment or keeps its previous solution.
+ */
+enum resolveCriterion : std::uint8_t
+{
+  ALWAYS_RESOLVE,
+  RESIDUAL_RESOLVE,
+  DEPENDENCY_CHANGE_RESOLVE
+};
+
+/**
+ * \brief Sequence of polynomial degrees for the polynomial coarsening of the multigrid
+ * preconditioner.
+ */
+enum polynomialCoarseningType : std::uint8_t
+{
+  NO_POLYNOMIAL_COARSENING,
+  DECREASE_BY_ONE,
+  BISECT,
+  GO_TO_ONE
+};
+
+/**
+ * \brief Solver for the coarsest level of the multigrid preconditioner.
+ */
+enum coarseSolverType : std::uint8_t
+{
+  COARSE_SMOOTHER,
+  COARSE_CG,
+  COARSE_AMG,
+  COARSE_DIRECT
+};
+
+/**
+ * \brief Preconditioner of the Chebyshev smoother of the multigrid preconditioner.
+ */
+enum smootherType : std::uint8_t
+{
+  JACOBI_SMOOTHER,
+  CELL_PATCH_SMOOTHER
 };
 
 /**
@@ -280,6 +349,134 @@ to_string(preconditionerType type)
         return "NONE";
       case preconditionerType::GMG:
         return "GMG";
+      case preconditionerType::JACOBI:
+        return "JACOBI";
+      case preconditionerType::CHEBYSHEV:
+        return "CHEBYSHEV";
+      case preconditionerType::CELL_PATCH:
+        return "CELL_PATCH";
+      default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * \brief Enum to string for linearSolverType
+ */
+inline std::string
+to_string(linearSolverType type)
+{
+  switch (type)
+    {
+      case linearSolverType::SOLVER_CG:
+        return "CG";
+      case linearSolverType::SOLVER_GMRES:
+        return "GMRES";
+      case linearSolverType::SOLVER_FGMRES:
+        return "FGMRES";
+      case linearSolverType::SOLVER_BICGSTAB:
+        return "BICGSTAB";
+      case linearSolverType::SOLVER_PIPELINED_CG:
+        return "PIPELINED_CG";
+      default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * \brief Enum to string for initialGuessType
+ */
+inline std::string
+to_string(initialGuessType type)
+{
+  switch (type)
+    {
+      case initialGuessType::ZERO_INITIAL_GUESS:
+        return "NONE";
+      case initialGuessType::LINEAR_EXTRAPOLATION:
+        return "LINEAR";
+      case initialGuessType::QUADRATIC_EXTRAPOLATION:
+        return "QUADRATIC";
+      case initialGuessType::POD_PROJECTION:
+        return "POD";
+      default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * \brief Enum to string for resolveCriterion
+ */
+inline std::string
+to_string(resolveCriterion type)
+{
+  switch (type)
+    {
+      case resolveCriterion::ALWAYS_RESOLVE:
+        return "ALWAYS";
+      case resolveCriterion::RESIDUAL_RESOLVE:
+        return "RESIDUAL";
+      case resolveCriterion::DEPENDENCY_CHANGE_RESOLVE:
+        return "DEPENDENCY_CHANGE";
+      default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * \brief Enum to string for polynomialCoarseningType
+ */
+inline std::string
+to_string(polynomialCoarseningType type)
+{
+  switch (type)
+    {
+      case polynomialCoarseningType::NO_POLYNOMIAL_COARSENING:
+        return "NONE";
+      case polynomialCoarseningType::DECREASE_BY_ONE:
+        return "DECREASE_BY_ONE";
+      case polynomialCoarseningType::BISECT:
+        return "BISECT";
+      case polynomialCoarseningType::GO_TO_ONE:
+        return "GO_TO_ONE";
+      default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * \brief Enum to string for coarseSolverType
+ */
+inline std::string
+to_string(coarseSolverType type)
+{
+  switch (type)
+    {
+      case coarseSolverType::COARSE_SMOOTHER:
+        return "SMOOTHER";
+      case coarseSolverType::COARSE_CG:
+        return "CG";
+      case coarseSolverType::COARSE_AMG:
+        return "AMG";
+      case coarseSolverType::COARSE_DIRECT:
+        return "DIRECT";
+      default:
+        return "UNKNOWN";
+    }
+}
+
+/**
+ * \brief Enum to string for smootherType
+ */
+inline std::string
+to_string(smootherType type)
+{
+  switch (type)
+    {
+      case smootherType::JACOBI_SMOOTHER:
+        return "JACOBI";
+      case smootherType::CELL_PATCH_SMOOTHER:
+        return "CELL_PATCH";
       default:
         return "UNKNOWN";
     }
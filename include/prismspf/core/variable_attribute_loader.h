@@ -90,6 +90,19 @@ protected:
   void
   set_is_postprocessed_field(const unsigned int &index, const bool &is_postprocess);
 
+  /**
+   * \brief Set the number of polynomial degrees that the variable at `index` is
+   * discretized below the degree of the problem. Fields that are smoother than the
+   * others, like displacements, can use fewer degrees of freedom. Other fields still
+   * read them at the quadrature points of the problem degree.
+   *
+   * \param index Index of variable
+   * \param degree_reduction Number of degrees below the degree of the problem.
+   */
+  void
+  set_variable_degree_reduction(const unsigned int &index,
+                                const unsigned int &degree_reduction);
+
   /**
    * \brief Add dependencies for the value term of the RHS equation of the variable at
    * `index`.
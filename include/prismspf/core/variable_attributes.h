@@ -61,6 +61,12 @@ struct variableAttributes
    */
   bool is_postprocess = false;
 
+  /**
+   * \brief Number of polynomial degrees that the field is discretized below the degree
+   * of the problem. \remark User-set
+   */
+  unsigned int degree_reduction = 0;
+
   /**
    * \brief Internal classification for the field solve type. \remark Internally
    * determined
@@ -4,6 +4,7 @@
 #ifndef variable_container_h
 #define variable_container_h
 
+#include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/vector.h>
 #include <deal.II/matrix_free/evaluation_flags.h>
 #include <deal.II/matrix_free/fe_evaluation.h>
@@ -11,9 +12,12 @@
 
 #include <prismspf/config.h>
 #include <prismspf/core/exceptions.h>
+#include <prismspf/core/field_evaluation.h>
 #include <prismspf/core/type_enums.h>
 #include <prismspf/core/variable_attributes.h>
 
+#include <vector>
+
 PRISMS_PF_BEGIN_NAMESPACE
 
 /**
@@ -21,7 +25,8 @@ PRISMS_PF_BEGIN_NAMESPACE
  * if any non-allowed fields are requested.
  *
  * \tparam dim The number of dimensions in the problem.
- * \tparam degree The polynomial degree of the shape functions.
+ * \tparam degree The polynomial degree of the shape functions. Fields with a reduced
+ * degree are evaluated at the same quadrature points.
  * \tparam number Datatype to use for `dealii::VectorizedArray<number>`. Either
  * double or float.
  */
@@ -29,9 +34,10 @@ template <int dim, int degree, typename number>
 class variableContainer
 {
 public:
-  using VectorType = dealii::LinearAlgebra::distributed::Vector<number>;
-  using value_type = number;
-  using size_type  = dealii::VectorizedArray<number>;
+  using VectorType      = dealii::LinearAlgebra::distributed::Vector<number>;
+  using BlockVectorType = dealii::LinearAlgebra::distributed::BlockVector<number>;
+  using value_type      = number;
+  using size_type       = dealii::VectorizedArray<number>;
 
   /**
    * \brief Constructor.
@@ -221,9 +227,98 @@ public:
     const std::vector<VectorType *>             &src_subset,
     const std::pair<unsigned int, unsigned int> &cell_range);
 
+  /**
+   * \brief Compute the element matrices of the LHS for a given cell range. The element
+   * matrices of each cell batch are stored column by column, in the lexicographic
+   * numbering of the shape functions, and passed to the distribute function along with
+   * the index of the cell batch.
+   */
+  void
+  eval_local_matrix(
+    const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+      &func,
+    const std::function<void(const unsigned int                      &cell,
+                             const dealii::AlignedVector<size_type> &cell_matrix)>
+                                                &distribute,
+    const std::vector<VectorType *>             &src_subset,
+    const std::pair<unsigned int, unsigned int> &cell_range);
+
+  /**
+   * \brief Linearize the LHS about the src subset for a given cell range. At every
+   * quadrature point, the user function is evaluated once for each value and gradient
+   * component of the change term, and the response is stored as a small dense matrix.
+   * The coefficients act on the quadrature data of the change term in reference
+   * coordinates, so they include the geometry and quadrature weights. The matrices are
+   * stored quadrature point by quadrature point within each cell batch, with the lanes
+   * of the cell batch interleaved.
+   */
+  void
+  eval_local_linearization(
+    const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                                &func,
+    dealii::AlignedVector<size_type>            &coefficients,
+    const std::vector<VectorType *>             &src_subset,
+    const std::pair<unsigned int, unsigned int> &cell_range);
+
+  /**
+   * \brief Apply the linearized LHS from eval_local_linearization() to the change term
+   * in the source vector for a given cell range. Only the change term is read and
+   * evaluated.
+   */
+  void
+  apply_local_linearization(const dealii::AlignedVector<size_type>      &coefficients,
+                            VectorType                                  &dst,
+                            const VectorType                            &src,
+                            const std::pair<unsigned int, unsigned int> &cell_range);
+
+  /**
+   * \brief Return the number of coefficients of the linearized LHS per cell batch.
+   */
+  [[nodiscard]] unsigned int
+  get_n_linearization_coefficients() const;
+
+  /**
+   * \brief Apply some operator function for a given cell range and source vector to
+   * some destination block vector. This is used for the residual of concurrent
+   * nonexplicit solves, where each block holds the residual of one field.
+   */
+  void
+  eval_local_operator(
+    const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                                &func,
+    BlockVectorType                             &dst,
+    const std::vector<VectorType *>             &src,
+    const std::pair<unsigned int, unsigned int> &cell_range);
+
+  /**
+   * \brief Apply some operator function for a given cell range and source block vector to
+   * some destination block vector. This is used for the newton update of concurrent
+   * nonexplicit solves, where each block holds the change of one field.
+   */
+  void
+  eval_local_operator(
+    const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                                &func,
+    BlockVectorType                             &dst,
+    const BlockVectorType                       &src,
+    const std::vector<VectorType *>             &src_subset,
+    const std::pair<unsigned int, unsigned int> &cell_range);
+
+  /**
+   * \brief Compute the diagonal of the diagonal blocks of a concurrent nonexplicit
+   * operator. The off-diagonal blocks are not evaluated.
+   */
+  void
+  eval_local_diagonal(
+    const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                                &func,
+    BlockVectorType                             &dst,
+    const std::vector<VectorType *>             &src_subset,
+    const std::pair<unsigned int, unsigned int> &cell_range);
+
 private:
-  using scalar_FEEval = dealii::FEEvaluation<dim, degree, degree + 1, 1, number>;
-  using vector_FEEval = dealii::FEEvaluation<dim, degree, degree + 1, dim, number>;
+  using scalar_FEEval = fieldEvaluation<dim, degree, 1, number>;
+  using vector_FEEval = fieldEvaluation<dim, degree, dim, number>;
 
   /**
    * \brief Check whether the map entry for the scalar FEEvaluation exists.
@@ -254,6 +349,13 @@ private:
   void
   submission_valid(const dependencyType &dependency_type) const;
 
+  /**
+   * \brief Check that the subset attributes either have a single variable or are a
+   * concurrent (co-nonlinear) set of nonexplicit variables.
+   */
+  void
+  subset_size_valid() const;
+
   /**
    * \brief Return the number of quadrature points.
    */
@@ -278,6 +380,13 @@ private:
   void
   reinit_and_eval(const VectorType &src, unsigned int cell);
 
+  /**
+   * \brief Initialize, read DOFs, and set evaulation flags for the change of each
+   * variable. This is used for concurrent nonexplicit solves.
+   */
+  void
+  reinit_and_eval(const BlockVectorType &src, unsigned int cell);
+
   /**
    * \brief Initialize the cell for all dependencies of a certain variable index.
    */
@@ -309,12 +418,74 @@ private:
   void
   integrate_and_distribute(VectorType &dst);
 
+  /**
+   * \brief Integrate the residuals and distribute from local to global.
+   */
+  void
+  integrate_and_distribute(BlockVectorType &dst);
+
   /**
    * \brief Integrate the residuals for a certain variable index.
    */
   void
   integrate(const unsigned int &global_variable_index);
 
+  /**
+   * \brief Return the number of dofs per cell of the change term of a certain variable
+   * index, summed over all components.
+   */
+  [[nodiscard]] unsigned int
+  get_change_dofs_per_cell(const unsigned int &global_variable_index) const;
+
+  /**
+   * \brief Submit zero for all dof values of the change term of a certain variable index.
+   */
+  void
+  zero_change_dof_values(const unsigned int &global_variable_index);
+
+  /**
+   * \brief Return a reference to a dof value of the change term of a certain variable
+   * index. For vector fields the dofs are numbered component by component.
+   */
+  size_type &
+  change_dof_value(const unsigned int &global_variable_index, unsigned int dof_index);
+
+  /**
+   * \brief Distribute the dof values of the change term of a certain variable index from
+   * local to global.
+   */
+  void
+  distribute_change(const unsigned int &global_variable_index, VectorType &dst);
+
+  /**
+   * \brief Return the LHS evaluation flags of the change term of a certain variable
+   * index. If the LHS does not depend on the change term, this is nothing.
+   */
+  [[nodiscard]] dealii::EvaluationFlags::EvaluationFlags
+  get_change_eval_flags(const unsigned int &global_variable_index) const;
+
+  /**
+   * \brief Return the number of value and gradient components of the change term of a
+   * certain variable index that are selected by the flags.
+   */
+  [[nodiscard]] unsigned int
+  get_n_change_terms(
+    const unsigned int                             &global_variable_index,
+    const dealii::EvaluationFlags::EvaluationFlags &flags) const;
+
+  /**
+   * \brief Fill pointers to the quadrature data of the change term of a certain variable
+   * index, one for each term selected by the flags. The values of all components come
+   * first, followed by the gradients component by component, and each pointer is
+   * indexed by the quadrature point. Note that the gradients are in reference
+   * coordinates.
+   */
+  void
+  get_change_quad_terms(
+    const unsigned int                             &global_variable_index,
+    const dealii::EvaluationFlags::EvaluationFlags &flags,
+    std::vector<size_type *>                       &terms);
+
   /**
    * \brief Map of FEEvaluation objects for each active scalar variables. The first
    * mapping is for the global variable and the second is for the dependencyType.
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef batched_cg_h
+#define batched_cg_h
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <prismspf/config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Preconditioned conjugate gradient solver for a batch of decoupled systems. Each
+ * block of the block vectors holds one system, which has its own CG recurrence and
+ * solver control, so every system converges exactly as if it was solved on its own.
+ * However, the operator is applied to all blocks at once and the dot products of all
+ * blocks are reduced together, so an iteration has two global reductions for the whole
+ * batch instead of two per system. Blocks that have converged are skipped.
+ *
+ * The operator must provide vmult(dst, src, active), which applies it to the active
+ * blocks only, and the preconditioner must be block diagonal.
+ */
+template <typename BlockVectorType>
+class batchedCG
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  explicit batchedCG(const std::vector<dealii::SolverControl *> &_solver_controls);
+
+  /**
+   * \brief Solve the systems Ax=b, starting from the given solutions.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType         &matrix,
+        BlockVectorType          &solution,
+        const BlockVectorType    &rhs,
+        const PreconditionerType &preconditioner);
+
+private:
+  /**
+   * \brief Compute the dot products of the given blocks and sum them over all processes
+   * in a single reduction.
+   */
+  [[nodiscard]] std::vector<double>
+  block_products(const std::vector<std::pair<const BlockVectorType *,
+                                             const BlockVectorType *>> &pairs) const;
+
+  /**
+   * \brief Solver controls of the blocks.
+   */
+  std::vector<dealii::SolverControl *> solver_controls;
+
+  /**
+   * \brief Whether the blocks are still iterating.
+   */
+  std::vector<bool> active;
+};
+
+template <typename BlockVectorType>
+batchedCG<BlockVectorType>::batchedCG(
+  const std::vector<dealii::SolverControl *> &_solver_controls)
+  : solver_controls(_solver_controls)
+  , active(_solver_controls.size(), true)
+{}
+
+template <typename BlockVectorType>
+template <typename MatrixType, typename PreconditionerType>
+inline void
+batchedCG<BlockVectorType>::solve(const MatrixType         &matrix,
+                                  BlockVectorType          &solution,
+                                  const BlockVectorType    &rhs,
+                                  const PreconditionerType &preconditioner)
+{
+  const unsigned int n_blocks = solution.n_blocks();
+  Assert(n_blocks == solver_controls.size(),
+         dealii::ExcMessage("There must be one solver control per block."));
+
+  BlockVectorType residual;
+  BlockVectorType preconditioned_residual;
+  BlockVectorType direction;
+  BlockVectorType matrix_direction;
+  residual.reinit(solution, true);
+  preconditioned_residual.reinit(solution, true);
+  direction.reinit(solution, true);
+  matrix_direction.reinit(solution, true);
+
+  std::fill(active.begin(), active.end(), true);
+  matrix.vmult(residual, solution, active);
+  residual.sadd(-1.0, 1.0, rhs);
+  preconditioner.vmult(preconditioned_residual, residual);
+  direction = preconditioned_residual;
+
+  std::vector<double>       residual_products(n_blocks, 0.0);
+  std::vector<unsigned int> iteration(n_blocks, 0);
+
+  // Check the convergence of the blocks and deactivate the ones that are done
+  const auto check = [&](const std::vector<double> &products)
+  {
+    for (unsigned int block = 0; block < n_blocks; ++block)
+      {
+        if (!active[block])
+          {
+            continue;
+          }
+        const double residual_norm = std::sqrt(products[2 * block]);
+        active[block] =
+          solver_controls[block]->check(iteration[block], residual_norm) ==
+          dealii::SolverControl::iterate;
+        residual_products[block] = products[(2 * block) + 1];
+      }
+  };
+
+  check(
+    block_products({{&residual, &residual}, {&residual, &preconditioned_residual}}));
+
+  while (std::any_of(active.begin(), active.end(), [](bool value) { return value; }))
+    {
+      matrix.vmult(matrix_direction, direction, active);
+      const std::vector<double> curvatures =
+        block_products({{&direction, &matrix_direction}});
+
+      for (unsigned int block = 0; block < n_blocks; ++block)
+        {
+          if (!active[block])
+            {
+              continue;
+            }
+          AssertThrow(curvatures[block] > 0.0,
+                      dealii::ExcMessage(
+                        "Batched CG requires symmetric positive definite operators."));
+
+          const double alpha = residual_products[block] / curvatures[block];
+          solution.block(block).add(alpha, direction.block(block));
+          residual.block(block).add(-alpha, matrix_direction.block(block));
+          iteration[block]++;
+        }
+
+      preconditioner.vmult(preconditioned_residual, residual);
+      const std::vector<double> old_residual_products = residual_products;
+      check(
+        block_products({{&residual, &residual}, {&residual, &preconditioned_residual}}));
+
+      for (unsigned int block = 0; block < n_blocks; ++block)
+        {
+          if (active[block])
+            {
+              const double beta =
+                residual_products[block] / old_residual_products[block];
+              direction.block(block).sadd(beta,
+                                          1.0,
+                                          preconditioned_residual.block(block));
+            }
+        }
+    }
+
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      AssertThrow(solver_controls[block]->last_check() == dealii::SolverControl::success,
+                  dealii::SolverControl::NoConvergence(
+                    solver_controls[block]->last_step(),
+                    solver_controls[block]->last_value()));
+    }
+}
+
+template <typename BlockVectorType>
+inline std::vector<double>
+batchedCG<BlockVectorType>::block_products(
+  const std::vector<std::pair<const BlockVectorType *, const BlockVectorType *>> &pairs)
+  const
+{
+  // The local products are ordered by block and then by pair
+  const unsigned int  n_blocks = active.size();
+  std::vector<double> products(n_blocks * pairs.size(), 0.0);
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      if (!active[block])
+        {
+          continue;
+        }
+      for (unsigned int pair = 0; pair < pairs.size(); ++pair)
+        {
+          const auto &first  = pairs[pair].first->block(block);
+          const auto &second = pairs[pair].second->block(block);
+          double      sum    = 0.0;
+          for (unsigned int i = 0; i < first.locally_owned_size(); ++i)
+            {
+              sum += first.local_element(i) * second.local_element(i);
+            }
+          products[(block * pairs.size()) + pair] = sum;
+        }
+    }
+
+  dealii::Utilities::MPI::sum(
+    products,
+    pairs.front().first->block(0).get_partitioner()->get_mpi_communicator(),
+    products);
+
+  return products;
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -0,0 +1,626 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef block_gmg_preconditioner_h
+#define block_gmg_preconditioner_h
+
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+#include <deal.II/multigrid/multigrid.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/dof_handler.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/multigrid_hierarchy.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attributes.h>
+#include <prismspf/solvers/cell_patch_inverse.h>
+#include <prismspf/solvers/mg_diagonal_block_operator.h>
+#include <prismspf/solvers/mg_level_operator.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Block-diagonal geometric multigrid preconditioner for a set of co-nonlinear
+ * fields.
+ *
+ * Each diagonal block of the Jacobian is preconditioned with a V-cycle on the multigrid
+ * hierarchy that is shared by the fields of the set, while the coupling between the
+ * fields is left to the outer Krylov solver. The level operators apply the coupled LHS
+ * with the changes of the other fields set to zero, so each application of a block costs
+ * as much as the coupled operator.
+ *
+ * The fields of the set must share their hierarchy, which means that they have the same
+ * finite element and the same Dirichlet boundaries. The other fields in the LHS must
+ * have the same finite element too, so that they can be transferred with the same
+ * operators.
+ */
+template <int dim, int degree>
+class blockGMGPreconditioner
+{
+public:
+  using LevelMatrixType = mgLevelOperator<dim, float>;
+  using VectorType      = dealii::LinearAlgebra::distributed::Vector<double>;
+  using BlockVectorType = dealii::LinearAlgebra::distributed::BlockVector<double>;
+  using MGVectorType    = dealii::LinearAlgebra::distributed::Vector<float>;
+
+  /**
+   * \brief Chebyshev smoother, preconditioned by the given type on each level.
+   */
+  template <typename LevelPreconditionerType>
+  using SmootherType =
+    dealii::PreconditionChebyshev<LevelMatrixType, MGVectorType, LevelPreconditionerType>;
+
+  /**
+   * \brief Constructor.
+   */
+  blockGMGPreconditioner(const userInputParameters<dim> &_user_inputs,
+                         const dofHandler<dim>          &_dof_handler,
+                         mgHierarchyHandler<dim>        &_mg_hierarchy_handler);
+
+  /**
+   * \brief Build the level operators of each block. The fields in the set are given in
+   * the order of their blocks.
+   */
+  void
+  init(const std::map<unsigned int, variableAttributes> &subset_attributes,
+       const std::vector<unsigned int>                  &_field_indices,
+       const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                                unsigned int,
+                                pairHash> &_newton_update_global_to_local_solution);
+
+  /**
+   * \brief Release the multigrid objects, so that the shared hierarchy may be rebuilt.
+   */
+  void
+  clear();
+
+  /**
+   * \brief Transfer the current source of the newton update to the levels and build the
+   * smoothers and the V-cycle of each block.
+   */
+  void
+  setup(const std::vector<VectorType *> &newton_update_src);
+
+  /**
+   * \brief Apply the V-cycle of each block.
+   */
+  void
+  vmult(BlockVectorType &dst, const BlockVectorType &src) const;
+
+private:
+  /**
+   * \brief Multigrid objects of a single block. The members are destroyed in the reverse
+   * order of their declaration, so each object outlives the ones that subscribe to it.
+   */
+  struct blockMultigrid
+  {
+    /**
+     * \brief Operator of the block for each multigrid level.
+     */
+    std::unique_ptr<dealii::MGLevelObject<LevelMatrixType>> mg_operators;
+
+    /**
+     * \brief Multigrid object for storing all operators.
+     */
+    std::unique_ptr<dealii::mg::Matrix<MGVectorType>> mg_matrix;
+
+    /**
+     * \brief Chebyshev smoother for each multigrid level.
+     */
+    std::unique_ptr<dealii::MGSmootherBase<MGVectorType>> mg_smoother;
+
+    /**
+     * \brief Solver control for the iterative coarse grid solver.
+     */
+    std::unique_ptr<dealii::ReductionControl> coarse_solver_control;
+
+    /**
+     * \brief CG solver for the iterative coarse grid solver.
+     */
+    std::unique_ptr<dealii::SolverCG<MGVectorType>> coarse_cg;
+
+    /**
+     * \brief Coarse grid solver.
+     */
+    std::unique_ptr<dealii::MGCoarseGridBase<MGVectorType>> mg_coarse;
+
+    /**
+     * \brief Multigrid object.
+     */
+    std::unique_ptr<dealii::Multigrid<MGVectorType>> mg;
+
+    /**
+     * \brief Multigrid preconditioner.
+     */
+    std::unique_ptr<
+      dealii::PreconditionMG<dim,
+                             MGVectorType,
+                             dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>>
+      preconditioner;
+  };
+
+  /**
+   * \brief Create the operators of every block on a multigrid level with the given
+   * polynomial degree. This recurses down from the degree of the fields, so only the
+   * degrees that we may need are instantiated.
+   */
+  template <int level_degree = degree>
+  void
+  create_level_operators(
+    const std::map<unsigned int, variableAttributes> &subset_attributes,
+    const unsigned int                               &level,
+    const unsigned int                               &fe_degree);
+
+  /**
+   * \brief Build the Chebyshev smoothers of a block with the given preconditioner on
+   * each level, and its coarse grid solver.
+   */
+  template <typename LevelPreconditionerType>
+  void
+  setup_smoother(blockMultigrid     &block_multigrid,
+                 const unsigned int &block,
+                 const dealii::MGLevelObject<std::shared_ptr<LevelPreconditionerType>>
+                   &level_preconditioners);
+
+  /**
+   * \brief User-inputs.
+   */
+  const userInputParameters<dim> &user_inputs;
+
+  /**
+   * \brief DoF handler.
+   */
+  const dofHandler<dim> &dof_handler;
+
+  /**
+   * \brief Handler of the multigrid hierarchies that are shared between fields.
+   */
+  mgHierarchyHandler<dim> &mg_hierarchy_handler;
+
+  /**
+   * \brief Global indices of the fields in the set. The position in this vector is the
+   * block of the field.
+   */
+  std::vector<unsigned int> field_indices;
+
+  /**
+   * \brief Mapping from global solution vectors to the local ones for the newton update.
+   * The change terms map to blocks of the newton update.
+   */
+  std::unordered_map<std::pair<unsigned int, dependencyType>, unsigned int, pairHash>
+    newton_update_global_to_local_solution;
+
+  /**
+   * \brief Multigrid hierarchy of the set.
+   */
+  std::shared_ptr<const mgHierarchy<dim>> hierarchy;
+
+  /**
+   * \brief Minimum multigrid level
+   */
+  unsigned int min_level = 0;
+
+  /**
+   * \brief Maximum multigrid level
+   */
+  unsigned int max_level = 0;
+
+  /**
+   * \brief Mapping of the level matrix-free objects.
+   */
+  const dealii::MappingQ1<dim> mapping;
+
+  /**
+   * \brief Matrix-free object of each level. These have a DoF handler for every field,
+   * since the operators evaluate the fields by their global index, which all point to
+   * the DoF handler of the hierarchy.
+   */
+  std::unique_ptr<dealii::MGLevelObject<matrixfreeHandler<dim, float>>>
+    mg_matrix_free_handler;
+
+  /**
+   * \brief Multilevel copies of the fields that are necessary for the source of the
+   * newton update. These are ordered by their local index.
+   */
+  std::vector<dealii::MGLevelObject<MGVectorType>> mg_src_vectors;
+
+  /**
+   * \brief Subset of fields that are necessary for the source of the newton update for
+   * each multigrid level. These point to the vectors in `mg_src_vectors`.
+   */
+  dealii::MGLevelObject<std::vector<MGVectorType *>> mg_newton_update_src;
+
+  /**
+   * \brief Multigrid objects of each block.
+   */
+  std::vector<std::unique_ptr<blockMultigrid>> block_multigrids;
+};
+
+template <int dim, int degree>
+blockGMGPreconditioner<dim, degree>::blockGMGPreconditioner(
+  const userInputParameters<dim> &_user_inputs,
+  const dofHandler<dim>          &_dof_handler,
+  mgHierarchyHandler<dim>        &_mg_hierarchy_handler)
+  : user_inputs(_user_inputs)
+  , dof_handler(_dof_handler)
+  , mg_hierarchy_handler(_mg_hierarchy_handler)
+{}
+
+template <int dim, int degree>
+inline void
+blockGMGPreconditioner<dim, degree>::init(
+  const std::map<unsigned int, variableAttributes> &subset_attributes,
+  const std::vector<unsigned int>                  &_field_indices,
+  const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                           unsigned int,
+                           pairHash> &_newton_update_global_to_local_solution)
+{
+  field_indices                          = _field_indices;
+  newton_update_global_to_local_solution = _newton_update_global_to_local_solution;
+
+  // Grab the hierarchy, which is only built by the first field that requests it
+  hierarchy = mg_hierarchy_handler.get_hierarchy(field_indices.front());
+  min_level = hierarchy->get_min_level();
+  max_level = hierarchy->get_max_level();
+
+  const auto &fe = dof_handler.const_dof_handlers.at(field_indices.front())->get_fe();
+  for (const auto &index : field_indices)
+    {
+      AssertThrow(mg_hierarchy_handler.get_hierarchy(index) == hierarchy,
+                  FeatureNotImplemented(
+                    "GMG for co-nonlinear fields with different finite elements or "
+                    "Dirichlet boundaries"));
+    }
+  for (const auto &[pair, local_index] : newton_update_global_to_local_solution)
+    {
+      AssertThrow(dof_handler.const_dof_handlers.at(pair.first)->get_fe() == fe,
+                  FeatureNotImplemented(
+                    "GMG for co-nonlinear fields that depend on fields with a different "
+                    "finite element"));
+    }
+
+  // Create the matrix-free object of each level
+  const unsigned int n_fields = dof_handler.const_dof_handlers.size();
+  mg_matrix_free_handler =
+    std::make_unique<dealii::MGLevelObject<matrixfreeHandler<dim, float>>>(min_level,
+                                                                           max_level,
+                                                                           user_inputs);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      const std::vector<const dealii::DoFHandler<dim> *> dof_handlers(
+        n_fields,
+        &hierarchy->get_dof_handler(level));
+      const std::vector<const dealii::AffineConstraints<float> *> constraints(
+        n_fields,
+        &hierarchy->get_constraint(level));
+      (*mg_matrix_free_handler)[level].reinit(
+        mapping,
+        dof_handlers,
+        constraints,
+        dealii::QGaussLobatto<1>(hierarchy->get_level_degree(level) + 1));
+    }
+
+  // Create the operators of each block
+  block_multigrids.clear();
+  for (unsigned int block = 0; block < field_indices.size(); ++block)
+    {
+      block_multigrids.push_back(std::make_unique<blockMultigrid>());
+      block_multigrids.back()->mg_operators =
+        std::make_unique<dealii::MGLevelObject<LevelMatrixType>>(min_level, max_level);
+    }
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      create_level_operators(subset_attributes,
+                             level,
+                             hierarchy->get_level_degree(level));
+    }
+
+  // Setup the src solutions of each level, which are shared by the blocks. The change
+  // terms are given by the src vector of the level operators, so they are skipped.
+  unsigned int n_src = 0;
+  for (const auto &[pair, local_index] : newton_update_global_to_local_solution)
+    {
+      if (pair.second != dependencyType::CHANGE)
+        {
+          n_src++;
+        }
+    }
+  mg_src_vectors.clear();
+  mg_src_vectors.resize(n_src);
+  for (auto &mg_src_vector : mg_src_vectors)
+    {
+      mg_src_vector.resize(min_level, max_level);
+    }
+  mg_newton_update_src.resize(min_level, max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      const auto matrix_free = (*mg_matrix_free_handler)[level].get_matrix_free();
+
+      mg_newton_update_src[level].resize(n_src);
+      for (const auto &[pair, local_index] : newton_update_global_to_local_solution)
+        {
+          if (pair.second == dependencyType::CHANGE)
+            {
+              continue;
+            }
+          mg_newton_update_src[level][local_index] = &mg_src_vectors[local_index][level];
+          matrix_free->initialize_dof_vector(*mg_newton_update_src[level][local_index],
+                                             pair.first);
+        }
+
+      for (auto &block_multigrid : block_multigrids)
+        {
+          auto &level_operator = (*block_multigrid->mg_operators)[level];
+          level_operator.initialize(matrix_free);
+          level_operator.add_global_to_local_mapping(
+            newton_update_global_to_local_solution);
+          level_operator.add_src_solution_subset(mg_newton_update_src[level]);
+        }
+    }
+  for (auto &block_multigrid : block_multigrids)
+    {
+      block_multigrid->mg_matrix =
+        std::make_unique<dealii::mg::Matrix<MGVectorType>>(
+          *block_multigrid->mg_operators);
+    }
+}
+
+template <int dim, int degree>
+inline void
+blockGMGPreconditioner<dim, degree>::clear()
+{
+  // Tear down the hierarchy from the top, so that no object outlives the ones it
+  // subscribes to. The shared hierarchy of the old mesh is destroyed once every field
+  // has released it.
+  block_multigrids.clear();
+  mg_newton_update_src.resize(0, 0);
+  mg_src_vectors.clear();
+  mg_matrix_free_handler.reset();
+  hierarchy.reset();
+}
+
+template <int dim, int degree>
+inline void
+blockGMGPreconditioner<dim, degree>::setup(
+  const std::vector<VectorType *> &newton_update_src)
+{
+  Assert(hierarchy, dealii::ExcNotInitialized());
+
+  // Interpolate the newton update src vectors to each multigrid level. The Jacobian
+  // changes every newton iteration, so there is nothing to reuse.
+  for (const auto &[pair, local_index] : newton_update_global_to_local_solution)
+    {
+      if (pair.second == dependencyType::CHANGE)
+        {
+          continue;
+        }
+      hierarchy->get_transfer().interpolate_to_mg(
+        *dof_handler.const_dof_handlers.at(pair.first),
+        mg_src_vectors[local_index],
+        *newton_update_src[local_index]);
+    }
+
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_indices.front());
+
+  for (unsigned int block = 0; block < field_indices.size(); ++block)
+    {
+      auto &block_multigrid = *block_multigrids[block];
+
+      // The preconditioner holds references to the multigrid object, which in turn holds
+      // references to the smoothers, so we have to tear them down in that order.
+      block_multigrid.preconditioner.reset();
+      block_multigrid.mg.reset();
+      block_multigrid.mg_coarse.reset();
+      block_multigrid.coarse_cg.reset();
+      block_multigrid.coarse_solver_control.reset();
+      block_multigrid.mg_smoother.reset();
+
+      // Create the preconditioner of the smoother for each level, which is built from
+      // the diagonal of the block
+      switch (parameters.smoother_type)
+        {
+          case smootherType::JACOBI_SMOOTHER:
+            {
+              dealii::MGLevelObject<
+                std::shared_ptr<dealii::DiagonalMatrix<MGVectorType>>>
+                level_preconditioners(min_level, max_level);
+              for (unsigned int level = min_level; level <= max_level; ++level)
+                {
+                  (*block_multigrid.mg_operators)[level].compute_diagonal(
+                    field_indices[block]);
+                  level_preconditioners[level] =
+                    (*block_multigrid.mg_operators)[level].get_matrix_diagonal_inverse();
+                }
+              setup_smoother(block_multigrid, block, level_preconditioners);
+              break;
+            }
+          case smootherType::CELL_PATCH_SMOOTHER:
+            {
+              dealii::MGLevelObject<std::shared_ptr<cellPatchInverse<dim, float>>>
+                level_preconditioners(min_level, max_level);
+              for (unsigned int level = min_level; level <= max_level; ++level)
+                {
+                  auto &level_operator = (*block_multigrid.mg_operators)[level];
+                  level_operator.compute_diagonal(field_indices[block]);
+                  level_preconditioners[level] =
+                    std::make_shared<cellPatchInverse<dim, float>>();
+                  level_preconditioners[level]->initialize(
+                    level_operator.get_matrix_free(),
+                    level_operator.get_matrix_diagonal_inverse()->get_vector(),
+                    field_indices[block]);
+                }
+              setup_smoother(block_multigrid, block, level_preconditioners);
+              break;
+            }
+          default:
+            AssertThrow(false, UnreachableCode());
+        }
+
+      // Create multigrid object
+      block_multigrid.mg = std::make_unique<dealii::Multigrid<MGVectorType>>(
+        *block_multigrid.mg_matrix,
+        *block_multigrid.mg_coarse,
+        hierarchy->get_transfer(),
+        *block_multigrid.mg_smoother,
+        *block_multigrid.mg_smoother,
+        min_level,
+        max_level,
+        dealii::Multigrid<MGVectorType>::Cycle::v_cycle);
+
+      // Create the preconditioner
+      block_multigrid.preconditioner = std::make_unique<
+        dealii::PreconditionMG<dim,
+                               MGVectorType,
+                               dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>>(
+        *dof_handler.const_dof_handlers.at(field_indices[block]),
+        *block_multigrid.mg,
+        hierarchy->get_transfer());
+    }
+}
+
+template <int dim, int degree>
+inline void
+blockGMGPreconditioner<dim, degree>::vmult(BlockVectorType       &dst,
+                                           const BlockVectorType &src) const
+{
+  for (unsigned int block = 0; block < field_indices.size(); ++block)
+    {
+      Assert(block_multigrids[block]->preconditioner, dealii::ExcNotInitialized());
+      block_multigrids[block]->preconditioner->vmult(dst.block(block), src.block(block));
+    }
+}
+
+template <int dim, int degree>
+template <int level_degree>
+inline void
+blockGMGPreconditioner<dim, degree>::create_level_operators(
+  const std::map<unsigned int, variableAttributes> &subset_attributes,
+  const unsigned int                               &level,
+  const unsigned int                               &fe_degree)
+{
+  if (fe_degree == level_degree)
+    {
+      for (unsigned int block = 0; block < field_indices.size(); ++block)
+        {
+          (*block_multigrids[block]->mg_operators)[level].reinit(
+            std::make_unique<mgDiagonalBlockOperator<dim, level_degree, float>>(
+              user_inputs,
+              subset_attributes,
+              field_indices,
+              block));
+        }
+      return;
+    }
+
+  if constexpr (level_degree > 1)
+    {
+      create_level_operators<level_degree - 1>(subset_attributes, level, fe_degree);
+    }
+  else
+    {
+      AssertThrow(false, UnreachableCode());
+    }
+}
+
+template <int dim, int degree>
+template <typename LevelPreconditionerType>
+inline void
+blockGMGPreconditioner<dim, degree>::setup_smoother(
+  blockMultigrid     &block_multigrid,
+  const unsigned int &block,
+  const dealii::MGLevelObject<std::shared_ptr<LevelPreconditionerType>>
+    &level_preconditioners)
+{
+  using LevelSmootherType = SmootherType<LevelPreconditionerType>;
+
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_indices.front());
+  auto &mg_operators = *block_multigrid.mg_operators;
+
+  // Create smoother for each level
+  dealii::MGLevelObject<typename LevelSmootherType::AdditionalData> smoother_data(
+    min_level,
+    max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      smoother_data[level].smoothing_range     = parameters.smoothing_range;
+      smoother_data[level].degree              = parameters.smoother_degree;
+      smoother_data[level].eig_cg_n_iterations = parameters.eig_cg_n_iterations;
+      smoother_data[level].preconditioner      = level_preconditioners[level];
+      smoother_data[level].constraints.copy_from(hierarchy->get_constraint(level));
+    }
+  auto smoother = std::make_unique<
+    dealii::MGSmootherPrecondition<LevelMatrixType, LevelSmootherType, MGVectorType>>();
+  smoother->initialize(mg_operators, smoother_data);
+
+  // The Chebyshev smoothers estimate the eigenvalues lazily on their first application.
+  // Do it here instead, so that it counts towards the setup and not the solve.
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      MGVectorType temp;
+      mg_operators[level].initialize_dof_vector(temp, field_indices[block]);
+      smoother->smoothers[level].estimate_eigenvalues(temp);
+    }
+
+  // Create the coarse grid solver. The level operators are matrix-free, so the
+  // assembled coarse grid solvers are rejected for co-nonlinear fields when the inputs
+  // are validated.
+  switch (parameters.coarse_solver)
+    {
+      case coarseSolverType::COARSE_SMOOTHER:
+        {
+          auto coarse_smoother =
+            std::make_unique<dealii::MGCoarseGridApplySmoother<MGVectorType>>();
+          coarse_smoother->initialize(*smoother);
+          block_multigrid.mg_coarse = std::move(coarse_smoother);
+          break;
+        }
+      case coarseSolverType::COARSE_CG:
+        {
+          // Precondition the coarse CG with the Chebyshev smoother of that level
+          block_multigrid.coarse_solver_control =
+            std::make_unique<dealii::ReductionControl>(parameters.coarse_max_iterations,
+                                                       std::numeric_limits<double>::min(),
+                                                       parameters.coarse_tolerance);
+          block_multigrid.coarse_cg = std::make_unique<dealii::SolverCG<MGVectorType>>(
+            *block_multigrid.coarse_solver_control);
+          block_multigrid.mg_coarse = std::make_unique<
+            dealii::MGCoarseGridIterativeSolver<MGVectorType,
+                                                dealii::SolverCG<MGVectorType>,
+                                                LevelMatrixType,
+                                                LevelSmootherType>>(
+            *block_multigrid.coarse_cg,
+            mg_operators[min_level],
+            smoother->smoothers[min_level]);
+          break;
+        }
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+
+  block_multigrid.mg_smoother = std::move(smoother);
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
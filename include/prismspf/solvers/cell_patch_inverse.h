@@ -0,0 +1,412 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef cell_patch_inverse_h
+#define cell_patch_inverse_h
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Additive Schwarz preconditioner with one block per cell, where each block is
+ * inverted with the fast diagonalization method.
+ *
+ * The block of a cell approximates the rows and columns of the assembled operator that
+ * belong to the DoFs of the cell, including the contributions of the neighboring cells
+ * to the DoFs on the faces. On Cartesian meshes, the block of a Laplace-like operator
+ * `a (grad u, grad v) + b (u, v)` is a sum of Kronecker products of 1D mass and
+ * stiffness matrices, so it is inverted with the eigenvectors of the 1D generalized
+ * eigenproblems at O(p^(d+1)) cost, instead of O(p^(3d)) for a dense inverse. The
+ * coefficients a and b of each cell are fitted to the diagonal of the actual operator,
+ * so variable coefficients are captured cell by cell.
+ *
+ * The blocks overlap at the DoFs shared between cells, so the sum of the cell
+ * contributions is scaled symmetrically by the inverse square root of the multiplicity
+ * of each DoF. This keeps the preconditioner symmetric positive definite, so it can be
+ * used with CG and as the preconditioner of the Chebyshev smoother.
+ *
+ * The DoFs on the domain boundary only get the contribution of their cell, so the block
+ * of a single cell is exact for natural boundary conditions. Without a mass term, the
+ * block of a cell that has no neighbors in a direction would be singular, so the cell is
+ * mirrored at its faces in that direction instead. The constrained DoFs are left to the
+ * caller.
+ */
+template <int dim, typename number>
+class cellPatchInverse
+{
+public:
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<number>;
+  using size_type  = dealii::VectorizedArray<number>;
+
+  /**
+   * \brief Build the cell blocks for the DoFs of the given index, given the inverse of
+   * the diagonal of the operator.
+   */
+  void
+  initialize(std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> _data,
+             const VectorType &inverse_diagonal,
+             const unsigned int &_dof_index);
+
+  /**
+   * \brief Apply the preconditioner.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+private:
+  using EvaluationType  = dealii::FEEvaluation<dim, -1, 0, 1, number>;
+  using CellInverseType = dealii::TensorProductMatrixSymmetricSum<dim, size_type>;
+
+  /**
+   * \brief Apply the inverses of the blocks of a range of cells.
+   */
+  void
+  local_apply(const dealii::MatrixFree<dim, number, size_type> &_data,
+              VectorType                                       &dst,
+              const VectorType                                 &src,
+              const std::pair<unsigned int, unsigned int>      &cell_range) const;
+
+  /**
+   * \brief Compute the symmetric scaling of each DoF, which is the inverse square root
+   * of the number of cells that share it.
+   */
+  void
+  compute_weights();
+
+  /**
+   * \brief Matrix-free object.
+   */
+  std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data;
+
+  /**
+   * \brief DoF index of the field in the matrix-free object.
+   */
+  unsigned int dof_index = 0;
+
+  /**
+   * \brief Number of components of the field. Each component uses the same blocks.
+   */
+  unsigned int n_components = 1;
+
+  /**
+   * \brief Inverse of the block of each cell batch.
+   */
+  std::vector<CellInverseType> cell_inverses;
+
+  /**
+   * \brief Symmetric scaling of each DoF.
+   */
+  VectorType weights;
+
+  /**
+   * \brief Scaled copy of the source vector.
+   */
+  mutable VectorType scaled_src;
+};
+
+template <int dim, typename number>
+inline void
+cellPatchInverse<dim, number>::initialize(
+  std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> _data,
+  const VectorType                                                 &inverse_diagonal,
+  const unsigned int                                               &_dof_index)
+{
+  data         = _data;
+  dof_index    = _dof_index;
+  n_components = data->get_dof_handler(dof_index).get_fe().n_components();
+
+  // Reference 1D mass and stiffness matrices on the unit interval, in lexicographic
+  // order, with the quadrature of the operator
+  const auto        &shape_data = data->get_shape_info(dof_index).data.front();
+  const unsigned int n_dofs_1d  = shape_data.fe_degree + 1;
+  const unsigned int n_q_1d     = shape_data.n_q_points_1d;
+  dealii::Table<2, double> reference_mass(n_dofs_1d, n_dofs_1d);
+  dealii::Table<2, double> reference_stiffness(n_dofs_1d, n_dofs_1d);
+  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+    {
+      for (unsigned int j = 0; j < n_dofs_1d; ++j)
+        {
+          for (unsigned int q = 0; q < n_q_1d; ++q)
+            {
+              const double weight = shape_data.quadrature.weight(q);
+              reference_mass(i, j) += weight * shape_data.shape_values[(i * n_q_1d) + q] *
+                                      shape_data.shape_values[(j * n_q_1d) + q];
+              reference_stiffness(i, j) += weight *
+                                           shape_data.shape_gradients[(i * n_q_1d) + q] *
+                                           shape_data.shape_gradients[(j * n_q_1d) + q];
+            }
+        }
+    }
+  const unsigned int last = n_dofs_1d - 1;
+
+  // DoFs with constraints are left out of the fit of the coefficients
+  VectorType constrained;
+  data->initialize_dof_vector(constrained, dof_index);
+  for (const unsigned int index : data->get_constrained_dofs(dof_index))
+    {
+      constrained.local_element(index) = 1.0;
+    }
+  constrained.update_ghost_values();
+  inverse_diagonal.update_ghost_values();
+
+  EvaluationType fe_eval(*data, dof_index);
+  EvaluationType fe_eval_constrained(*data, dof_index);
+  const unsigned int dofs_per_cell = fe_eval.dofs_per_cell;
+
+  cell_inverses.resize(data->n_cell_batches());
+  for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+    {
+      fe_eval.reinit(cell);
+      fe_eval.read_dof_values_plain(inverse_diagonal);
+      fe_eval_constrained.reinit(cell);
+      fe_eval_constrained.read_dof_values_plain(constrained);
+
+      std::array<dealii::Table<2, size_type>, dim> mass;
+      std::array<dealii::Table<2, size_type>, dim> stiffness;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          mass[d].reinit(n_dofs_1d, n_dofs_1d);
+          stiffness[d].reinit(n_dofs_1d, n_dofs_1d);
+        }
+
+      for (unsigned int lane = 0; lane < size_type::size(); ++lane)
+        {
+          // Size of the cell and its neighbors in each direction, where a missing
+          // neighbor has zero size. The unused lanes of the last batch get a unit cell.
+          std::array<std::array<double, 3>, dim> extent;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              extent[d] = {1.0, 1.0, 1.0};
+            }
+          const bool active_lane = lane < data->n_active_entries_per_cell_batch(cell);
+          if (active_lane)
+            {
+              const auto cell_iterator = data->get_cell_iterator(cell, lane, dof_index);
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  const double h = cell_iterator->extent_in_direction(d);
+                  extent[d]      = {0.0, h, 0.0};
+                  for (unsigned int side = 0; side < 2; ++side)
+                    {
+                      const unsigned int face = (2 * d) + side;
+                      if (cell_iterator->at_boundary(face) &&
+                          !cell_iterator->has_periodic_neighbor(face))
+                        {
+                          continue;
+                        }
+                      const auto neighbor =
+                        cell_iterator->neighbor_or_periodic_neighbor(face);
+                      extent[d][2 * side] = neighbor->extent_in_direction(d) /
+                                            (neighbor->has_children() ? 2.0 : 1.0);
+                    }
+                }
+            }
+
+          // 1D blocks of the assembled matrices, where the DoFs on the faces get the
+          // contribution of the neighboring cell
+          std::array<dealii::Table<2, double>, dim> lane_mass;
+          std::array<dealii::Table<2, double>, dim> lane_stiffness;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const auto &[h_left, h, h_right] = extent[d];
+              lane_mass[d].reinit(n_dofs_1d, n_dofs_1d);
+              lane_stiffness[d].reinit(n_dofs_1d, n_dofs_1d);
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                {
+                  for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                    {
+                      lane_mass[d](i, j)      = h * reference_mass(i, j);
+                      lane_stiffness[d](i, j) = reference_stiffness(i, j) / h;
+                    }
+                }
+              if (h_left > 0.0)
+                {
+                  lane_mass[d](0, 0) += h_left * reference_mass(last, last);
+                  lane_stiffness[d](0, 0) += reference_stiffness(last, last) / h_left;
+                }
+              if (h_right > 0.0)
+                {
+                  lane_mass[d](last, last) += h_right * reference_mass(0, 0);
+                  lane_stiffness[d](last, last) += reference_stiffness(0, 0) / h_right;
+                }
+            }
+
+          // Fit the coefficients of the stiffness and mass terms to the diagonal of the
+          // operator, relative to the size of each entry
+          double sum_kk = 0.0;
+          double sum_km = 0.0;
+          double sum_mm = 0.0;
+          double sum_k  = 0.0;
+          double sum_m  = 0.0;
+          for (unsigned int i = 0; active_lane && i < dofs_per_cell; ++i)
+            {
+              const double inverse = fe_eval.begin_dof_values()[i][lane];
+              if (fe_eval_constrained.begin_dof_values()[i][lane] > 0.0 ||
+                  inverse <= 0.0)
+                {
+                  continue;
+                }
+
+              double mass_diagonal      = 1.0;
+              double stiffness_diagonal = 0.0;
+              for (unsigned int d = 0, stride = 1; d < dim; ++d, stride *= n_dofs_1d)
+                {
+                  const unsigned int i_d = (i / stride) % n_dofs_1d;
+                  double             term = lane_stiffness[d](i_d, i_d);
+                  for (unsigned int e = 0, stride_e = 1; e < dim;
+                       ++e, stride_e *= n_dofs_1d)
+                    {
+                      if (e != d)
+                        {
+                          term *= lane_mass[e]((i / stride_e) % n_dofs_1d,
+                                               (i / stride_e) % n_dofs_1d);
+                        }
+                    }
+                  stiffness_diagonal += term;
+                  mass_diagonal *= lane_mass[d](i_d, i_d);
+                }
+
+              const double k = stiffness_diagonal * inverse;
+              const double m = mass_diagonal * inverse;
+              sum_kk += k * k;
+              sum_km += k * m;
+              sum_mm += m * m;
+              sum_k += k;
+              sum_m += m;
+            }
+
+          double stiffness_coefficient = 1.0;
+          double mass_coefficient      = 0.0;
+          const double determinant     = (sum_kk * sum_mm) - (sum_km * sum_km);
+          if (determinant > 1.0e-12 * sum_kk * sum_mm)
+            {
+              stiffness_coefficient = ((sum_mm * sum_k) - (sum_km * sum_m)) / determinant;
+              mass_coefficient      = ((sum_kk * sum_m) - (sum_km * sum_k)) / determinant;
+            }
+          if (stiffness_coefficient < 0.0 && sum_mm > 0.0)
+            {
+              stiffness_coefficient = 0.0;
+              mass_coefficient      = sum_m / sum_mm;
+            }
+          else if (mass_coefficient < 0.0 || determinant <= 1.0e-12 * sum_kk * sum_mm)
+            {
+              stiffness_coefficient = sum_kk > 0.0 ? sum_k / sum_kk : 1.0;
+              mass_coefficient      = 0.0;
+            }
+
+          // The mass term is split evenly between the directions, so that the block is
+          // the sum of the Kronecker products
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const auto &[h_left, h, h_right] = extent[d];
+              if (mass_coefficient <= 0.0 && h_left == 0.0 && h_right == 0.0)
+                {
+                  lane_stiffness[d](0, 0) += reference_stiffness(last, last) / h;
+                  lane_stiffness[d](last, last) += reference_stiffness(0, 0) / h;
+                }
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                {
+                  for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                    {
+                      mass[d](i, j)[lane] = lane_mass[d](i, j);
+                      stiffness[d](i, j)[lane] =
+                        (stiffness_coefficient * lane_stiffness[d](i, j)) +
+                        (mass_coefficient / dim * lane_mass[d](i, j));
+                    }
+                }
+            }
+        }
+
+      cell_inverses[cell].reinit(mass, stiffness);
+    }
+  inverse_diagonal.zero_out_ghost_values();
+
+  compute_weights();
+  scaled_src.reinit(weights);
+}
+
+template <int dim, typename number>
+inline void
+cellPatchInverse<dim, number>::vmult(VectorType &dst, const VectorType &src) const
+{
+  Assert(data != nullptr, dealii::ExcNotInitialized());
+
+  scaled_src = src;
+  scaled_src.scale(weights);
+  data->cell_loop(&cellPatchInverse::local_apply, this, dst, scaled_src, true);
+  dst.scale(weights);
+}
+
+template <int dim, typename number>
+inline void
+cellPatchInverse<dim, number>::local_apply(
+  const dealii::MatrixFree<dim, number, size_type> &_data,
+  VectorType                                       &dst,
+  const VectorType                                 &src,
+  const std::pair<unsigned int, unsigned int>      &cell_range) const
+{
+  for (unsigned int component = 0; component < n_components; ++component)
+    {
+      EvaluationType fe_eval(_data, dof_index, 0, component);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+        {
+          fe_eval.reinit(cell);
+          fe_eval.read_dof_values(src);
+          cell_inverses[cell].apply_inverse(
+            dealii::make_array_view(fe_eval.begin_dof_values(),
+                                    fe_eval.begin_dof_values() + fe_eval.dofs_per_cell),
+            dealii::make_array_view(fe_eval.begin_dof_values(),
+                                    fe_eval.begin_dof_values() + fe_eval.dofs_per_cell));
+          fe_eval.distribute_local_to_global(dst);
+        }
+    }
+}
+
+template <int dim, typename number>
+inline void
+cellPatchInverse<dim, number>::compute_weights()
+{
+  // Count the cells that share each DoF, for every component like the application of
+  // the blocks
+  data->initialize_dof_vector(weights, dof_index);
+  for (unsigned int component = 0; component < n_components; ++component)
+    {
+      EvaluationType fe_eval(*data, dof_index, 0, component);
+      for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+        {
+          fe_eval.reinit(cell);
+          for (unsigned int i = 0; i < fe_eval.dofs_per_cell; ++i)
+            {
+              fe_eval.begin_dof_values()[i] = 1.0;
+            }
+          fe_eval.distribute_local_to_global(weights);
+        }
+    }
+  weights.compress(dealii::VectorOperation::add);
+
+  for (unsigned int i = 0; i < weights.locally_owned_size(); ++i)
+    {
+      weights.local_element(i) =
+        weights.local_element(i) > 0.0 ? 1.0 / std::sqrt(weights.local_element(i)) : 0.0;
+    }
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -0,0 +1,400 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef deflated_cg_h
+#define deflated_cg_h
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <prismspf/config.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Preconditioned conjugate gradient solver that recycles a small subspace between
+ * solves. The subspace holds approximate eigenvectors of the smallest eigenvalues, which
+ * are deflated from the search directions so that CG doesn't have to resolve these slow
+ * modes again. This pays off for repeated solves with the same or a slowly varying
+ * operator.
+ *
+ * The action of the operator on the subspace is recomputed at the start of every solve,
+ * so the operator may change between solves. During a solve, the search directions are
+ * collected in a window together with the old subspace. Each time the window is full, it
+ * is compressed to the Ritz vectors of its smallest Ritz values (thick restart), so the
+ * window follows the slow modes over the whole solve rather than only its last
+ * iterations. After the solve, the window is compressed once more and becomes the new
+ * subspace.
+ */
+template <typename VectorType>
+class deflatedCG
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  explicit deflatedCG(unsigned int _subspace_size);
+
+  /**
+   * \brief Solve the system Ax=b, starting from the given solution.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(dealii::SolverControl    &solver_control,
+        const MatrixType         &matrix,
+        VectorType               &solution,
+        const VectorType         &rhs,
+        const PreconditionerType &preconditioner);
+
+  /**
+   * \brief Drop the recycled subspace.
+   */
+  void
+  clear();
+
+  /**
+   * \brief Get the dimension of the recycled subspace.
+   */
+  [[nodiscard]] unsigned int
+  get_subspace_dimension() const;
+
+private:
+  /**
+   * \brief Compute the action of the operator on the subspace and the inverse of the
+   * projected operator.
+   */
+  template <typename MatrixType>
+  void
+  compute_coarse_operator(const MatrixType &matrix);
+
+  /**
+   * \brief Return the coefficients E^{-1} B^T v, where E is the projected operator and B
+   * is either the subspace or the action of the operator on it.
+   */
+  [[nodiscard]] dealii::Vector<double>
+  coarse_coefficients(const std::vector<VectorType> &basis,
+                      const VectorType              &vector) const;
+
+  /**
+   * \brief Add the search direction and the action of the operator on it to the window
+   * for the subspace update. The window is compressed once it holds twice the subspace
+   * size.
+   */
+  void
+  store_direction(const VectorType &direction, const VectorType &matrix_direction);
+
+  /**
+   * \brief Replace the window by the Ritz vectors of its smallest Ritz values and the
+   * action of the operator on them.
+   */
+  void
+  compress_directions();
+
+  /**
+   * \brief Maximum dimension of the recycled subspace.
+   */
+  const unsigned int subspace_size;
+
+  /**
+   * \brief Recycled subspace.
+   */
+  std::vector<VectorType> subspace;
+
+  /**
+   * \brief Action of the operator on the recycled subspace.
+   */
+  std::vector<VectorType> matrix_subspace;
+
+  /**
+   * \brief Inverse of the operator projected onto the recycled subspace.
+   */
+  dealii::FullMatrix<double> coarse_inverse;
+
+  /**
+   * \brief Window of approximate slow modes and search directions of the current
+   * solve.
+   */
+  std::vector<VectorType> directions;
+
+  /**
+   * \brief Action of the operator on the window.
+   */
+  std::vector<VectorType> matrix_directions;
+};
+
+template <typename VectorType>
+deflatedCG<VectorType>::deflatedCG(unsigned int _subspace_size)
+  : subspace_size(_subspace_size)
+{
+  Assert(subspace_size > 0,
+         dealii::ExcMessage("The recycled subspace must have at least one vector."));
+}
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+inline void
+deflatedCG<VectorType>::solve(dealii::SolverControl    &solver_control,
+                              const MatrixType         &matrix,
+                              VectorType               &solution,
+                              const VectorType         &rhs,
+                              const PreconditionerType &preconditioner)
+{
+  // Drop the subspace if the vector layout changed, for example after remeshing
+  if (!subspace.empty() &&
+      !subspace.front().get_partitioner()->is_compatible(*solution.get_partitioner()))
+    {
+      clear();
+    }
+
+  compute_coarse_operator(matrix);
+
+  // Start the window from the old subspace, so that its slow modes are refined rather
+  // than found again
+  directions        = subspace;
+  matrix_directions = matrix_subspace;
+
+  VectorType residual;
+  VectorType preconditioned_residual;
+  VectorType direction;
+  VectorType matrix_direction;
+  residual.reinit(solution, true);
+  preconditioned_residual.reinit(solution, true);
+  direction.reinit(solution, true);
+  matrix_direction.reinit(solution, true);
+
+  matrix.vmult(residual, solution);
+  residual.sadd(-1.0, 1.0, rhs);
+
+  // Add the part of the solution that lies in the subspace, so that the residual is
+  // orthogonal to it
+  if (!subspace.empty())
+    {
+      const dealii::Vector<double> coefficients =
+        coarse_coefficients(subspace, residual);
+      for (unsigned int i = 0; i < subspace.size(); ++i)
+        {
+          solution.add(coefficients(i), subspace[i]);
+          residual.add(-coefficients(i), matrix_subspace[i]);
+        }
+    }
+
+  // Deflate the subspace from a search direction
+  const auto deflate = [&](VectorType &vector, const VectorType &source)
+  {
+    if (subspace.empty())
+      {
+        return;
+      }
+    const dealii::Vector<double> coefficients =
+      coarse_coefficients(matrix_subspace, source);
+    for (unsigned int i = 0; i < subspace.size(); ++i)
+      {
+        vector.add(-coefficients(i), subspace[i]);
+      }
+  };
+
+  unsigned int iteration = 0;
+  auto         state     = solver_control.check(iteration, residual.l2_norm());
+  if (state == dealii::SolverControl::iterate)
+    {
+      preconditioner.vmult(preconditioned_residual, residual);
+      direction = preconditioned_residual;
+      deflate(direction, preconditioned_residual);
+      double residual_product = residual * preconditioned_residual;
+
+      while (state == dealii::SolverControl::iterate)
+        {
+          matrix.vmult(matrix_direction, direction);
+          const double curvature = direction * matrix_direction;
+          AssertThrow(curvature > 0.0,
+                      dealii::ExcMessage(
+                        "Deflated CG requires a symmetric positive definite operator."));
+
+          const double alpha = residual_product / curvature;
+          solution.add(alpha, direction);
+          residual.add(-alpha, matrix_direction);
+          store_direction(direction, matrix_direction);
+
+          iteration++;
+          state = solver_control.check(iteration, residual.l2_norm());
+          if (state != dealii::SolverControl::iterate)
+            {
+              break;
+            }
+
+          preconditioner.vmult(preconditioned_residual, residual);
+          const double new_residual_product = residual * preconditioned_residual;
+          const double beta                 = new_residual_product / residual_product;
+          residual_product                  = new_residual_product;
+
+          direction.sadd(beta, 1.0, preconditioned_residual);
+          deflate(direction, preconditioned_residual);
+        }
+    }
+
+  compress_directions();
+  subspace = std::move(directions);
+  directions.clear();
+  matrix_directions.clear();
+
+  AssertThrow(state == dealii::SolverControl::success,
+              dealii::SolverControl::NoConvergence(solver_control.last_step(),
+                                                   solver_control.last_value()));
+}
+
+template <typename VectorType>
+inline void
+deflatedCG<VectorType>::clear()
+{
+  subspace.clear();
+  matrix_subspace.clear();
+  directions.clear();
+  matrix_directions.clear();
+  coarse_inverse.reinit(0, 0);
+}
+
+template <typename VectorType>
+inline unsigned int
+deflatedCG<VectorType>::get_subspace_dimension() const
+{
+  return subspace.size();
+}
+
+template <typename VectorType>
+template <typename MatrixType>
+inline void
+deflatedCG<VectorType>::compute_coarse_operator(const MatrixType &matrix)
+{
+  const auto n_subspace = static_cast<unsigned int>(subspace.size());
+
+  matrix_subspace.resize(n_subspace);
+  coarse_inverse.reinit(n_subspace, n_subspace);
+  for (unsigned int j = 0; j < n_subspace; ++j)
+    {
+      matrix_subspace[j].reinit(subspace[j], true);
+      matrix.vmult(matrix_subspace[j], subspace[j]);
+      for (unsigned int i = 0; i < n_subspace; ++i)
+        {
+          coarse_inverse(i, j) = subspace[i] * matrix_subspace[j];
+        }
+    }
+  if (n_subspace > 0)
+    {
+      coarse_inverse.gauss_jordan();
+    }
+}
+
+template <typename VectorType>
+inline dealii::Vector<double>
+deflatedCG<VectorType>::coarse_coefficients(const std::vector<VectorType> &basis,
+                                            const VectorType              &vector) const
+{
+  dealii::Vector<double> projection(basis.size());
+  dealii::Vector<double> coefficients(basis.size());
+  for (unsigned int i = 0; i < basis.size(); ++i)
+    {
+      projection(i) = basis[i] * vector;
+    }
+  coarse_inverse.vmult(coefficients, projection);
+
+  return coefficients;
+}
+
+template <typename VectorType>
+inline void
+deflatedCG<VectorType>::store_direction(const VectorType &direction,
+                                        const VectorType &matrix_direction)
+{
+  directions.push_back(direction);
+  matrix_directions.push_back(matrix_direction);
+  if (directions.size() >= 2 * subspace_size)
+    {
+      compress_directions();
+    }
+}
+
+template <typename VectorType>
+inline void
+deflatedCG<VectorType>::compress_directions()
+{
+  // Orthonormalize the window with modified Gram-Schmidt, applying the same operations
+  // to the action of the operator on it
+  std::vector<VectorType> basis;
+  std::vector<VectorType> matrix_basis;
+  for (unsigned int j = 0; j < directions.size(); ++j)
+    {
+      VectorType  &vector        = directions[j];
+      VectorType  &matrix_vector = matrix_directions[j];
+      const double original_norm = vector.l2_norm();
+      for (unsigned int i = 0; i < basis.size(); ++i)
+        {
+          const double projection = basis[i] * vector;
+          vector.add(-projection, basis[i]);
+          matrix_vector.add(-projection, matrix_basis[i]);
+        }
+      const double norm = vector.l2_norm();
+      if (norm > 1.0e-8 * original_norm && norm > 0.0)
+        {
+          vector /= norm;
+          matrix_vector /= norm;
+          basis.push_back(std::move(vector));
+          matrix_basis.push_back(std::move(matrix_vector));
+        }
+    }
+  directions.clear();
+  matrix_directions.clear();
+  if (basis.empty())
+    {
+      return;
+    }
+
+  // Rayleigh-Ritz on the orthonormal basis
+  const auto                       n_basis = static_cast<unsigned int>(basis.size());
+  dealii::LAPACKFullMatrix<double> projected_matrix(n_basis, n_basis);
+  for (unsigned int i = 0; i < n_basis; ++i)
+    {
+      for (unsigned int j = i; j < n_basis; ++j)
+        {
+          const double value =
+            0.5 * (basis[i] * matrix_basis[j] + basis[j] * matrix_basis[i]);
+          projected_matrix(i, j) = value;
+          projected_matrix(j, i) = value;
+        }
+    }
+  dealii::Vector<double>     ritz_values;
+  dealii::FullMatrix<double> ritz_coefficients;
+  projected_matrix.compute_eigenvalues_symmetric(-std::numeric_limits<double>::max(),
+                                                 std::numeric_limits<double>::max(),
+                                                 0.0,
+                                                 ritz_values,
+                                                 ritz_coefficients);
+
+  // The Ritz values are in ascending order, so the first ones approximate the slowest
+  // modes. The action of the operator on the Ritz vectors follows from the same linear
+  // combination, so no operator applications are needed.
+  const unsigned int n_ritz = std::min<unsigned int>(subspace_size, ritz_values.size());
+  directions.resize(n_ritz);
+  matrix_directions.resize(n_ritz);
+  for (unsigned int j = 0; j < n_ritz; ++j)
+    {
+      directions[j].reinit(basis.front());
+      matrix_directions[j].reinit(basis.front());
+      for (unsigned int i = 0; i < n_basis; ++i)
+        {
+          directions[j].add(ritz_coefficients(i, j), basis[i]);
+          matrix_directions[j].add(ritz_coefficients(i, j), matrix_basis[i]);
+        }
+    }
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
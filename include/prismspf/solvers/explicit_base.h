@@ -57,6 +57,12 @@ public:
   virtual void
   init() = 0;
 
+  /**
+   * \brief Reinitialize the system after the mesh has changed.
+   */
+  virtual void
+  reinit() = 0;
+
   /**
    * \brief Solve a single update step.
    */
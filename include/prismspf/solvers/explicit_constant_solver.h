@@ -49,6 +49,12 @@ public:
   void
   init() override;
 
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
   /**
    * \brief Solve a single update step.
    */
@@ -89,6 +95,13 @@ explicitConstantSolver<dim, degree>::init()
   this->set_initial_condition();
 }
 
+template <int dim, int degree>
+inline void
+explicitConstantSolver<dim, degree>::reinit()
+{
+  // The constant fields are transferred with the other solutions and have no operator
+}
+
 template <int dim, int degree>
 inline void
 explicitConstantSolver<dim, degree>::solve()
@@ -53,6 +53,12 @@ public:
   void
   init() override;
 
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
   /**
    * \brief Solve a single update step.
    */
@@ -147,6 +153,18 @@ explicitPostprocessSolver<dim, degree>::init()
   this->system_matrix->add_global_to_local_mapping(global_to_local_solution);
 }
 
+template <int dim, int degree>
+inline void
+explicitPostprocessSolver<dim, degree>::reinit()
+{
+  if (this->subset_attributes.empty())
+    {
+      return;
+    }
+
+  this->system_matrix->initialize(this->matrix_free_handler.get_matrix_free());
+}
+
 template <int dim, int degree>
 inline void
 explicitPostprocessSolver<dim, degree>::solve()
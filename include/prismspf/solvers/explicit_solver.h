@@ -4,6 +4,8 @@
 #ifndef explicit_solver_h
 #define explicit_solver_h
 
+#include <deal.II/base/mpi.h>
+
 #include <prismspf/config.h>
 #include <prismspf/core/constraint_handler.h>
 #include <prismspf/core/dof_handler.h>
@@ -14,6 +16,10 @@
 #include <prismspf/solvers/explicit_base.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+
 #ifdef PRISMS_PF_WITH_CALIPER
 #  include <caliper/cali.h>
 #endif
@@ -58,13 +64,44 @@ public:
   void
   init() override;
 
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
   /**
    * \brief Solve a single update step.
    */
   void
   solve() override;
 
+  /**
+   * \brief Request that the relative change of each field, ||u^{n+1} - u^n|| / ||u^n||,
+   * be computed during the next call to solve(). The norms are accumulated while the
+   * update is scaled by the invm, so no extra sweep over the vectors is required.
+   */
+  void
+  request_relative_change();
+
+  /**
+   * \brief Get the relative change of each field from the last solve where it was
+   * requested.
+   */
+  [[nodiscard]] const std::map<unsigned int, double> &
+  get_relative_change() const;
+
 private:
+  /**
+   * \brief Whether to compute the relative change in the next solve.
+   */
+  bool compute_relative_change = false;
+
+  /**
+   * \brief Relative change of each field.
+   */
+  std::map<unsigned int, double> relative_change;
+
   /**
    * \brief Mapping from global solution vectors to the local ones
    */
@@ -164,6 +201,18 @@ explicitSolver<dim, degree>::init()
   this->system_matrix->add_global_to_local_mapping(global_to_local_solution);
 }
 
+template <int dim, int degree>
+inline void
+explicitSolver<dim, degree>::reinit()
+{
+  if (this->subset_attributes.empty())
+    {
+      return;
+    }
+
+  this->system_matrix->initialize(this->matrix_free_handler.get_matrix_free());
+}
+
 template <int dim, int degree>
 inline void
 explicitSolver<dim, degree>::solve()
@@ -184,11 +233,57 @@ explicitSolver<dim, degree>::solve()
   CALI_MARK_BEGIN("Explicit scale solution");
   for (auto [index, vector] : this->solution_handler.new_solution_set)
     {
-      if (this->subset_attributes.find(index) != this->subset_attributes.end())
+      if (this->subset_attributes.find(index) == this->subset_attributes.end())
+        {
+          continue;
+        }
+      if (!compute_relative_change)
         {
           vector->scale(this->invm_handler.get_invm(index));
+          continue;
+        }
+
+      // Scale the update and accumulate ||u^{n+1} - u^n||^2 and ||u^n||^2 in the same
+      // pass.
+      const auto &invm = this->invm_handler.get_invm(index);
+      const auto &old_solution =
+        *this->solution_handler.solution_set.at(std::make_pair(index, NORMAL));
+      double change_norm_sq = 0.0;
+      double old_norm_sq    = 0.0;
+      for (unsigned int i = 0; i < vector->locally_owned_size(); ++i)
+        {
+          const double new_value = vector->local_element(i) * invm.local_element(i);
+          const double difference = new_value - old_solution.local_element(i);
+          vector->local_element(i) = new_value;
+          change_norm_sq += difference * difference;
+          old_norm_sq += old_solution.local_element(i) * old_solution.local_element(i);
         }
+
+      // Remove the contributions from constrained degrees of freedom since those are
+      // overwritten when the constraints are distributed.
+      for (const auto &i :
+           this->matrix_free_handler.get_matrix_free()->get_constrained_dofs(index))
+        {
+          if (i >= vector->locally_owned_size())
+            {
+              continue;
+            }
+          const double difference =
+            vector->local_element(i) - old_solution.local_element(i);
+          change_norm_sq -= difference * difference;
+          old_norm_sq -= old_solution.local_element(i) * old_solution.local_element(i);
+        }
+
+      change_norm_sq = std::max(
+        dealii::Utilities::MPI::sum(change_norm_sq, vector->get_mpi_communicator()),
+        0.0);
+      old_norm_sq =
+        dealii::Utilities::MPI::sum(old_norm_sq, vector->get_mpi_communicator());
+      relative_change[index] = old_norm_sq > 0.0
+                                 ? std::sqrt(change_norm_sq / old_norm_sq)
+                                 : std::sqrt(change_norm_sq);
     }
+  compute_relative_change = false;
   CALI_MARK_END("Explicit scale solution");
 
   // Update the solutions
@@ -209,6 +304,21 @@ explicitSolver<dim, degree>::solve()
   CALI_MARK_END("Explicit apply constraints");
 }
 
+template <int dim, int degree>
+inline void
+explicitSolver<dim, degree>::request_relative_change()
+{
+  compute_relative_change = true;
+  relative_change.clear();
+}
+
+template <int dim, int degree>
+inline const std::map<unsigned int, double> &
+explicitSolver<dim, degree>::get_relative_change() const
+{
+  return relative_change;
+}
+
 PRISMS_PF_END_NAMESPACE
 
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef jacobian_free_operator_h
+#define jacobian_free_operator_h
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/lac/affine_constraints.h>
+
+#include <prismspf/config.h>
+
+#include <cmath>
+#include <limits>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Operator that applies the Jacobian of the residual by finite differences, as in
+ * Jacobian-free Newton-Krylov methods. Each application perturbs the solution in the
+ * direction of the src vector, recomputes the residual, and restores the solution, so
+ * it costs one residual evaluation and doesn't require the user LHS.
+ *
+ * The residual operator must provide compute_residual(dst, solution), where the residual
+ * is the negative of the nonlinear function, as for the RHS of the newton update.
+ */
+template <typename ResidualOperatorType, typename VectorType>
+class jacobianFreeOperator
+{
+public:
+  using number = typename VectorType::value_type;
+
+  /**
+   * \brief Constructor.
+   */
+  jacobianFreeOperator(const ResidualOperatorType              &_residual_operator,
+                       VectorType                              &_solution,
+                       const dealii::AffineConstraints<number> &_constraints);
+
+  /**
+   * \brief Set the state at which the Jacobian is evaluated, given the residual of the
+   * current solution. This must be called whenever the solution changes.
+   */
+  void
+  reinit(const VectorType &_base_residual);
+
+  /**
+   * \brief Matrix-vector multiplication.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+private:
+  /**
+   * \brief Operator for the residual.
+   */
+  const ResidualOperatorType &residual_operator;
+
+  /**
+   * \brief Solution vector that is perturbed. The residual operator must read from it.
+   */
+  VectorType &solution;
+
+  /**
+   * \brief Constraints of the solution.
+   */
+  const dealii::AffineConstraints<number> &constraints;
+
+  /**
+   * \brief Residual of the unperturbed solution.
+   */
+  const VectorType *base_residual = nullptr;
+
+  /**
+   * \brief Copy of the unperturbed solution and its l2-norm.
+   */
+  VectorType base_solution;
+  double     base_solution_norm = 0.0;
+
+  /**
+   * \brief Residual of the perturbed solution.
+   */
+  mutable VectorType perturbed_residual;
+};
+
+template <typename ResidualOperatorType, typename VectorType>
+jacobianFreeOperator<ResidualOperatorType, VectorType>::jacobianFreeOperator(
+  const ResidualOperatorType              &_residual_operator,
+  VectorType                              &_solution,
+  const dealii::AffineConstraints<number> &_constraints)
+  : residual_operator(_residual_operator)
+  , solution(_solution)
+  , constraints(_constraints)
+{}
+
+template <typename ResidualOperatorType, typename VectorType>
+inline void
+jacobianFreeOperator<ResidualOperatorType, VectorType>::reinit(
+  const VectorType &_base_residual)
+{
+  base_residual      = &_base_residual;
+  base_solution      = solution;
+  base_solution_norm = solution.l2_norm();
+  perturbed_residual.reinit(_base_residual);
+}
+
+template <typename ResidualOperatorType, typename VectorType>
+inline void
+jacobianFreeOperator<ResidualOperatorType, VectorType>::vmult(VectorType       &dst,
+                                                              const VectorType &src) const
+{
+  Assert(base_residual != nullptr, dealii::ExcNotInitialized());
+
+  const double src_norm = src.l2_norm();
+  if (src_norm == 0.0)
+    {
+      dst = 0.0;
+      return;
+    }
+
+  // Balance the truncation error of the finite difference against the rounding error of
+  // the residual (Knoll and Keyes)
+  const double step = std::sqrt(std::numeric_limits<number>::epsilon()) *
+                      (1.0 + base_solution_norm) / src_norm;
+
+  solution.add(step, src);
+  constraints.distribute(solution);
+  residual_operator.compute_residual(perturbed_residual, solution);
+
+  // Restore the solution exactly, rather than subtracting the perturbation again
+  solution = base_solution;
+
+  // The residual is the negative of the nonlinear function, so the Jacobian-vector
+  // product is (R(u) - R(u + h v)) / h
+  dst.equ(1.0 / step, *base_residual);
+  dst.add(-1.0 / step, perturbed_residual);
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
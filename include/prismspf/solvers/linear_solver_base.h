@@ -4,22 +4,42 @@
 #ifndef linear_solver_base_h
 #define linear_solver_base_h
 
+#include <deal.II/base/config.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/mapping_q1.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_bicgstab.h>
+#include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector.h>
 
 #include <prismspf/config.h>
 #include <prismspf/core/conditional_ostreams.h>
 #include <prismspf/core/constraint_handler.h>
+#include <prismspf/core/exceptions.h>
 #include <prismspf/core/matrix_free_handler.h>
 #include <prismspf/core/solution_handler.h>
 #include <prismspf/core/triangulation_handler.h>
 #include <prismspf/core/type_enums.h>
 #include <prismspf/core/variable_attributes.h>
+#include <prismspf/solvers/deflated_cg.h>
+#include <prismspf/solvers/jacobian_free_operator.h>
+#include <prismspf/solvers/pipelined_cg.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 PRISMS_PF_BEGIN_NAMESPACE
 
 /**
@@ -28,6 +48,22 @@ PRISMS_PF_BEGIN_NAMESPACE
 template <int dim, int degree, typename number>
 class customPDE;
 
+/**
+ * \brief Whether a preconditioner can be applied to vectors of a certain type.
+ */
+template <typename PreconditionerType, typename VectorType, typename = void>
+struct preconditionerSupportsVector : std::false_type
+{};
+
+template <typename PreconditionerType, typename VectorType>
+struct preconditionerSupportsVector<
+  PreconditionerType,
+  VectorType,
+  std::void_t<decltype(std::declval<const PreconditionerType &>().vmult(
+    std::declval<VectorType &>(),
+    std::declval<const VectorType &>()))>> : std::true_type
+{};
+
 /**
  * \brief Base class that handles the assembly and linear solving of a field.
  */
@@ -35,8 +71,10 @@ template <int dim, int degree>
 class linearSolverBase
 {
 public:
-  using SystemMatrixType = customPDE<dim, degree, double>;
-  using VectorType       = dealii::LinearAlgebra::distributed::Vector<double>;
+  using SystemMatrixType      = customPDE<dim, degree, double>;
+  using VectorType            = dealii::LinearAlgebra::distributed::Vector<double>;
+  using MixedSystemMatrixType = customPDE<dim, degree, float>;
+  using MixedVectorType       = dealii::LinearAlgebra::distributed::Vector<float>;
 
   /**
    * \brief Constructor.
@@ -70,13 +108,243 @@ public:
   virtual void
   solve(const double step_length = 1.0) = 0;
 
+  /**
+   * \brief Compute the residual of the current solution and return its l2-norm. The
+   * next call to solve() reuses this residual instead of recomputing it.
+   */
+  double
+  compute_residual_norm();
+
+  /**
+   * \brief Add the scaled newton update from the last solve to the solution. This is
+   * used to adjust the step length after the fact, for example in a line search.
+   */
+  void
+  add_newton_update(const double step_length);
+
+  /**
+   * \brief Set the forcing term for the next linear solves. When this is positive, the
+   * linear solver tolerance is the forcing term times the l2-norm of the residual,
+   * overriding the user-specified tolerance.
+   */
+  void
+  set_forcing_term(const double _forcing_term);
+
+  /**
+   * \brief Set whether the next solves start from the initial guess given by the
+   * history of previous updates, and add their update to that history. Nonlinear solvers
+   * only enable this for the first Newton iteration of a time step, so that the history
+   * holds comparable updates.
+   */
+  void
+  set_use_update_history(const bool _use_update_history);
+
+  /**
+   * \brief Get the l2-norm of the residual at the start of the last solve.
+   */
+  [[nodiscard]] double
+  get_residual_norm() const;
+
+  /**
+   * \brief Get the l2-norm of the newton update from the last solve.
+   */
+  [[nodiscard]] double
+  get_newton_update_norm() const;
+
+  /**
+   * \brief Get the number of linear iterations of the last solve.
+   */
+  [[nodiscard]] unsigned int
+  get_n_linear_iterations() const;
+
+  /**
+   * \brief Decide with the resolve criterion of the field whether the solve of this
+   * increment can be skipped, so that the field keeps its previous solution. Skipped
+   * solves are counted and reported.
+   */
+  [[nodiscard]] bool
+  try_skip_solve();
+
+  /**
+   * \brief Get the total number of skipped solves.
+   */
+  [[nodiscard]] unsigned int
+  get_n_skipped_solves() const;
+
+  /**
+   * \brief Prepare the solve of this field as part of a batch. Like the first part of
+   * solve(), this computes the residual, the solver tolerance, and the initial guess.
+   */
+  void
+  begin_batched_solve();
+
+  /**
+   * \brief Finish the solve of this field as part of a batch, once the newton update has
+   * been computed. Like the last part of solve(), this updates the solution.
+   */
+  void
+  end_batched_solve(const double step_length = 1.0);
+
+  /**
+   * \brief Get the residual vector.
+   */
+  [[nodiscard]] const VectorType &
+  get_residual() const;
+
+  /**
+   * \brief Get the newton update vector.
+   */
+  [[nodiscard]] VectorType &
+  get_newton_update();
+
+  /**
+   * \brief Get the PDE operator for the newton update side.
+   */
+  [[nodiscard]] const SystemMatrixType &
+  get_update_system_matrix() const;
+
+  /**
+   * \brief Get the solver control.
+   */
+  [[nodiscard]] dealii::SolverControl &
+  get_solver_control();
+
 protected:
+  /**
+   * \brief Compute the residual if it isn't already up to date and store its l2-norm.
+   */
+  void
+  update_residual();
+
   /**
    * \brief Compute the solver tolerance based on the specified tolerance type.
    */
   void
   compute_solver_tolerance();
 
+  /**
+   * \brief Solve the newton update system with the Krylov method of the field, starting
+   * from a zero initial guess.
+   */
+  template <typename PreconditionerType>
+  void
+  solve_newton_update(const PreconditionerType &preconditioner);
+
+  /**
+   * \brief Solve a system with the Krylov method of the field.
+   */
+  template <typename MatrixType, typename VectorTypeOfSolve, typename PreconditionerType>
+  void
+  solve_krylov(dealii::SolverControl    &control,
+               const MatrixType         &matrix,
+               VectorTypeOfSolve        &solution,
+               const VectorTypeOfSolve  &rhs,
+               const PreconditionerType &preconditioner);
+
+  /**
+   * \brief Set the Jacobian-free operator to the current solution. This does nothing
+   * unless Jacobian-free solves or Jacobian checks are enabled for the field.
+   */
+  void
+  reinit_jacobian_free_operator();
+
+  /**
+   * \brief Compare the user LHS against finite differences of the residual in the
+   * direction of the residual and print the relative difference.
+   */
+  void
+  check_jacobian();
+
+  /**
+   * \brief Set up the single precision operator and vectors for mixed precision solves.
+   * This does nothing unless mixed precision is enabled for the field.
+   */
+  void
+  init_mixed_precision();
+
+  /**
+   * \brief Solve the newton update system with iterative refinement. The Krylov
+   * iterations run in single precision on the defect, which is computed in double
+   * precision after each solve. The solver control counts the single precision
+   * iterations of all refinement steps.
+   */
+  template <typename PreconditionerType>
+  void
+  solve_mixed_precision(const PreconditionerType &preconditioner);
+
+  /**
+   * \brief Zero the constrained entries of the newton update, add the scaled update to
+   * the solution, and apply the constraints. This is the end of every linear solve.
+   */
+  void
+  update_solution(const double step_length);
+
+  /**
+   * \brief Clear the cached linearization of the double precision operator and, for
+   * mixed precision solves, of the single precision operator. Both are linearized about
+   * the same solution, so they go stale together.
+   */
+  void
+  clear_linearization();
+
+  /**
+   * \brief Set the newton update to the initial guess of the field, given the history
+   * of previous updates.
+   */
+  void
+  compute_initial_guess();
+
+  /**
+   * \brief Set the newton update to the Galerkin projection of the system onto the span
+   * of the previous updates.
+   */
+  void
+  compute_pod_initial_guess();
+
+  /**
+   * \brief Add the newton update to the history of previous updates.
+   */
+  void
+  record_update();
+
+  /**
+   * \brief Whether the preconditioner should be rebuilt before the next solve, based on
+   * the rebuild period and iteration growth of the field.
+   */
+  [[nodiscard]] bool
+  preconditioner_is_stale() const;
+
+  /**
+   * \brief Record a linear solve with the current preconditioner for the rebuild
+   * criteria.
+   */
+  void
+  record_preconditioner_use();
+
+  /**
+   * \brief Store the state that the resolve criterion compares against. This is called
+   * after every solve.
+   */
+  void
+  record_resolve_reference();
+
+  /**
+   * \brief Whether the relative change of any dependency since the last solve exceeds
+   * the given tolerance. Only the solution vectors are compared, so a RHS that depends
+   * explicitly on time is not detected. The boundary conditions only change on
+   * remeshing, which clears the snapshots.
+   */
+  [[nodiscard]] bool
+  dependencies_changed(const double change_tolerance);
+
+  /**
+   * \brief Discard all state that refers to the previous solves, such as the update
+   * history and the recycled subspace. This is called when the system is reinitialized
+   * on a new mesh.
+   */
+  void
+  clear_solve_history();
+
   /**
    * \brief User-inputs.
    */
@@ -163,6 +431,127 @@ protected:
    * \brief Solver tolerance
    */
   double tolerance = 0.0;
+
+  /**
+   * \brief Forcing term for inexact newton solves. Nonpositive values disable this.
+   */
+  double forcing_term = 0.0;
+
+  /**
+   * \brief Whether the residual vector corresponds to the current solution.
+   */
+  bool residual_up_to_date = false;
+
+  /**
+   * \brief l2-norm of the residual at the start of the last solve.
+   */
+  double residual_norm = 0.0;
+
+  /**
+   * \brief Whether the initial guess uses the history of previous updates.
+   */
+  bool use_update_history = true;
+
+  /**
+   * \brief Newton updates of the previous solves, most recent first.
+   */
+  std::deque<VectorType> update_history;
+
+  /**
+   * \brief CG solver that recycles a subspace between solves.
+   */
+  std::unique_ptr<deflatedCG<VectorType>> deflated_cg;
+
+  /**
+   * \brief Operator that applies the Jacobian by finite differences of the residual.
+   */
+  std::unique_ptr<jacobianFreeOperator<SystemMatrixType, VectorType>>
+    jacobian_free_operator;
+
+  /**
+   * \brief Mapping for the single precision matrix-free object.
+   */
+  const dealii::MappingQ1<dim> mixed_precision_mapping;
+
+  /**
+   * \brief Single precision copies of the constraints of all fields.
+   */
+  std::vector<dealii::AffineConstraints<float>> mixed_precision_constraints;
+
+  /**
+   * \brief Single precision matrix-free object handler.
+   */
+  matrixfreeHandler<dim, float> mixed_precision_matrix_free_handler;
+
+  /**
+   * \brief Single precision PDE operator for the newton update side.
+   */
+  std::unique_ptr<MixedSystemMatrixType> mixed_update_system_matrix;
+
+  /**
+   * \brief Single precision copies of the src subset of the newton update.
+   */
+  std::vector<MixedVectorType> mixed_src_vectors;
+
+  /**
+   * \brief Pointers to the single precision src subset of the newton update.
+   */
+  std::vector<MixedVectorType *> mixed_newton_update_src;
+
+  /**
+   * \brief Single precision defect and correction of the refinement steps.
+   */
+  MixedVectorType mixed_residual;
+  MixedVectorType mixed_newton_update;
+
+  /**
+   * \brief Double precision defect of the refinement steps.
+   */
+  VectorType refinement_residual;
+
+  /**
+   * \brief Number of solves since the preconditioner was last built.
+   */
+  unsigned int n_solves_since_setup = 0;
+
+  /**
+   * \brief Number of linear iterations of the first solve after the preconditioner was
+   * last built.
+   */
+  unsigned int reference_n_iterations = 0;
+
+  /**
+   * \brief Whether the field has been solved at least once.
+   */
+  bool has_solved = false;
+
+  /**
+   * \brief l2-norm of the residual at the start of the last solve.
+   */
+  double reference_residual_norm = 0.0;
+
+  /**
+   * \brief Copies of the dependencies of the field at the last solve, their l2-norm,
+   * and their version stamp.
+   */
+  std::map<unsigned int, VectorType>   dependency_snapshots;
+  std::map<unsigned int, double>       dependency_snapshot_norms;
+  std::map<unsigned int, unsigned int> dependency_snapshot_versions;
+
+  /**
+   * \brief Scratch vector for the change of a dependency since its snapshot.
+   */
+  VectorType dependency_change;
+
+  /**
+   * \brief Number of consecutive skipped solves.
+   */
+  unsigned int n_consecutive_skipped_solves = 0;
+
+  /**
+   * \brief Total number of skipped solves.
+   */
+  unsigned int n_skipped_solves = 0;
 };
 
 template <int dim, int degree>
@@ -183,6 +572,7 @@ linearSolverBase<dim, degree>::linearSolverBase(
       std::make_pair(field_index, dependencyType::CHANGE)))
   , solver_control(
       _user_inputs.linear_solve_parameters.linear_solve.at(field_index).max_iterations)
+  , mixed_precision_matrix_free_handler(_user_inputs)
 {
   // Creating map to match types
   subset_attributes.emplace(field_index, variable_attributes);
@@ -262,16 +652,846 @@ linearSolverBase<dim, degree>::linearSolverBase(
     }
 }
 
+template <int dim, int degree>
+inline double
+linearSolverBase<dim, degree>::compute_residual_norm()
+{
+  residual_up_to_date = false;
+  update_residual();
+
+  return residual_norm;
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::update_residual()
+{
+  if (residual_up_to_date)
+    {
+      return;
+    }
+
+  system_matrix->compute_residual(*residual,
+                                  *solution_handler.solution_set.at(
+                                    std::make_pair(field_index, dependencyType::NORMAL)));
+  residual_norm       = residual->l2_norm();
+  residual_up_to_date = true;
+}
+
 template <int dim, int degree>
 inline void
-linearSolverBase<dim, degree>::compute_solver_tolerance()
+linearSolverBase<dim, degree>::add_newton_update(const double step_length)
 {
-  tolerance =
-    user_inputs.linear_solve_parameters.linear_solve.at(field_index).tolerance_type ==
-        solverToleranceType::RELATIVE_RESIDUAL_CHANGE
-      ? user_inputs.linear_solve_parameters.linear_solve.at(field_index).tolerance *
-          residual->l2_norm()
-      : user_inputs.linear_solve_parameters.linear_solve.at(field_index).tolerance;
+  auto *solution =
+    solution_handler.solution_set.at(std::make_pair(field_index, dependencyType::NORMAL));
+
+  solution->add(step_length, *newton_update);
+  constraint_handler.get_constraint(field_index).distribute(*solution);
+  residual_up_to_date = false;
+  solution_handler.mark_changed(field_index);
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::set_forcing_term(const double _forcing_term)
+{
+  forcing_term = _forcing_term;
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::set_use_update_history(const bool _use_update_history)
+{
+  use_update_history = _use_update_history;
+}
+
+template <int dim, int degree>
+inline double
+linearSolverBase<dim, degree>::get_residual_norm() const
+{
+  return residual_norm;
+}
+
+template <int dim, int degree>
+inline double
+linearSolverBase<dim, degree>::get_newton_update_norm() const
+{
+  return newton_update->l2_norm();
+}
+
+template <int dim, int degree>
+inline unsigned int
+linearSolverBase<dim, degree>::get_n_linear_iterations() const
+{
+  return solver_control.last_step();
+}
+
+template <int dim, int degree>
+inline bool
+linearSolverBase<dim, degree>::try_skip_solve()
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  if (parameters.resolve_criterion == resolveCriterion::ALWAYS_RESOLVE || !has_solved ||
+      (parameters.max_skipped_solves > 0 &&
+       n_consecutive_skipped_solves >= parameters.max_skipped_solves))
+    {
+      return false;
+    }
+
+  bool skip = false;
+  switch (parameters.resolve_criterion)
+    {
+      case resolveCriterion::RESIDUAL_RESOLVE:
+        // The residual is reused by the solve if we don't skip it
+        update_residual();
+        skip = residual_norm <= parameters.resolve_tolerance * reference_residual_norm;
+        if (skip)
+          {
+            // The dependencies may change before the next check
+            residual_up_to_date = false;
+          }
+        break;
+      case resolveCriterion::DEPENDENCY_CHANGE_RESOLVE:
+        skip = !dependencies_changed(parameters.resolve_tolerance);
+        break;
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+
+  if (skip)
+    {
+      n_consecutive_skipped_solves++;
+      n_skipped_solves++;
+      conditionalOStreams::pout_summary()
+        << "  field: " << field_index << " Solve skipped by the resolve criterion"
+        << " Skipped solves: " << n_skipped_solves << "\n"
+        << std::flush;
+    }
+
+  return skip;
+}
+
+template <int dim, int degree>
+inline unsigned int
+linearSolverBase<dim, degree>::get_n_skipped_solves() const
+{
+  return n_skipped_solves;
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::begin_batched_solve()
+{
+  // Compute the residual, unless it is already up to date
+  update_residual();
+
+  // Determine the residual tolerance
+  compute_solver_tolerance();
+  solver_control.set_tolerance(tolerance);
+
+  if (user_inputs.linear_solve_parameters.linear_solve.at(field_index)
+        .frozen_linearization)
+    {
+      update_system_matrix->compute_linearization();
+    }
+  compute_initial_guess();
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::end_batched_solve(const double step_length)
+{
+  clear_linearization();
+  if (solver_control.last_check() != dealii::SolverControl::success)
+    {
+      conditionalOStreams::pout_base()
+        << "Warning: linear solver did not converge as per set tolerances.\n";
+    }
+  record_update();
+  record_preconditioner_use();
+
+  conditionalOStreams::pout_summary()
+    << "  field: " << field_index << " Initial residual: " << residual_norm
+    << " Final residual: " << solver_control.last_value()
+    << " Steps: " << solver_control.last_step() << " (batched)\n"
+    << std::flush;
+
+  update_solution(step_length);
+}
+
+template <int dim, int degree>
+inline const typename linearSolverBase<dim, degree>::VectorType &
+linearSolverBase<dim, degree>::get_residual() const
+{
+  return *residual;
+}
+
+template <int dim, int degree>
+inline typename linearSolverBase<dim, degree>::VectorType &
+linearSolverBase<dim, degree>::get_newton_update()
+{
+  return *newton_update;
+}
+
+template <int dim, int degree>
+inline const typename linearSolverBase<dim, degree>::SystemMatrixType &
+linearSolverBase<dim, degree>::get_update_system_matrix() const
+{
+  return *update_system_matrix;
+}
+
+template <int dim, int degree>
+inline dealii::SolverControl &
+linearSolverBase<dim, degree>::get_solver_control()
+{
+  return solver_control;
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::compute_solver_tolerance()
+{
+  if (forcing_term > 0.0)
+    {
+      tolerance = forcing_term * residual_norm;
+      return;
+    }
+
+  tolerance =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index).tolerance_type ==
+        solverToleranceType::RELATIVE_RESIDUAL_CHANGE
+      ? user_inputs.linear_solve_parameters.linear_solve.at(field_index).tolerance *
+          residual_norm
+      : user_inputs.linear_solve_parameters.linear_solve.at(field_index).tolerance;
+}
+
+template <int dim, int degree>
+template <typename PreconditionerType>
+inline void
+linearSolverBase<dim, degree>::solve_newton_update(
+  const PreconditionerType &preconditioner)
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  // Linearize the LHS once for all operator applications of this solve
+  if (parameters.frozen_linearization)
+    {
+      update_system_matrix->compute_linearization();
+    }
+
+  reinit_jacobian_free_operator();
+  if (parameters.check_jacobian)
+    {
+      check_jacobian();
+    }
+
+  compute_initial_guess();
+  try
+    {
+      if (parameters.mixed_precision)
+        {
+          if constexpr (preconditionerSupportsVector<PreconditionerType,
+                                                     MixedVectorType>::value)
+            {
+              solve_mixed_precision(preconditioner);
+            }
+          else
+            {
+              AssertThrow(false,
+                          FeatureNotImplemented(
+                            "Mixed precision with this preconditioner"));
+            }
+        }
+      else if (parameters.recycled_subspace_size > 0)
+        {
+          if (!deflated_cg)
+            {
+              deflated_cg = std::make_unique<deflatedCG<VectorType>>(
+                parameters.recycled_subspace_size);
+            }
+          deflated_cg->solve(solver_control,
+                             *update_system_matrix,
+                             *newton_update,
+                             *residual,
+                             preconditioner);
+        }
+      else if (parameters.jacobian_free)
+        {
+          solve_krylov(solver_control,
+                       *jacobian_free_operator,
+                       *newton_update,
+                       *residual,
+                       preconditioner);
+        }
+      else
+        {
+          solve_krylov(solver_control,
+                       *update_system_matrix,
+                       *newton_update,
+                       *residual,
+                       preconditioner);
+        }
+    }
+  catch (...)
+    {
+      // The linearization is stale once the solution is updated
+      clear_linearization();
+      throw;
+    }
+  clear_linearization();
+  record_update();
+  record_resolve_reference();
+}
+
+template <int dim, int degree>
+template <typename MatrixType, typename VectorTypeOfSolve, typename PreconditionerType>
+inline void
+linearSolverBase<dim, degree>::solve_krylov(dealii::SolverControl    &control,
+                                            const MatrixType         &matrix,
+                                            VectorTypeOfSolve        &solution,
+                                            const VectorTypeOfSolve  &rhs,
+                                            const PreconditionerType &preconditioner)
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  switch (parameters.solver_type)
+    {
+      case linearSolverType::SOLVER_CG:
+        {
+          dealii::SolverCG<VectorTypeOfSolve> cg(control);
+          cg.solve(matrix, solution, rhs, preconditioner);
+          break;
+        }
+      case linearSolverType::SOLVER_GMRES:
+        {
+          typename dealii::SolverGMRES<VectorTypeOfSolve>::AdditionalData gmres_data;
+#if DEAL_II_VERSION_GTE(9, 6, 0)
+          gmres_data.max_basis_size = parameters.gmres_restart;
+#else
+          // Before deal.II 9.6, the two auxiliary vectors count towards the basis size
+          gmres_data.max_n_tmp_vectors = parameters.gmres_restart + 2;
+#endif
+          dealii::SolverGMRES<VectorTypeOfSolve> gmres(control, gmres_data);
+          gmres.solve(matrix, solution, rhs, preconditioner);
+          break;
+        }
+      case linearSolverType::SOLVER_FGMRES:
+        {
+          dealii::SolverFGMRES<VectorTypeOfSolve> fgmres(
+            control,
+            typename dealii::SolverFGMRES<VectorTypeOfSolve>::AdditionalData(
+              parameters.gmres_restart));
+          fgmres.solve(matrix, solution, rhs, preconditioner);
+          break;
+        }
+      case linearSolverType::SOLVER_BICGSTAB:
+        {
+          dealii::SolverBicgstab<VectorTypeOfSolve> bicgstab(control);
+          bicgstab.solve(matrix, solution, rhs, preconditioner);
+          break;
+        }
+      case linearSolverType::SOLVER_PIPELINED_CG:
+        {
+          pipelinedCG<VectorTypeOfSolve> pipelined_cg(control);
+          pipelined_cg.solve(matrix, solution, rhs, preconditioner);
+          break;
+        }
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::init_mixed_precision()
+{
+  if (!user_inputs.linear_solve_parameters.linear_solve.at(field_index).mixed_precision)
+    {
+      return;
+    }
+
+  // The single precision matrix-free object has the same fields, in the same order, as
+  // the double precision one, so the vectors of both share their partitioning.
+  const auto        &matrix_free = *matrix_free_handler.get_matrix_free();
+  const unsigned int n_fields    = matrix_free.n_components();
+
+  std::vector<const dealii::DoFHandler<dim> *>           dof_handlers;
+  std::vector<const dealii::AffineConstraints<float> *> constraints;
+  mixed_precision_constraints.clear();
+  mixed_precision_constraints.resize(n_fields);
+  for (unsigned int index = 0; index < n_fields; ++index)
+    {
+      mixed_precision_constraints[index].copy_from(
+        constraint_handler.get_constraint(index));
+      dof_handlers.push_back(&matrix_free.get_dof_handler(index));
+      constraints.push_back(&mixed_precision_constraints[index]);
+    }
+  mixed_precision_matrix_free_handler.reinit(mixed_precision_mapping,
+                                             dof_handlers,
+                                             constraints,
+                                             dealii::QGaussLobatto<1>(degree + 1));
+
+  mixed_update_system_matrix =
+    std::make_unique<MixedSystemMatrixType>(user_inputs, field_index, subset_attributes);
+  mixed_update_system_matrix->initialize(
+    mixed_precision_matrix_free_handler.get_matrix_free());
+  mixed_update_system_matrix->add_global_to_local_mapping(
+    newton_update_global_to_local_solution);
+
+  mixed_src_vectors.clear();
+  mixed_src_vectors.resize(newton_update_src.size());
+  mixed_newton_update_src.clear();
+  for (const auto &[pair, local_index] : newton_update_global_to_local_solution)
+    {
+      mixed_update_system_matrix->initialize_dof_vector(mixed_src_vectors[local_index],
+                                                        pair.first);
+    }
+  for (auto &mixed_src_vector : mixed_src_vectors)
+    {
+      mixed_newton_update_src.push_back(&mixed_src_vector);
+    }
+  mixed_update_system_matrix->add_src_solution_subset(mixed_newton_update_src);
+
+  mixed_update_system_matrix->initialize_dof_vector(mixed_residual, field_index);
+  mixed_update_system_matrix->initialize_dof_vector(mixed_newton_update, field_index);
+  refinement_residual.reinit(*residual);
+}
+
+template <int dim, int degree>
+template <typename PreconditionerType>
+inline void
+linearSolverBase<dim, degree>::solve_mixed_precision(
+  const PreconditionerType &preconditioner)
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  Assert(mixed_update_system_matrix,
+         dealii::ExcMessage(
+           "The single precision operator must be initialized with "
+           "init_mixed_precision() prior to any mixed precision solves."));
+
+  // Convert the LHS dependencies to single precision. The change term is given by the
+  // src vector of the operator, so it doesn't have to be converted.
+  for (const auto &[pair, local_index] : newton_update_global_to_local_solution)
+    {
+      if (pair.second == dependencyType::CHANGE)
+        {
+          continue;
+        }
+      mixed_src_vectors[local_index].copy_locally_owned_data_from(
+        *newton_update_src[local_index]);
+      mixed_src_vectors[local_index].update_ghost_values();
+    }
+  if (parameters.frozen_linearization)
+    {
+      mixed_update_system_matrix->compute_linearization();
+    }
+
+  unsigned int n_iterations = 0;
+  while (true)
+    {
+      // Compute the defect in double precision
+      update_system_matrix->vmult(refinement_residual, *newton_update);
+      refinement_residual.sadd(-1.0, 1.0, *residual);
+
+      const double defect_norm = refinement_residual.l2_norm();
+      const dealii::SolverControl::State state =
+        solver_control.check(n_iterations, defect_norm);
+      if (state == dealii::SolverControl::success)
+        {
+          break;
+        }
+      AssertThrow(state != dealii::SolverControl::failure,
+                  dealii::SolverControl::NoConvergence(n_iterations, defect_norm));
+
+      // Solve for the correction in single precision. The remaining iterations are
+      // shared with the later refinement steps.
+      mixed_residual.copy_locally_owned_data_from(refinement_residual);
+      mixed_newton_update = 0.0;
+
+      dealii::ReductionControl inner_control(solver_control.max_steps() - n_iterations,
+                                             0.0,
+                                             parameters.mixed_precision_reduction);
+      try
+        {
+          solve_krylov(inner_control,
+                       *mixed_update_system_matrix,
+                       mixed_newton_update,
+                       mixed_residual,
+                       preconditioner);
+        }
+      catch (const dealii::SolverControl::NoConvergence &)
+        {
+          // An unconverged correction still reduces the defect, and the outer solver
+          // control decides whether to give up.
+        }
+      n_iterations += std::max(inner_control.last_step(), 1U);
+
+      // Add the correction in double precision
+      refinement_residual.copy_locally_owned_data_from(mixed_newton_update);
+      newton_update->add(1.0, refinement_residual);
+    }
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::update_solution(const double step_length)
+{
+  auto *solution =
+    solution_handler.solution_set.at(std::make_pair(field_index, dependencyType::NORMAL));
+
+  constraint_handler.get_constraint(field_index).set_zero(*newton_update);
+
+  // Update the solutions
+  solution->add(step_length, *newton_update);
+  residual_up_to_date = false;
+  solution_handler.mark_changed(field_index);
+  solution_handler.update(fieldSolveType::NONEXPLICIT_LINEAR, field_index);
+
+  // Apply constraints
+  // This may be redundant with the constraints on the update step.
+  constraint_handler.get_constraint(field_index).distribute(*solution);
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::clear_linearization()
+{
+  update_system_matrix->clear_linearization();
+  if (mixed_update_system_matrix)
+    {
+      mixed_update_system_matrix->clear_linearization();
+    }
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::compute_initial_guess()
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  *newton_update = 0.0;
+  if (!use_update_history ||
+      parameters.initial_guess == initialGuessType::ZERO_INITIAL_GUESS)
+    {
+      return;
+    }
+
+  // Drop the history if the vector layout changed, for example after remeshing
+  if (!update_history.empty() &&
+      !update_history.front().get_partitioner()->is_compatible(
+        *newton_update->get_partitioner()))
+    {
+      update_history.clear();
+    }
+  if (update_history.empty())
+    {
+      return;
+    }
+
+  // The extrapolations fall back to a lower order until there are enough updates
+  switch (parameters.initial_guess)
+    {
+      case initialGuessType::LINEAR_EXTRAPOLATION:
+      case initialGuessType::QUADRATIC_EXTRAPOLATION:
+        {
+          if (update_history.size() == 1)
+            {
+              *newton_update = update_history[0];
+            }
+          else if (update_history.size() == 2 ||
+                   parameters.initial_guess == initialGuessType::LINEAR_EXTRAPOLATION)
+            {
+              newton_update->add(2.0, update_history[0], -1.0, update_history[1]);
+            }
+          else
+            {
+              newton_update->add(3.0, update_history[0], -3.0, update_history[1]);
+              newton_update->add(1.0, update_history[2]);
+            }
+          break;
+        }
+      case initialGuessType::POD_PROJECTION:
+        {
+          compute_pod_initial_guess();
+          break;
+        }
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+  constraint_handler.get_constraint(field_index).set_zero(*newton_update);
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::compute_pod_initial_guess()
+{
+  // Orthonormalize the previous updates with modified Gram-Schmidt, dropping those that
+  // are (nearly) linearly dependent on the more recent ones
+  std::vector<VectorType> basis;
+  for (const auto &update : update_history)
+    {
+      VectorType vector(update);
+      for (const auto &basis_vector : basis)
+        {
+          vector.add(-(basis_vector * vector), basis_vector);
+        }
+      const double norm = vector.l2_norm();
+      if (norm > 1.0e-8 * update.l2_norm() && norm > 0.0)
+        {
+          vector /= norm;
+          basis.push_back(std::move(vector));
+        }
+    }
+  if (basis.empty())
+    {
+      return;
+    }
+
+  // Project the system onto the basis. This costs one operator application per basis
+  // vector.
+  const auto                 n_basis = static_cast<unsigned int>(basis.size());
+  dealii::FullMatrix<double> projected_matrix(n_basis, n_basis);
+  dealii::Vector<double>     projected_rhs(n_basis);
+  dealii::Vector<double>     coefficients(n_basis);
+  VectorType                 temp;
+  temp.reinit(*newton_update);
+  for (unsigned int j = 0; j < n_basis; ++j)
+    {
+      update_system_matrix->vmult(temp, basis[j]);
+      for (unsigned int i = 0; i < n_basis; ++i)
+        {
+          projected_matrix(i, j) = basis[i] * temp;
+        }
+      projected_rhs(j) = basis[j] * (*residual);
+    }
+  projected_matrix.gauss_jordan();
+  projected_matrix.vmult(coefficients, projected_rhs);
+
+  for (unsigned int j = 0; j < n_basis; ++j)
+    {
+      newton_update->add(coefficients(j), basis[j]);
+    }
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::record_update()
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  if (!use_update_history ||
+      parameters.initial_guess == initialGuessType::ZERO_INITIAL_GUESS)
+    {
+      return;
+    }
+
+  unsigned int history_size = parameters.initial_guess_history;
+  if (parameters.initial_guess == initialGuessType::LINEAR_EXTRAPOLATION)
+    {
+      history_size = 2;
+    }
+  else if (parameters.initial_guess == initialGuessType::QUADRATIC_EXTRAPOLATION)
+    {
+      history_size = 3;
+    }
+
+  // Recycle the oldest update so we don't reallocate once the history is full
+  if (update_history.size() >= history_size)
+    {
+      VectorType oldest_update = std::move(update_history.back());
+      update_history.pop_back();
+      oldest_update = *newton_update;
+      update_history.push_front(std::move(oldest_update));
+    }
+  else
+    {
+      update_history.push_front(*newton_update);
+    }
+  constraint_handler.get_constraint(field_index).set_zero(update_history.front());
+}
+
+template <int dim, int degree>
+inline bool
+linearSolverBase<dim, degree>::preconditioner_is_stale() const
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  if (parameters.preconditioner_rebuild_period > 0 &&
+      n_solves_since_setup >= parameters.preconditioner_rebuild_period)
+    {
+      return true;
+    }
+
+  // Only consider the growth once we have a reference solve to compare against
+  return parameters.preconditioner_rebuild_iteration_growth > 0.0 &&
+         n_solves_since_setup > 0 &&
+         static_cast<double>(solver_control.last_step()) >
+           (1.0 + 0.01 * parameters.preconditioner_rebuild_iteration_growth) *
+             static_cast<double>(reference_n_iterations);
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::record_preconditioner_use()
+{
+  // The first solve after a rebuild is the reference for the iteration growth
+  if (n_solves_since_setup == 0)
+    {
+      reference_n_iterations = solver_control.last_step();
+    }
+  n_solves_since_setup++;
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::clear_solve_history()
+{
+  update_history.clear();
+  deflated_cg.reset();
+  jacobian_free_operator.reset();
+  residual_up_to_date          = false;
+  n_solves_since_setup         = 0;
+  has_solved                   = false;
+  n_consecutive_skipped_solves = 0;
+  dependency_snapshots.clear();
+  dependency_snapshot_norms.clear();
+  dependency_snapshot_versions.clear();
+  dependency_change.reinit(0);
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::reinit_jacobian_free_operator()
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  if (!parameters.jacobian_free && !parameters.check_jacobian)
+    {
+      return;
+    }
+
+  if (!jacobian_free_operator)
+    {
+      jacobian_free_operator =
+        std::make_unique<jacobianFreeOperator<SystemMatrixType, VectorType>>(
+          *system_matrix,
+          *solution_handler.solution_set.at(
+            std::make_pair(field_index, dependencyType::NORMAL)),
+          constraint_handler.get_constraint(field_index));
+    }
+
+  // The residual is up to date at the start of a solve
+  jacobian_free_operator->reinit(*residual);
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::check_jacobian()
+{
+  VectorType direction;
+  VectorType user_product;
+  VectorType finite_difference_product;
+  direction.reinit(*residual);
+  user_product.reinit(*residual);
+  finite_difference_product.reinit(*residual);
+
+  direction = *residual;
+  constraint_handler.get_constraint(field_index).set_zero(direction);
+  if (direction.l2_norm() == 0.0)
+    {
+      return;
+    }
+
+  update_system_matrix->vmult(user_product, direction);
+  jacobian_free_operator->vmult(finite_difference_product, direction);
+
+  const double reference_norm =
+    std::max(finite_difference_product.l2_norm(), std::numeric_limits<double>::min());
+  user_product -= finite_difference_product;
+  conditionalOStreams::pout_summary()
+    << " Jacobian check: " << user_product.l2_norm() / reference_norm << std::flush;
+}
+
+template <int dim, int degree>
+inline void
+linearSolverBase<dim, degree>::record_resolve_reference()
+{
+  const auto &parameters =
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index);
+
+  has_solved                   = true;
+  n_consecutive_skipped_solves = 0;
+  reference_residual_norm      = residual_norm;
+
+  if (parameters.resolve_criterion != resolveCriterion::DEPENDENCY_CHANGE_RESOLVE)
+    {
+      return;
+    }
+
+  // Only the current values of the other fields are compared. The dependencies of both
+  // sides are included, since the LHS may have coefficients that depend on other fields.
+  const auto add_dependencies = [&](const auto &dependency_set)
+  {
+    for (const auto &[index, map] : dependency_set)
+      {
+        const auto pair = std::make_pair(index, dependencyType::NORMAL);
+        if (index == field_index || map.find(dependencyType::NORMAL) == map.end() ||
+            solution_handler.solution_set.find(pair) ==
+              solution_handler.solution_set.end())
+          {
+            continue;
+          }
+        const unsigned int version = solution_handler.get_version(index);
+        if (dependency_snapshots.find(index) != dependency_snapshots.end() &&
+            dependency_snapshot_versions.at(index) == version)
+          {
+            continue;
+          }
+        dependency_snapshots[index]         = *solution_handler.solution_set.at(pair);
+        dependency_snapshot_norms[index]    = dependency_snapshots.at(index).l2_norm();
+        dependency_snapshot_versions[index] = version;
+      }
+  };
+  add_dependencies(variable_attributes.dependency_set_RHS);
+  add_dependencies(variable_attributes.dependency_set_LHS);
+}
+
+template <int dim, int degree>
+inline bool
+linearSolverBase<dim, degree>::dependencies_changed(const double change_tolerance)
+{
+  for (const auto &[index, snapshot] : dependency_snapshots)
+    {
+      // Fields that were not modified since the snapshot are unchanged
+      if (solution_handler.get_version(index) == dependency_snapshot_versions.at(index))
+        {
+          continue;
+        }
+
+      // Compute the change in a scratch vector, so the snapshot stays exact over many
+      // checks. The vectors of the dependencies share their layout, so this only copies.
+      dependency_change =
+        *solution_handler.solution_set.at(std::make_pair(index, dependencyType::NORMAL));
+      dependency_change -= snapshot;
+
+      if (dependency_change.l2_norm() >
+          change_tolerance * dependency_snapshot_norms.at(index))
+        {
+          return true;
+        }
+    }
+
+  return false;
 }
 
 PRISMS_PF_END_NAMESPACE
@@ -4,25 +4,30 @@
 #ifndef linear_solver_gmg_h
 #define linear_solver_gmg_h
 
-#include <deal.II/grid/grid_tools.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/operators.h>
 #include <deal.II/multigrid/mg_coarse.h>
-#include <deal.II/multigrid/mg_constrained_dofs.h>
 #include <deal.II/multigrid/mg_matrix.h>
 #include <deal.II/multigrid/mg_smoother.h>
-#include <deal.II/multigrid/mg_tools.h>
 #include <deal.II/multigrid/mg_transfer_global_coarsening.h>
-#include <deal.II/multigrid/mg_transfer_matrix_free.h>
 #include <deal.II/multigrid/multigrid.h>
 
 #include <prismspf/config.h>
 #include <prismspf/core/dof_handler.h>
-#include <prismspf/core/solution_output.h>
-#include <prismspf/core/triangulation_handler.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/core/multigrid_hierarchy.h>
+#include <prismspf/core/timer.h>
+#include <prismspf/solvers/cell_patch_inverse.h>
 #include <prismspf/solvers/linear_solver_base.h>
+#include <prismspf/solvers/mg_coarse_grid_solver.h>
+#include <prismspf/solvers/mg_level_operator.h>
+
+#include <limits>
+#include <memory>
 
 #ifdef PRISMS_PF_WITH_CALIPER
 #  include <caliper/cali.h>
@@ -37,33 +42,42 @@ template <int dim, int degree, typename number>
 class customPDE;
 
 /**
- * \brief Class that handles the assembly and solving of a field with a GMG preconditioner
+ * \brief Class that handles the assembly and solving of a field with a GMG
+ * preconditioner. The multigrid hierarchy is shared with the other fields that have the
+ * same finite element and boundary conditions, while the level operators are specific to
+ * this field.
  */
 template <int dim, int degree>
 class GMGSolver : public linearSolverBase<dim, degree>
 {
 public:
   using SystemMatrixType = customPDE<dim, degree, double>;
-  using LevelMatrixType  = customPDE<dim, degree, float>;
+  using LevelMatrixType  = mgLevelOperator<dim, float>;
   using VectorType       = dealii::LinearAlgebra::distributed::Vector<double>;
   using MGVectorType     = dealii::LinearAlgebra::distributed::Vector<float>;
 
+  /**
+   * \brief Chebyshev smoother, preconditioned by the given type on each level.
+   */
+  template <typename LevelPreconditionerType>
+  using SmootherType =
+    dealii::PreconditionChebyshev<LevelMatrixType, MGVectorType, LevelPreconditionerType>;
+
   /**
    * \brief Constructor.
    */
-  GMGSolver(const userInputParameters<dim>                       &_user_inputs,
-            const variableAttributes                             &_variable_attributes,
-            const matrixfreeHandler<dim>                         &_matrix_free_handler,
-            const constraintHandler<dim>                         &_constraint_handler,
-            const triangulationHandler<dim>                      &_triangulation_handler,
-            const dofHandler<dim>                                &_dof_handler,
-            dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-            solutionHandler<dim>                                 &_solution_handler);
+  GMGSolver(const userInputParameters<dim> &_user_inputs,
+            const variableAttributes       &_variable_attributes,
+            const matrixfreeHandler<dim>   &_matrix_free_handler,
+            const constraintHandler<dim>   &_constraint_handler,
+            const dofHandler<dim>          &_dof_handler,
+            mgHierarchyHandler<dim>        &_mg_hierarchy_handler,
+            solutionHandler<dim>           &_solution_handler);
 
   /**
    * \brief Destructor.
    */
-  ~GMGSolver() override;
+  ~GMGSolver() override = default;
 
   /**
    * \brief Initialize the system.
@@ -85,9 +99,30 @@ public:
 
 private:
   /**
-   * \brief Triangulation handler.
+   * \brief Create the operator of a multigrid level with the given polynomial degree.
+   * This recurses down from the degree of the field, so only the degrees that we may need
+   * are instantiated.
+   */
+  template <int level_degree = degree>
+  void
+  create_level_operator(const unsigned int &level, const unsigned int &fe_degree);
+
+  /**
+   * \brief Build the smoothers, including the level diagonals and eigenvalue estimates,
+   * the multigrid object, and the preconditioner.
    */
-  const triangulationHandler<dim> &triangulation_handler;
+  void
+  setup_preconditioner();
+
+  /**
+   * \brief Build the Chebyshev smoothers with the given preconditioner on each level,
+   * and the coarse grid solver, which may use the smoother of the coarsest level.
+   */
+  template <typename LevelPreconditionerType>
+  void
+  setup_smoother(
+    const dealii::MGLevelObject<std::shared_ptr<LevelPreconditionerType>>
+      &level_preconditioners);
 
   /**
    * \brief DoF handler.
@@ -95,9 +130,14 @@ private:
   const dofHandler<dim> &dof_handler;
 
   /**
-   * \brief Matrix-free object handler for multigrid data.
+   * \brief Handler of the multigrid hierarchies that are shared between fields.
    */
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &mg_matrix_free_handler;
+  mgHierarchyHandler<dim> &mg_hierarchy_handler;
+
+  /**
+   * \brief Multigrid hierarchy of this field.
+   */
+  std::shared_ptr<const mgHierarchy<dim>> hierarchy;
 
   /**
    * \brief Minimum multigrid level
@@ -110,298 +150,114 @@ private:
   unsigned int max_level = 0;
 
   /**
-   * \brief Mappings to and from reference cell.
+   * \brief PDE operator for each multigrid level.
+   */
+  std::unique_ptr<dealii::MGLevelObject<LevelMatrixType>> mg_operators;
+
+  /**
+   * \brief Multigrid object for storing all operators.
    */
-  const dealii::MappingQ1<dim> mapping;
+  std::shared_ptr<dealii::mg::Matrix<MGVectorType>> mg_matrix;
 
   /**
-   * \brief Collection of triangulations for each multigrid level.
+   * \brief Multilevel copies of the fields that are necessary for the source of the
+   * newton update. These are ordered by their local index.
    */
-  std::vector<std::shared_ptr<const dealii::Triangulation<dim>>> coarse_triangulations;
+  std::vector<dealii::MGLevelObject<MGVectorType>> mg_src_vectors;
 
   /**
-   * \brief Collection of DoFhandlers for each multigrid level.
+   * \brief Subset of fields that are necessary for the source of the newton update for
+   * each multigrid level. These point to the vectors in `mg_src_vectors`.
    */
-  dealii::MGLevelObject<dealii::DoFHandler<dim>> mg_dof_handlers;
+  dealii::MGLevelObject<std::vector<MGVectorType *>> mg_newton_update_src;
 
   /**
-   * \brief Collection of constraints for each multigrid level.
+   * \brief Version of each field, as given by the solution handler, when it was last
+   * transferred to the multigrid levels.
    */
-  dealii::MGLevelObject<dealii::AffineConstraints<float>> level_constraints;
+  std::map<unsigned int, unsigned int> transferred_versions;
 
   /**
-   * \brief Collection of transfer operators for each multigrid level.
+   * \brief Chebyshev smoother for each multigrid level.
    */
-  dealii::MGLevelObject<dealii::MGTwoLevelTransfer<dim, MGVectorType>>
-    mg_transfer_operators;
+  std::unique_ptr<dealii::MGSmootherBase<MGVectorType>> mg_smoother;
 
   /**
-   * \brief PDE operator for each multigrid level.
+   * \brief Solver control for the iterative coarse grid solver.
    */
-  std::unique_ptr<dealii::MGLevelObject<LevelMatrixType>> mg_operators;
+  std::unique_ptr<dealii::ReductionControl> coarse_solver_control;
 
   /**
-   * \brief Multigrid object for storing all operators.
+   * \brief CG solver for the iterative coarse grid solver.
    */
-  std::shared_ptr<dealii::mg::Matrix<MGVectorType>> mg_matrix;
+  std::unique_ptr<dealii::SolverCG<MGVectorType>> coarse_cg;
 
   /**
-   * \brief Transfer operator for global coarsening.
+   * \brief Coarse grid solver.
    */
-  std::shared_ptr<dealii::MGTransferGlobalCoarsening<dim, MGVectorType>> mg_transfer;
+  std::unique_ptr<dealii::MGCoarseGridBase<MGVectorType>> mg_coarse;
 
   /**
-   * \brief Subset of fields that are necessary for the source of the newton update for
-   * each multigrid level.
+   * \brief Multigrid object.
    */
-  dealii::MGLevelObject<std::vector<MGVectorType *>> mg_newton_update_src;
+  std::unique_ptr<dealii::Multigrid<MGVectorType>> mg;
+
+  /**
+   * \brief Multigrid preconditioner.
+   */
+  std::unique_ptr<
+    dealii::PreconditionMG<dim,
+                           MGVectorType,
+                           dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>>
+    preconditioner;
 };
 
 template <int dim, int degree>
-GMGSolver<dim, degree>::GMGSolver(
-  const userInputParameters<dim>                       &_user_inputs,
-  const variableAttributes                             &_variable_attributes,
-  const matrixfreeHandler<dim>                         &_matrix_free_handler,
-  const constraintHandler<dim>                         &_constraint_handler,
-  const triangulationHandler<dim>                      &_triangulation_handler,
-  const dofHandler<dim>                                &_dof_handler,
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-  solutionHandler<dim>                                 &_solution_handler)
+GMGSolver<dim, degree>::GMGSolver(const userInputParameters<dim> &_user_inputs,
+                                  const variableAttributes       &_variable_attributes,
+                                  const matrixfreeHandler<dim>   &_matrix_free_handler,
+                                  const constraintHandler<dim>   &_constraint_handler,
+                                  const dofHandler<dim>          &_dof_handler,
+                                  mgHierarchyHandler<dim>        &_mg_hierarchy_handler,
+                                  solutionHandler<dim>           &_solution_handler)
   : linearSolverBase<dim, degree>(_user_inputs,
                                   _variable_attributes,
                                   _matrix_free_handler,
                                   _constraint_handler,
                                   _solution_handler)
-  , triangulation_handler(_triangulation_handler)
   , dof_handler(_dof_handler)
-  , mg_matrix_free_handler(_mg_matrix_free_handler)
+  , mg_hierarchy_handler(_mg_hierarchy_handler)
 {}
 
-template <int dim, int degree>
-GMGSolver<dim, degree>::~GMGSolver()
-{
-  for (unsigned int level = min_level; level <= max_level; ++level)
-    {
-      for (const auto *vector : mg_newton_update_src[level])
-        {
-          delete vector;
-        }
-    }
-}
-
 template <int dim, int degree>
 inline void
 GMGSolver<dim, degree>::init()
 {
-  // We solve the system with a global coarsening approach. There are two options when
-  // doing this: geometric coarsening and polynomial coarsening. We only support geometric
-  // as of now.
-  const auto *current_dof_handler = dof_handler.const_dof_handlers.at(this->field_index);
-
-  Assert(this->triangulation_handler.get_triangulation().n_global_levels() > 1,
-         dealii::ExcMessage(
-           "Multigrid preconditioner requires a multilevel triangulation"));
-  if constexpr (dim != 1)
-    {
-      Assert(this->triangulation_handler.get_triangulation()
-               .is_multilevel_hierarchy_constructed(),
-             dealii::ExcMessage(
-               "parrallel::distributed::Triangulation must be constructed with "
-               "multilevel hierarchy"));
-    }
-
-  // Create the triangulations for the coarser levels
-  coarse_triangulations =
-    dealii::MGTransferGlobalCoarseningTools::create_geometric_coarsening_sequence(
-      this->triangulation_handler.get_triangulation());
-
-  // Placeholder for p-multigrid
-  const auto polynomial_coarsening_sequence =
-    dealii::MGTransferGlobalCoarseningTools::create_polynomial_coarsening_sequence(
-      current_dof_handler->get_fe().degree,
-      dealii::MGTransferGlobalCoarseningTools::PolynomialCoarseningSequenceType::
-        decrease_by_one);
-
-  // Create the levels where h is the refinement and p is the polynomial degree.
-  std::vector<std::pair<unsigned int, unsigned int>> levels;
-  for (unsigned int i = 0; i < coarse_triangulations.size(); ++i)
-    {
-      levels.emplace_back(i, polynomial_coarsening_sequence.back());
-    }
-
-  // Set the maximum and minimum levels for the multigrid based on the triangulation.
-  min_level = 0;
-  max_level = levels.size() - 1;
+  // Grab the hierarchy, which is only built by the first field that requests it
+  hierarchy = mg_hierarchy_handler.get_hierarchy(this->field_index);
+  min_level = hierarchy->get_min_level();
+  max_level = hierarchy->get_max_level();
 
   // Init the multilevel operator objects
-  mg_operators =
-    std::make_unique<dealii::MGLevelObject<LevelMatrixType>>(min_level,
-                                                             max_level,
-                                                             this->user_inputs,
-                                                             this->field_index,
-                                                             this->subset_attributes);
-  mg_transfer_operators.resize(min_level, max_level);
-
-  // Object for constraints on different levels
-  level_constraints.resize(min_level, max_level);
-  mg_matrix_free_handler.resize(min_level, max_level, this->user_inputs);
-
-  // Distribute DoFs for each level of the triangulation
-  mg_dof_handlers.resize(min_level, max_level);
+  mg_operators = std::make_unique<dealii::MGLevelObject<LevelMatrixType>>(min_level,
+                                                                          max_level);
   for (unsigned int level = min_level; level <= max_level; ++level)
     {
-      mg_dof_handlers[level].reinit(*coarse_triangulations[level]);
-
-      mg_dof_handlers[level].distribute_dofs(current_dof_handler->get_fe());
+      create_level_operator(level, hierarchy->get_level_degree(level));
     }
 
-  // Apply constraints on each level
-  for (unsigned int level = min_level; level <= max_level; ++level)
+  // Setup operator on each level
+  mg_src_vectors.clear();
+  mg_src_vectors.resize(this->newton_update_src.size());
+  for (auto &mg_src_vector : mg_src_vectors)
     {
-      level_constraints[level].clear();
-
-      const dealii::IndexSet locally_relevant_dofs =
-        dealii::DoFTools::extract_locally_relevant_dofs(mg_dof_handlers[level]);
-
-      level_constraints[level].reinit(locally_relevant_dofs);
-
-      dealii::DoFTools::make_hanging_node_constraints(mg_dof_handlers[level],
-                                                      level_constraints[level]);
-
-      // TODO: Fix for pinned points
-      const auto &boundary_condition =
-        this->user_inputs.boundary_parameters.boundary_condition_list.at(
-          this->field_index);
-      for (const auto &[component, condition] : boundary_condition)
-        {
-          for (const auto &[boundary_id, boundary_type] :
-               condition.boundary_condition_map)
-            {
-              // Create a mask. This is only applied for vector fields to apply boundary
-              // conditions to
-              // each component of the vector.
-              std::vector<bool> mask(dim, false);
-              mask.at(component) = true;
-
-              if (boundary_type == boundaryCondition::type::NATURAL)
-                {
-                  // Do nothing because they are naturally enforced.
-                  continue;
-                }
-              else if (boundary_type == boundaryCondition::type::DIRICHLET)
-                {
-                  if (this->user_inputs.var_attributes.at(this->field_index).field_type !=
-                      fieldType::VECTOR)
-                    {
-                      dealii::VectorTools::interpolate_boundary_values(
-                        mapping,
-                        mg_dof_handlers[level],
-                        boundary_id,
-                        dealii::Functions::ZeroFunction<dim, float>(1),
-                        level_constraints[level]);
-                    }
-                  else
-                    {
-                      dealii::VectorTools::interpolate_boundary_values(
-                        mapping,
-                        mg_dof_handlers[level],
-                        boundary_id,
-                        dealii::Functions::ZeroFunction<dim, float>(dim),
-                        level_constraints[level],
-                        mask);
-                    }
-                }
-              else if (boundary_type == boundaryCondition::type::PERIODIC)
-                {
-                  // Skip boundary ids that are odd since those map to the even faces
-                  if (boundary_id % 2 != 0)
-                    {
-                      continue;
-                    }
-                  // Create a vector of matched pairs that we fill and enforce upon the
-                  // constaints
-                  std::vector<dealii::GridTools::PeriodicFacePair<
-                    typename dealii::DoFHandler<dim>::cell_iterator>>
-                    periodicity_vector;
-
-                  // Determine the direction
-                  const auto direction =
-                    static_cast<unsigned int>(std::floor(boundary_id / dim));
-
-                  // Collect the matched pairs on the coarsest level of the mesh
-                  dealii::GridTools::collect_periodic_faces(mg_dof_handlers[level],
-                                                            boundary_id,
-                                                            boundary_id + 1,
-                                                            direction,
-                                                            periodicity_vector);
-
-                  // Set constraints
-                  if (this->user_inputs.var_attributes.at(this->field_index).field_type !=
-                      fieldType::VECTOR)
-                    {
-                      dealii::DoFTools::make_periodicity_constraints<dim, dim>(
-                        periodicity_vector,
-                        level_constraints[level]);
-                    }
-                  else
-                    {
-                      dealii::DoFTools::make_periodicity_constraints<dim, dim>(
-                        periodicity_vector,
-                        level_constraints[level],
-                        mask);
-                    }
-                }
-              else if (boundary_type == boundaryCondition::type::NEUMANN)
-                {
-                  Assert(false, FeatureNotImplemented("Neumann boundary conditions"));
-                }
-              else if (boundary_type == boundaryCondition::type::NON_UNIFORM_DIRICHLET)
-                {
-                  if (this->user_inputs.var_attributes.at(this->field_index).field_type !=
-                      fieldType::VECTOR)
-                    {
-                      dealii::VectorTools::interpolate_boundary_values(
-                        mapping,
-                        mg_dof_handlers[level],
-                        boundary_id,
-                        dealii::Functions::ZeroFunction<dim, float>(1),
-                        level_constraints[level]);
-                    }
-                  else
-                    {
-                      dealii::VectorTools::interpolate_boundary_values(
-                        mapping,
-                        mg_dof_handlers[level],
-                        boundary_id,
-                        dealii::Functions::ZeroFunction<dim, float>(dim),
-                        level_constraints[level],
-                        mask);
-                    }
-                }
-              else if (boundary_type == boundaryCondition::type::NON_UNIFORM_NEUMANN)
-                {
-                  Assert(false,
-                         FeatureNotImplemented("Nonuniform neumann boundary conditions"));
-                }
-            }
-        }
-      level_constraints[level].close();
+      mg_src_vector.resize(min_level, max_level);
     }
-
-  // Setup operator on each level
   mg_newton_update_src.resize(min_level, max_level);
+  transferred_versions.clear();
   for (unsigned int level = min_level; level <= max_level; ++level)
     {
-      // TODO: Fix so mapping is same as rest of the problem. Do the same for the finite
-      // element I think.
-      // TODO: Fix so that we include all DoF handlers and constraints and select only the
-      // ones we need.
-      mg_matrix_free_handler[level].reinit(mapping,
-                                           mg_dof_handlers[level],
-                                           level_constraints[level],
-                                           dealii::QGaussLobatto<1>(degree + 1));
-
-      (*mg_operators)[level].initialize(mg_matrix_free_handler[level].get_matrix_free());
+      (*mg_operators)[level].initialize(hierarchy->get_matrix_free(level));
 
       (*mg_operators)[level].add_global_to_local_mapping(
         this->newton_update_global_to_local_solution);
@@ -410,7 +266,7 @@ GMGSolver<dim, degree>::init()
       mg_newton_update_src[level].resize(this->newton_update_src.size());
       for (const auto &[pair, local_index] : this->newton_update_global_to_local_solution)
         {
-          mg_newton_update_src[level][local_index] = new MGVectorType();
+          mg_newton_update_src[level][local_index] = &mg_src_vectors[local_index][level];
           (*mg_operators)[level]
             .initialize_dof_vector(*mg_newton_update_src[level][local_index], pair.first);
         }
@@ -430,17 +286,6 @@ GMGSolver<dim, degree>::init()
     }
   mg_matrix = std::make_shared<dealii::mg::Matrix<MGVectorType>>(*mg_operators);
 
-  // Setup transfer operators
-  for (unsigned int level = min_level; level < max_level; ++level)
-    {
-      mg_transfer_operators[level + 1].reinit(mg_dof_handlers[level + 1],
-                                              mg_dof_handlers[level],
-                                              level_constraints[level + 1],
-                                              level_constraints[level]);
-    }
-  mg_transfer = std::make_shared<dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>(
-    mg_transfer_operators);
-
   this->system_matrix->clear();
   this->system_matrix->initialize(this->matrix_free_handler.get_matrix_free());
   this->update_system_matrix->clear();
@@ -454,146 +299,303 @@ GMGSolver<dim, degree>::init()
     this->newton_update_global_to_local_solution);
   this->update_system_matrix->add_src_solution_subset(this->newton_update_src);
 
+  // Set up the single precision operator, if mixed precision is enabled
+  this->init_mixed_precision();
+
   // Apply constraints
   this->constraint_handler.get_constraint(this->field_index)
     .distribute(*(this->solution_handler.solution_set.at(
       std::make_pair(this->field_index, dependencyType::NORMAL))));
-
-#ifdef DEBUG
-  conditionalOStreams::pout_summary()
-    << "\nMultigrid Setup Information for index " << this->field_index << ":\n"
-    << "  Min level: " << min_level << "\n"
-    << "  Max level: " << max_level << "\n";
-  for (unsigned int level = min_level; level <= max_level; ++level)
-    {
-      conditionalOStreams::pout_summary()
-        << "  Level: " << level << "\n"
-        << "    Cells: " << coarse_triangulations[level]->n_global_active_cells() << "\n"
-        << "    DoFs: " << mg_dof_handlers[level].n_dofs() << "\n"
-        << "    Constrained DoFs: " << level_constraints[level].n_constraints() << "\n";
-    }
-  conditionalOStreams::pout_summary()
-    << "  MG vertical communication efficiency: "
-    << dealii::MGTools::vertical_communication_efficiency(coarse_triangulations) << "\n"
-    << "  MG workload imbalance: "
-    << dealii::MGTools::workload_imbalance(coarse_triangulations) << "\n\n"
-    << std::flush;
-#endif
 }
 
 template <int dim, int degree>
 inline void
 GMGSolver<dim, degree>::reinit()
-{}
+{
+  // Tear down the hierarchy from the top, so that no object outlives the ones it
+  // subscribes to. The shared hierarchy of the old mesh is destroyed once every field
+  // has released it, and the first field to call init() builds the new one.
+  preconditioner.reset();
+  mg.reset();
+  mg_coarse.reset();
+  coarse_cg.reset();
+  coarse_solver_control.reset();
+  mg_smoother.reset();
+  mg_matrix.reset();
+  mg_operators.reset();
+  mg_src_vectors.clear();
+  mg_newton_update_src.resize(0, 0);
+  hierarchy.reset();
+
+  init();
+  this->clear_solve_history();
+}
 
 template <int dim, int degree>
 inline void
 GMGSolver<dim, degree>::solve(const double step_length)
 {
   const auto *current_dof_handler = dof_handler.const_dof_handlers.at(this->field_index);
-  auto       *solution            = this->solution_handler.solution_set.at(
-    std::make_pair(this->field_index, dependencyType::NORMAL));
 
-  // Compute the residual
-  this->system_matrix->compute_residual(*this->residual, *solution);
+  // Compute the residual, unless it is already up to date
+  this->update_residual();
   conditionalOStreams::pout_summary()
-    << "  field: " << this->field_index
-    << " Initial residual: " << this->residual->l2_norm() << std::flush;
+    << "  field: " << this->field_index << " Initial residual: " << this->residual_norm
+    << std::flush;
 
   // Determine the residual tolerance
   this->compute_solver_tolerance();
 
   // Update solver controls
   this->solver_control.set_tolerance(this->tolerance);
-  dealii::SolverCG<VectorType> cg(this->solver_control);
 
-  // Interpolate the newton update src vector to each multigrid level
-  for (unsigned int local_index = 0; local_index < this->newton_update_src.size();
-       local_index++)
+  // Interpolate the newton update src vectors to each multigrid level, skipping the
+  // fields that haven't changed since the last transfer. The change term is given by the
+  // src vector of the level operators, so it doesn't have to be transferred.
+  for (const auto &[pair, local_index] : this->newton_update_global_to_local_solution)
     {
-      // Create a temporary collection of the the dst pointers
-      dealii::MGLevelObject<MGVectorType> mg_src_subset(min_level, max_level);
-      for (unsigned int level = min_level; level < max_level; ++level)
+      if (pair.second == dependencyType::CHANGE)
         {
-          mg_src_subset[level] = *mg_newton_update_src[level][local_index];
+          continue;
         }
 
-      // Interpolate
-      mg_transfer->interpolate_to_mg(*current_dof_handler,
-                                     mg_src_subset,
-                                     *this->newton_update_src[local_index]);
-    }
+      const unsigned int version  = this->solution_handler.get_version(pair.first);
+      const auto         iterator = transferred_versions.find(pair.first);
+      if (iterator != transferred_versions.end() && iterator->second == version)
+        {
+          continue;
+        }
 
-  // Create smoother for each level
-  using SmootherType = dealii::PreconditionChebyshev<LevelMatrixType, MGVectorType>;
-  dealii::MGSmootherPrecondition<LevelMatrixType, SmootherType, MGVectorType> mg_smoother;
-  dealii::MGLevelObject<typename SmootherType::AdditionalData> smoother_data(min_level,
-                                                                             max_level);
-  for (unsigned int level = min_level; level <= max_level; ++level)
+      hierarchy->get_transfer().interpolate_to_mg(*current_dof_handler,
+                                                  mg_src_vectors[local_index],
+                                                  *this->newton_update_src[local_index]);
+    }
+  for (const auto &[pair, local_index] : this->newton_update_global_to_local_solution)
     {
-      smoother_data[level].smoothing_range =
-        this->user_inputs.linear_solve_parameters.linear_solve.at(this->field_index)
-          .smoothing_range;
-      smoother_data[level].degree =
-        this->user_inputs.linear_solve_parameters.linear_solve.at(this->field_index)
-          .smoother_degree;
-      smoother_data[level].eig_cg_n_iterations =
-        this->user_inputs.linear_solve_parameters.linear_solve.at(this->field_index)
-          .eig_cg_n_iterations;
-      (*mg_operators)[level].compute_diagonal(this->field_index);
-      smoother_data[level].preconditioner =
-        (*mg_operators)[level].get_matrix_diagonal_inverse();
-      smoother_data[level].constraints.copy_from(level_constraints[level]);
+      transferred_versions[pair.first] = this->solution_handler.get_version(pair.first);
     }
-  mg_smoother.initialize(*mg_operators, smoother_data);
-
-  dealii::MGCoarseGridApplySmoother<MGVectorType> mg_coarse;
-  mg_coarse.initialize(mg_smoother);
 
-  // Create multigrid object
-  dealii::Multigrid<MGVectorType> mg(*mg_matrix,
-                                     mg_coarse,
-                                     *mg_transfer,
-                                     mg_smoother,
-                                     mg_smoother,
-                                     min_level,
-                                     max_level,
-                                     dealii::Multigrid<MGVectorType>::Cycle::v_cycle);
-
-  // Create the preconditioner
-  dealii::PreconditionMG<dim,
-                         MGVectorType,
-                         dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>
-    preconditioner(*current_dof_handler, mg, *mg_transfer);
+  // Rebuild the preconditioner if it is out of date
+  double setup_time = 0.0;
+  if (!preconditioner || this->preconditioner_is_stale())
+    {
+      dealii::Timer setup_timer;
+      timer::serial_timer().enter_subsection("GMG setup");
+      setup_preconditioner();
+      timer::serial_timer().leave_subsection("GMG setup");
+      setup_time = setup_timer.wall_time();
+    }
 
+  dealii::Timer solve_timer;
+  timer::serial_timer().enter_subsection("GMG solve");
   try
     {
-      *this->newton_update = 0.0;
-      cg.solve(*(this->update_system_matrix),
-               *this->newton_update,
-               *this->residual,
-               preconditioner);
+      this->solve_newton_update(*preconditioner);
     }
   catch (...)
     {
       conditionalOStreams::pout_base()
         << "Warning: linear solver did not converge as per set tolerances.\n";
     }
-  this->constraint_handler.get_constraint(this->field_index)
-    .set_zero(*this->newton_update);
+  timer::serial_timer().leave_subsection("GMG solve");
+
+  this->record_preconditioner_use();
 
   conditionalOStreams::pout_summary()
     << " Final residual: " << this->solver_control.last_value()
-    << " Steps: " << this->solver_control.last_step() << "\n"
+    << " Steps: " << this->solver_control.last_step() << " Setup time: " << setup_time
+    << " Solve time: " << solve_timer.wall_time() << "\n"
     << std::flush;
 
-  // Update the solutions
-  (*solution).add(step_length, *this->newton_update);
-  this->solution_handler.update(fieldSolveType::NONEXPLICIT_LINEAR, this->field_index);
+  this->update_solution(step_length);
+}
 
-  // Apply constraints
-  // This may be redundant with the constraints on the update step.
-  this->constraint_handler.get_constraint(this->field_index).distribute(*solution);
+template <int dim, int degree>
+template <int level_degree>
+inline void
+GMGSolver<dim, degree>::create_level_operator(const unsigned int &level,
+                                              const unsigned int &fe_degree)
+{
+  if (fe_degree == level_degree)
+    {
+      (*mg_operators)[level].reinit(
+        std::make_unique<customPDE<dim, level_degree, float>>(this->user_inputs,
+                                                              this->field_index,
+                                                              this->subset_attributes));
+      return;
+    }
+
+  if constexpr (level_degree > 1)
+    {
+      create_level_operator<level_degree - 1>(level, fe_degree);
+    }
+  else
+    {
+      AssertThrow(false, UnreachableCode());
+    }
+}
+
+template <int dim, int degree>
+inline void
+GMGSolver<dim, degree>::setup_preconditioner()
+{
+  const auto *current_dof_handler = dof_handler.const_dof_handlers.at(this->field_index);
+  const auto &parameters =
+    this->user_inputs.linear_solve_parameters.linear_solve.at(this->field_index);
+
+  // The preconditioner holds references to the multigrid object, which in turn holds
+  // references to the smoothers, so we have to tear them down in that order.
+  preconditioner.reset();
+  mg.reset();
+  mg_coarse.reset();
+  coarse_cg.reset();
+  coarse_solver_control.reset();
+  mg_smoother.reset();
+
+  // Create the preconditioner of the smoother for each level, which is built from the
+  // level diagonal
+  switch (parameters.smoother_type)
+    {
+      case smootherType::JACOBI_SMOOTHER:
+        {
+          dealii::MGLevelObject<std::shared_ptr<dealii::DiagonalMatrix<MGVectorType>>>
+            level_preconditioners(min_level, max_level);
+          for (unsigned int level = min_level; level <= max_level; ++level)
+            {
+              (*mg_operators)[level].compute_diagonal(this->field_index);
+              level_preconditioners[level] =
+                (*mg_operators)[level].get_matrix_diagonal_inverse();
+            }
+          setup_smoother(level_preconditioners);
+          break;
+        }
+      case smootherType::CELL_PATCH_SMOOTHER:
+        {
+          dealii::MGLevelObject<std::shared_ptr<cellPatchInverse<dim, float>>>
+            level_preconditioners(min_level, max_level);
+          for (unsigned int level = min_level; level <= max_level; ++level)
+            {
+              (*mg_operators)[level].compute_diagonal(this->field_index);
+              level_preconditioners[level] =
+                std::make_shared<cellPatchInverse<dim, float>>();
+              level_preconditioners[level]->initialize(
+                (*mg_operators)[level].get_matrix_free(),
+                (*mg_operators)[level].get_matrix_diagonal_inverse()->get_vector(),
+                this->field_index);
+            }
+          setup_smoother(level_preconditioners);
+          break;
+        }
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+
+  // Create multigrid object
+  mg = std::make_unique<dealii::Multigrid<MGVectorType>>(
+    *mg_matrix,
+    *mg_coarse,
+    hierarchy->get_transfer(),
+    *mg_smoother,
+    *mg_smoother,
+    min_level,
+    max_level,
+    dealii::Multigrid<MGVectorType>::Cycle::v_cycle);
+
+  // Create the preconditioner
+  preconditioner = std::make_unique<
+    dealii::PreconditionMG<dim,
+                           MGVectorType,
+                           dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>>(
+    *current_dof_handler,
+    *mg,
+    hierarchy->get_transfer());
+
+  this->n_solves_since_setup = 0;
+}
+
+template <int dim, int degree>
+template <typename LevelPreconditionerType>
+inline void
+GMGSolver<dim, degree>::setup_smoother(
+  const dealii::MGLevelObject<std::shared_ptr<LevelPreconditionerType>>
+    &level_preconditioners)
+{
+  using LevelSmootherType = SmootherType<LevelPreconditionerType>;
+
+  const auto &parameters =
+    this->user_inputs.linear_solve_parameters.linear_solve.at(this->field_index);
+
+  // Create smoother for each level
+  dealii::MGLevelObject<typename LevelSmootherType::AdditionalData> smoother_data(
+    min_level,
+    max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      smoother_data[level].smoothing_range     = parameters.smoothing_range;
+      smoother_data[level].degree              = parameters.smoother_degree;
+      smoother_data[level].eig_cg_n_iterations = parameters.eig_cg_n_iterations;
+      smoother_data[level].preconditioner      = level_preconditioners[level];
+      smoother_data[level].constraints.copy_from(hierarchy->get_constraint(level));
+    }
+  auto smoother = std::make_unique<
+    dealii::MGSmootherPrecondition<LevelMatrixType, LevelSmootherType, MGVectorType>>();
+  smoother->initialize(*mg_operators, smoother_data);
+
+  // The Chebyshev smoothers estimate the eigenvalues lazily on their first application.
+  // Do it here instead, so that it counts towards the setup and not the solve.
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      MGVectorType temp;
+      (*mg_operators)[level].initialize_dof_vector(temp, this->field_index);
+      smoother->smoothers[level].estimate_eigenvalues(temp);
+    }
+
+  // Create the coarse grid solver
+  switch (parameters.coarse_solver)
+    {
+      case coarseSolverType::COARSE_SMOOTHER:
+        {
+          auto coarse_smoother =
+            std::make_unique<dealii::MGCoarseGridApplySmoother<MGVectorType>>();
+          coarse_smoother->initialize(*smoother);
+          mg_coarse = std::move(coarse_smoother);
+          break;
+        }
+      case coarseSolverType::COARSE_CG:
+        {
+          // Precondition the coarse CG with the Chebyshev smoother of that level
+          coarse_solver_control =
+            std::make_unique<dealii::ReductionControl>(parameters.coarse_max_iterations,
+                                                       std::numeric_limits<double>::min(),
+                                                       parameters.coarse_tolerance);
+          coarse_cg = std::make_unique<dealii::SolverCG<MGVectorType>>(
+            *coarse_solver_control);
+          mg_coarse = std::make_unique<
+            dealii::MGCoarseGridIterativeSolver<MGVectorType,
+                                                dealii::SolverCG<MGVectorType>,
+                                                LevelMatrixType,
+                                                LevelSmootherType>>(
+            *coarse_cg,
+            (*mg_operators)[min_level],
+            smoother->smoothers[min_level]);
+          break;
+        }
+      case coarseSolverType::COARSE_AMG:
+      case coarseSolverType::COARSE_DIRECT:
+        {
+          auto coarse_solver = std::make_unique<mgCoarseGridSolver<dim>>(parameters);
+          coarse_solver->initialize((*mg_operators)[min_level],
+                                    hierarchy->get_dof_handler(min_level),
+                                    hierarchy->get_constraint(min_level),
+                                    this->field_index);
+          mg_coarse = std::move(coarse_solver);
+          break;
+        }
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+
+  mg_smoother = std::move(smoother);
 }
 
 PRISMS_PF_END_NAMESPACE
@@ -5,7 +5,6 @@
 #define linear_solver_identity_h
 
 #include <deal.II/lac/precondition.h>
-#include <deal.II/lac/solver_cg.h>
 #include <deal.II/matrix_free/matrix_free.h>
 
 #include <prismspf/config.h>
@@ -92,6 +91,9 @@ identitySolver<dim, degree>::init()
     this->newton_update_global_to_local_solution);
   this->update_system_matrix->add_src_solution_subset(this->newton_update_src);
 
+  // Set up the single precision operator, if mixed precision is enabled
+  this->init_mixed_precision();
+
   // Apply constraints
   this->constraint_handler.get_constraint(this->field_index)
     .distribute(*(this->solution_handler.solution_set.at(
@@ -101,56 +103,45 @@ identitySolver<dim, degree>::init()
 template <int dim, int degree>
 inline void
 identitySolver<dim, degree>::reinit()
-{}
+{
+  // The operators and vectors are rebuilt on the new matrix-free object, so the state
+  // of the previous solves no longer applies
+  init();
+  this->clear_solve_history();
+}
 
 template <int dim, int degree>
 inline void
 identitySolver<dim, degree>::solve(const double step_length)
 {
-  auto *solution = this->solution_handler.solution_set.at(
-    std::make_pair(this->field_index, dependencyType::NORMAL));
-
-  // Compute the residual
-  this->system_matrix->compute_residual(*this->residual, *solution);
+  // Compute the residual, unless it is already up to date
+  this->update_residual();
   conditionalOStreams::pout_summary()
-    << "  field: " << this->field_index
-    << " Initial residual: " << this->residual->l2_norm() << std::flush;
+    << "  field: " << this->field_index << " Initial residual: " << this->residual_norm
+    << std::flush;
 
   // Determine the residual tolerance
   this->compute_solver_tolerance();
 
   // Update solver controls
   this->solver_control.set_tolerance(this->tolerance);
-  dealii::SolverCG<VectorType> cg(this->solver_control);
 
   try
     {
-      *this->newton_update = 0.0;
-      cg.solve(*(this->update_system_matrix),
-               *this->newton_update,
-               *this->residual,
-               dealii::PreconditionIdentity());
+      this->solve_newton_update(dealii::PreconditionIdentity());
     }
   catch (...)
     {
       conditionalOStreams::pout_base()
         << "Warning: linear solver did not converge as per set tolerances.\n";
     }
-  this->constraint_handler.get_constraint(this->field_index)
-    .set_zero(*this->newton_update);
 
   conditionalOStreams::pout_summary()
     << " Final residual: " << this->solver_control.last_value()
     << " Steps: " << this->solver_control.last_step() << "\n"
     << std::flush;
 
-  // Update the solutions
-  (*solution).add(step_length, *this->newton_update);
-  this->solution_handler.update(fieldSolveType::NONEXPLICIT_LINEAR, this->field_index);
-
-  // Apply constraints
-  // This may be redundant with the constraints on the update step.
-  this->constraint_handler.get_constraint(this->field_index).distribute(*solution);
+  this->update_solution(step_length);
 }
 
 PRISMS_PF_END_NAMESPACE
@@ -0,0 +1,275 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef linear_solver_jacobi_h
+#define linear_solver_jacobi_h
+
+#include <deal.II/base/timer.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/solvers/cell_patch_inverse.h>
+#include <prismspf/solvers/linear_solver_base.h>
+
+#include <memory>
+
+#ifdef PRISMS_PF_WITH_CALIPER
+#  include <caliper/cali.h>
+#endif
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Class that handles the assembly and solving of a field with a preconditioner
+ * built from the diagonal of the matrix-free operator. This is either point-Jacobi,
+ * Chebyshev acceleration of point-Jacobi, or the cell patch preconditioner, which are
+ * much cheaper to set up than GMG.
+ */
+template <int dim, int degree>
+class jacobiSolver : public linearSolverBase<dim, degree>
+{
+public:
+  using SystemMatrixType = customPDE<dim, degree, double>;
+  using VectorType       = dealii::LinearAlgebra::distributed::Vector<double>;
+  using ChebyshevType    = dealii::PreconditionChebyshev<SystemMatrixType, VectorType>;
+
+  /**
+   * \brief Constructor.
+   */
+  jacobiSolver(const userInputParameters<dim> &_user_inputs,
+               const variableAttributes       &_variable_attributes,
+               const matrixfreeHandler<dim>   &_matrix_free_handler,
+               const constraintHandler<dim>   &_constraint_handler,
+               solutionHandler<dim>           &_solution_handler);
+
+  /**
+   * \brief Destructor.
+   */
+  ~jacobiSolver() override = default;
+
+  /**
+   * \brief Initialize the system.
+   */
+  void
+  init() override;
+
+  /**
+   * \brief Reinitialize the system.
+   */
+  void
+  reinit() override;
+
+  /**
+   * \brief Solve the system Ax=b.
+   */
+  void
+  solve(const double step_length = 1.0) override;
+
+  /**
+   * \brief Get the inverse diagonal of the operator for batched solves. It is rebuilt
+   * first if it is out of date.
+   */
+  [[nodiscard]] const VectorType &
+  get_inverse_diagonal();
+
+private:
+  /**
+   * \brief Compute the inverse diagonal of the operator and, for the Chebyshev
+   * preconditioner, estimate its eigenvalues. For the cell patch preconditioner, the
+   * inverse diagonal is used to fit the cell blocks.
+   */
+  void
+  setup_preconditioner();
+
+  /**
+   * \brief Inverse diagonal of the operator.
+   */
+  std::shared_ptr<dealii::DiagonalMatrix<VectorType>> inverse_diagonal;
+
+  /**
+   * \brief Chebyshev preconditioner.
+   */
+  std::unique_ptr<ChebyshevType> chebyshev;
+
+  /**
+   * \brief Cell patch preconditioner.
+   */
+  std::unique_ptr<cellPatchInverse<dim, double>> cell_patch;
+};
+
+template <int dim, int degree>
+jacobiSolver<dim, degree>::jacobiSolver(
+  const userInputParameters<dim> &_user_inputs,
+  const variableAttributes       &_variable_attributes,
+  const matrixfreeHandler<dim>   &_matrix_free_handler,
+  const constraintHandler<dim>   &_constraint_handler,
+  solutionHandler<dim>           &_solution_handler)
+  : linearSolverBase<dim, degree>(_user_inputs,
+                                  _variable_attributes,
+                                  _matrix_free_handler,
+                                  _constraint_handler,
+                                  _solution_handler)
+{}
+
+template <int dim, int degree>
+inline void
+jacobiSolver<dim, degree>::init()
+{
+  this->system_matrix->clear();
+  this->system_matrix->initialize(this->matrix_free_handler.get_matrix_free());
+  this->update_system_matrix->clear();
+  this->update_system_matrix->initialize(this->matrix_free_handler.get_matrix_free());
+
+  this->system_matrix->add_global_to_local_mapping(
+    this->residual_global_to_local_solution);
+  this->system_matrix->add_src_solution_subset(this->residual_src);
+
+  this->update_system_matrix->add_global_to_local_mapping(
+    this->newton_update_global_to_local_solution);
+  this->update_system_matrix->add_src_solution_subset(this->newton_update_src);
+
+  // Apply constraints
+  this->constraint_handler.get_constraint(this->field_index)
+    .distribute(*(this->solution_handler.solution_set.at(
+      std::make_pair(this->field_index, dependencyType::NORMAL))));
+
+  // Clearing the operators invalidates the preconditioner
+  chebyshev.reset();
+  cell_patch.reset();
+  inverse_diagonal.reset();
+}
+
+template <int dim, int degree>
+inline void
+jacobiSolver<dim, degree>::reinit()
+{
+  // The operators and vectors are rebuilt on the new matrix-free object, so the state
+  // of the previous solves no longer applies
+  init();
+  this->clear_solve_history();
+}
+
+template <int dim, int degree>
+inline void
+jacobiSolver<dim, degree>::solve(const double step_length)
+{
+  // Compute the residual, unless it is already up to date
+  this->update_residual();
+  conditionalOStreams::pout_summary()
+    << "  field: " << this->field_index << " Initial residual: " << this->residual_norm
+    << std::flush;
+
+  // Determine the residual tolerance
+  this->compute_solver_tolerance();
+
+  // Update solver controls
+  this->solver_control.set_tolerance(this->tolerance);
+
+  // Rebuild the preconditioner if it is out of date
+  double setup_time = 0.0;
+  if (!inverse_diagonal || this->preconditioner_is_stale())
+    {
+      dealii::Timer setup_timer;
+      setup_preconditioner();
+      setup_time = setup_timer.wall_time();
+    }
+
+  try
+    {
+      if (chebyshev)
+        {
+          this->solve_newton_update(*chebyshev);
+        }
+      else if (cell_patch)
+        {
+          this->solve_newton_update(*cell_patch);
+        }
+      else
+        {
+          this->solve_newton_update(*inverse_diagonal);
+        }
+    }
+  catch (...)
+    {
+      conditionalOStreams::pout_base()
+        << "Warning: linear solver did not converge as per set tolerances.\n";
+    }
+
+  this->record_preconditioner_use();
+
+  conditionalOStreams::pout_summary()
+    << " Final residual: " << this->solver_control.last_value()
+    << " Steps: " << this->solver_control.last_step() << " Setup time: " << setup_time
+    << "\n"
+    << std::flush;
+
+  this->update_solution(step_length);
+}
+
+template <int dim, int degree>
+inline const typename jacobiSolver<dim, degree>::VectorType &
+jacobiSolver<dim, degree>::get_inverse_diagonal()
+{
+  if (!inverse_diagonal || this->preconditioner_is_stale())
+    {
+      setup_preconditioner();
+    }
+
+  return inverse_diagonal->get_vector();
+}
+
+template <int dim, int degree>
+inline void
+jacobiSolver<dim, degree>::setup_preconditioner()
+{
+  const auto &parameters =
+    this->user_inputs.linear_solve_parameters.linear_solve.at(this->field_index);
+
+  Assert(parameters.preconditioner == preconditionerType::JACOBI ||
+           parameters.preconditioner == preconditionerType::CHEBYSHEV ||
+           parameters.preconditioner == preconditionerType::CELL_PATCH,
+         dealii::ExcMessage(
+           "The preconditioner must be JACOBI, CHEBYSHEV, or CELL_PATCH."));
+
+  // The Chebyshev preconditioner holds a pointer to the diagonal, so it goes first
+  chebyshev.reset();
+  cell_patch.reset();
+
+  this->update_system_matrix->compute_diagonal(this->field_index);
+  inverse_diagonal = this->update_system_matrix->get_matrix_diagonal_inverse();
+
+  if (parameters.preconditioner == preconditionerType::CHEBYSHEV)
+    {
+      typename ChebyshevType::AdditionalData chebyshev_data;
+      chebyshev_data.smoothing_range     = parameters.smoothing_range;
+      chebyshev_data.degree              = parameters.smoother_degree;
+      chebyshev_data.eig_cg_n_iterations = parameters.eig_cg_n_iterations;
+      chebyshev_data.preconditioner      = inverse_diagonal;
+      chebyshev_data.constraints.copy_from(
+        this->constraint_handler.get_constraint(this->field_index));
+
+      chebyshev = std::make_unique<ChebyshevType>();
+      chebyshev->initialize(*(this->update_system_matrix), chebyshev_data);
+
+      // Estimate the eigenvalues here rather than lazily on the first application
+      VectorType temp;
+      this->update_system_matrix->initialize_dof_vector(temp, this->field_index);
+      chebyshev->estimate_eigenvalues(temp);
+    }
+  else if (parameters.preconditioner == preconditionerType::CELL_PATCH)
+    {
+      cell_patch = std::make_unique<cellPatchInverse<dim, double>>();
+      cell_patch->initialize(this->update_system_matrix->get_matrix_free(),
+                             inverse_diagonal->get_vector(),
+                             this->field_index);
+    }
+
+  this->n_solves_since_setup = 0;
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
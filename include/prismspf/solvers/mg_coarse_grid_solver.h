@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef mg_coarse_grid_solver_h
+#define mg_coarse_grid_solver_h
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/component_mask.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparsity_tools.h>
+#include <deal.II/multigrid/mg_base.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/solvers/mg_level_operator.h>
+#include <prismspf/user_inputs/linear_solve_parameters.h>
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+#  include <deal.II/lac/solver_cg.h>
+#  include <deal.II/lac/trilinos_precondition.h>
+#  include <deal.II/lac/trilinos_solver.h>
+#elif defined(PRISMS_PF_WITH_PETSC)
+#  include <deal.II/lac/petsc_precondition.h>
+#  include <deal.II/lac/petsc_solver.h>
+#  include <deal.II/lac/petsc_vector.h>
+#endif
+
+#include <limits>
+#include <memory>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Coarse grid solver for the GMG preconditioner that assembles the operator of the
+ * coarsest level into a sparse matrix. The system is then solved either with CG and an
+ * algebraic multigrid preconditioner or with a sparse direct solver. The matrix-free
+ * level operators work in single precision, so the vectors are converted to and from
+ * double precision for each solve.
+ */
+template <int dim>
+class mgCoarseGridSolver
+  : public dealii::MGCoarseGridBase<dealii::LinearAlgebra::distributed::Vector<float>>
+{
+public:
+  using VectorType      = dealii::LinearAlgebra::distributed::Vector<double>;
+  using MGVectorType    = dealii::LinearAlgebra::distributed::Vector<float>;
+  using LevelMatrixType = mgLevelOperator<dim, float>;
+
+  /**
+   * \brief Constructor.
+   */
+  explicit mgCoarseGridSolver(const linearSolverParameters &_parameters);
+
+  /**
+   * \brief Assemble the coarse operator and set up the AMG preconditioner or factorize
+   * the matrix.
+   */
+  void
+  initialize(const LevelMatrixType                  &level_operator,
+             const dealii::DoFHandler<dim>          &dof_handler,
+             const dealii::AffineConstraints<float> &constraints,
+             unsigned int                            field_index);
+
+  /**
+   * \brief Solve the coarse system.
+   */
+  void
+  operator()(const unsigned int  level,
+             MGVectorType       &dst,
+             const MGVectorType &src) const override;
+
+private:
+  /**
+   * \brief Linear solver parameters of the field.
+   */
+  const linearSolverParameters &parameters;
+
+  /**
+   * \brief Solver control for the coarse solves.
+   */
+  mutable dealii::ReductionControl solver_control;
+
+  /**
+   * \brief Locally owned DoFs of the coarse level.
+   */
+  dealii::IndexSet locally_owned_dofs;
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+  /**
+   * \brief Assembled coarse operator.
+   */
+  typename LevelMatrixType::SparseMatrixType matrix;
+
+  /**
+   * \brief Algebraic multigrid preconditioner.
+   */
+  dealii::TrilinosWrappers::PreconditionAMG amg;
+
+  /**
+   * \brief Sparse direct solver.
+   */
+  std::unique_ptr<dealii::TrilinosWrappers::SolverDirect> direct_solver;
+
+  /**
+   * \brief Double precision copies of the src and dst vectors.
+   */
+  mutable VectorType src_copy;
+  mutable VectorType dst_copy;
+#elif defined(PRISMS_PF_WITH_PETSC)
+  /**
+   * \brief Assembled coarse operator.
+   */
+  typename LevelMatrixType::SparseMatrixType matrix;
+
+  /**
+   * \brief Algebraic multigrid preconditioner.
+   */
+  dealii::PETScWrappers::PreconditionBoomerAMG amg;
+
+  /**
+   * \brief Sparse direct solver. It keeps its KSP object between solves, so the
+   * factorization of the unchanged matrix is reused.
+   */
+  mutable std::unique_ptr<dealii::PETScWrappers::SparseDirectMUMPS> direct_solver;
+
+  /**
+   * \brief PETSc copies of the src and dst vectors.
+   */
+  mutable dealii::PETScWrappers::MPI::Vector src_copy;
+  mutable dealii::PETScWrappers::MPI::Vector dst_copy;
+#endif
+};
+
+template <int dim>
+mgCoarseGridSolver<dim>::mgCoarseGridSolver(const linearSolverParameters &_parameters)
+  : parameters(_parameters)
+  , solver_control(_parameters.coarse_max_iterations,
+                   std::numeric_limits<double>::min(),
+                   _parameters.coarse_tolerance)
+{}
+
+template <int dim>
+inline void
+mgCoarseGridSolver<dim>::initialize(
+  [[maybe_unused]] const LevelMatrixType                  &level_operator,
+  [[maybe_unused]] const dealii::DoFHandler<dim>          &dof_handler,
+  [[maybe_unused]] const dealii::AffineConstraints<float> &constraints,
+  [[maybe_unused]] unsigned int                            field_index)
+{
+  Assert(parameters.coarse_solver == coarseSolverType::COARSE_AMG ||
+           parameters.coarse_solver == coarseSolverType::COARSE_DIRECT,
+         dealii::ExcMessage("The coarse grid solver must be AMG or DIRECT."));
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+  const MPI_Comm communicator = dof_handler.get_communicator();
+
+  locally_owned_dofs = dof_handler.locally_owned_dofs();
+  const dealii::IndexSet locally_relevant_dofs =
+    dealii::DoFTools::extract_locally_relevant_dofs(dof_handler);
+
+  // The matrix is assembled in double precision
+  dealii::AffineConstraints<double> matrix_constraints;
+  matrix_constraints.copy_from(constraints);
+
+  dealii::DynamicSparsityPattern dsp(locally_relevant_dofs);
+  dealii::DoFTools::make_sparsity_pattern(dof_handler, dsp, matrix_constraints, false);
+  dealii::SparsityTools::distribute_sparsity_pattern(dsp,
+                                                     locally_owned_dofs,
+                                                     communicator,
+                                                     locally_relevant_dofs);
+  matrix.reinit(locally_owned_dofs, locally_owned_dofs, dsp, communicator);
+
+  level_operator.compute_system_matrix(matrix, matrix_constraints, field_index);
+
+  conditionalOStreams::pout_summary()
+    << "  Assembled coarse matrix with " << matrix.m() << " rows and "
+    << matrix.n_nonzero_elements() << " nonzeros\n"
+    << std::flush;
+#endif
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+  src_copy.reinit(level_operator.get_matrix_free()->get_vector_partitioner(field_index));
+  dst_copy.reinit(level_operator.get_matrix_free()->get_vector_partitioner(field_index));
+
+  if (parameters.coarse_solver == coarseSolverType::COARSE_AMG)
+    {
+      dealii::TrilinosWrappers::PreconditionAMG::AdditionalData amg_data;
+      amg_data.elliptic              = true;
+      amg_data.higher_order_elements = dof_handler.get_fe().degree > 1;
+      amg_data.smoother_sweeps       = 2;
+
+      // Vector fields need the constant mode of each component for the coarsening
+      const unsigned int n_components = dof_handler.get_fe().n_components();
+      if (n_components > 1)
+        {
+          dealii::DoFTools::extract_constant_modes(dof_handler,
+                                                   dealii::ComponentMask(n_components,
+                                                                         true),
+                                                   amg_data.constant_modes);
+        }
+      amg.initialize(matrix, amg_data);
+    }
+  else
+    {
+      direct_solver = std::make_unique<dealii::TrilinosWrappers::SolverDirect>(
+        solver_control);
+      direct_solver->initialize(matrix);
+    }
+#elif defined(PRISMS_PF_WITH_PETSC)
+  src_copy.reinit(locally_owned_dofs, communicator);
+  dst_copy.reinit(locally_owned_dofs, communicator);
+
+  if (parameters.coarse_solver == coarseSolverType::COARSE_AMG)
+    {
+      dealii::PETScWrappers::PreconditionBoomerAMG::AdditionalData amg_data;
+      amg_data.symmetric_operator = true;
+      amg.initialize(matrix, amg_data);
+    }
+  else
+    {
+      // Factorize the matrix here with a solve of a zero right-hand side, so that the
+      // coarse solves only do the triangular solves
+      direct_solver =
+        std::make_unique<dealii::PETScWrappers::SparseDirectMUMPS>(solver_control);
+      direct_solver->set_symmetric_mode(true);
+      src_copy = 0.0;
+      direct_solver->solve(matrix, dst_copy, src_copy);
+    }
+#else
+  AssertThrow(false,
+              dealii::ExcMessage(
+                "The AMG and direct coarse solvers require PRISMS-PF to be compiled with "
+                "PRISMS_PF_WITH_TRILINOS or PRISMS_PF_WITH_PETSC."));
+#endif
+}
+
+template <int dim>
+inline void
+mgCoarseGridSolver<dim>::operator()([[maybe_unused]] const unsigned int  level,
+                                    [[maybe_unused]] MGVectorType       &dst,
+                                    [[maybe_unused]] const MGVectorType &src) const
+{
+#if defined(PRISMS_PF_WITH_TRILINOS)
+  src_copy.copy_locally_owned_data_from(src);
+  dst_copy = 0.0;
+
+  if (parameters.coarse_solver == coarseSolverType::COARSE_AMG)
+    {
+      dealii::SolverCG<VectorType> cg(solver_control);
+      cg.solve(matrix, dst_copy, src_copy, amg);
+    }
+  else
+    {
+      direct_solver->solve(dst_copy, src_copy);
+    }
+
+  dst.copy_locally_owned_data_from(dst_copy);
+#elif defined(PRISMS_PF_WITH_PETSC)
+  for (const auto &index : locally_owned_dofs)
+    {
+      src_copy[index] = src[index];
+    }
+  src_copy.compress(dealii::VectorOperation::insert);
+  dst_copy = 0.0;
+
+  if (parameters.coarse_solver == coarseSolverType::COARSE_AMG)
+    {
+      dealii::PETScWrappers::SolverCG cg(solver_control);
+      cg.solve(matrix, dst_copy, src_copy, amg);
+    }
+  else
+    {
+      direct_solver->solve(matrix, dst_copy, src_copy);
+    }
+
+  for (const auto &index : locally_owned_dofs)
+    {
+      dst[index] = static_cast<float>(dst_copy[index]);
+    }
+#else
+  AssertThrow(false, UnreachableCode());
+#endif
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef mg_diagonal_block_operator_h
+#define mg_diagonal_block_operator_h
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attributes.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+#  include <deal.II/lac/trilinos_sparse_matrix.h>
+#elif defined(PRISMS_PF_WITH_PETSC)
+#  include <deal.II/lac/petsc_sparse_matrix.h>
+#endif
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * Forward declaration for user-implemented PDE class.
+ */
+template <int dim, int degree, typename number>
+class customPDE;
+
+/**
+ * \brief Diagonal block of the Jacobian of a set of co-nonlinear fields on a multigrid
+ * level.
+ *
+ * The user LHS of a co-nonlinear set is only available for all fields at once, so the
+ * block of a field is applied with the coupled operator, where the changes of the other
+ * fields are zero, and only the rows of the field are kept. Likewise, its diagonal is
+ * taken from the diagonal of all diagonal blocks.
+ *
+ * \tparam dim The number of dimensions in the problem.
+ * \tparam degree The polynomial degree of the shape functions.
+ * \tparam number Datatype to use. Either double or float.
+ */
+template <int dim, int degree, typename number>
+class mgDiagonalBlockOperator
+{
+public:
+  using SystemMatrixType = customPDE<dim, degree, number>;
+  using VectorType       = dealii::LinearAlgebra::distributed::Vector<number>;
+  using BlockVectorType  = dealii::LinearAlgebra::distributed::BlockVector<number>;
+  using size_type        = dealii::VectorizedArray<number>;
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+  using SparseMatrixType = dealii::TrilinosWrappers::SparseMatrix;
+#elif defined(PRISMS_PF_WITH_PETSC)
+  using SparseMatrixType = dealii::PETScWrappers::MPI::SparseMatrix;
+#endif
+
+  /**
+   * \brief Constructor. The block is the position of the field in the given field
+   * indices.
+   */
+  mgDiagonalBlockOperator(
+    const userInputParameters<dim>                   &_user_inputs,
+    const std::map<unsigned int, variableAttributes> &_subset_attributes,
+    const std::vector<unsigned int>                  &_field_indices,
+    const unsigned int                               &_block);
+
+  /**
+   * \brief Initialize operator.
+   */
+  void
+  initialize(std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data);
+
+  /**
+   * \brief Return the number of DoFs of the block.
+   */
+  [[nodiscard]] dealii::types::global_dof_index
+  m() const;
+
+  /**
+   * \brief Return the value of the matrix entry. This is only here so that we may
+   * compile.
+   */
+  [[nodiscard]] number
+  el(const unsigned int &row, const unsigned int &col) const;
+
+  /**
+   * \brief Initialize a given vector with the MatrixFree object of this operator.
+   */
+  void
+  initialize_dof_vector(VectorType &dst, unsigned int dof_handler_index) const;
+
+  /**
+   * \brief Get read access to the MatrixFree object of this operator.
+   */
+  [[nodiscard]] std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>>
+  get_matrix_free() const;
+
+  /**
+   * \brief Get read access to the inverse diagonal of the block.
+   */
+  [[nodiscard]] const std::shared_ptr<dealii::DiagonalMatrix<VectorType>> &
+  get_matrix_diagonal_inverse() const;
+
+  /**
+   * \brief Add the mappings from global to local solution vectors. The change terms map
+   * to the blocks.
+   */
+  void
+  add_global_to_local_mapping(
+    const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                             unsigned int,
+                             pairHash> &global_to_local_solution);
+
+  /**
+   * \brief Add the solution subset for src vector.
+   */
+  void
+  add_src_solution_subset(const std::vector<VectorType *> &src_solution_subset);
+
+  /**
+   * \brief Matrix-vector multiplication with the diagonal block.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * \brief Compute the inverse diagonal of the block.
+   */
+  void
+  compute_diagonal(unsigned int field_index);
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+  /**
+   * \brief Assemble the sparse matrix of the block. This is not implemented.
+   */
+  void
+  compute_system_matrix(SparseMatrixType                        &matrix,
+                        const dealii::AffineConstraints<double> &constraints,
+                        unsigned int                             field_index) const;
+#endif
+
+private:
+  /**
+   * \brief Global indices of the fields in the set.
+   */
+  std::vector<unsigned int> field_indices;
+
+  /**
+   * \brief Block of the field.
+   */
+  unsigned int block;
+
+  /**
+   * \brief Operator of the coupled Jacobian.
+   */
+  std::unique_ptr<SystemMatrixType> system_matrix;
+
+  /**
+   * \brief Source of the coupled operator. Only the block of the field is ever nonzero.
+   */
+  mutable BlockVectorType block_src;
+
+  /**
+   * \brief Destination of the coupled operator.
+   */
+  mutable BlockVectorType block_dst;
+
+  /**
+   * \brief Inverse diagonal of the block.
+   */
+  std::shared_ptr<dealii::DiagonalMatrix<VectorType>> inverse_diagonal_entries;
+};
+
+template <int dim, int degree, typename number>
+inline mgDiagonalBlockOperator<dim, degree, number>::mgDiagonalBlockOperator(
+  const userInputParameters<dim>                   &_user_inputs,
+  const std::map<unsigned int, variableAttributes> &_subset_attributes,
+  const std::vector<unsigned int>                  &_field_indices,
+  const unsigned int                               &_block)
+  : field_indices(_field_indices)
+  , block(_block)
+  , system_matrix(std::make_unique<SystemMatrixType>(_user_inputs, _subset_attributes))
+{
+  AssertIndexRange(block, field_indices.size());
+}
+
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::initialize(
+  std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data)
+{
+  system_matrix->initialize(data, field_indices);
+
+  block_src.reinit(field_indices.size());
+  block_dst.reinit(field_indices.size());
+  for (unsigned int i = 0; i < field_indices.size(); ++i)
+    {
+      data->initialize_dof_vector(block_src.block(i), field_indices[i]);
+      data->initialize_dof_vector(block_dst.block(i), field_indices[i]);
+    }
+  block_src.collect_sizes();
+  block_dst.collect_sizes();
+
+  inverse_diagonal_entries.reset();
+}
+
+template <int dim, int degree, typename number>
+inline dealii::types::global_dof_index
+mgDiagonalBlockOperator<dim, degree, number>::m() const
+{
+  return block_src.block(block).size();
+}
+
+template <int dim, int degree, typename number>
+inline number
+mgDiagonalBlockOperator<dim, degree, number>::el(
+  [[maybe_unused]] const unsigned int &row,
+  [[maybe_unused]] const unsigned int &col) const
+{
+  AssertThrow(false, FeatureNotImplemented("el()"));
+  return 0.0;
+}
+
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::initialize_dof_vector(
+  VectorType  &dst,
+  unsigned int dof_handler_index) const
+{
+  system_matrix->initialize_dof_vector(dst, dof_handler_index);
+}
+
+template <int dim, int degree, typename number>
+inline std::shared_ptr<const dealii::MatrixFree<
+  dim,
+  number,
+  typename mgDiagonalBlockOperator<dim, degree, number>::size_type>>
+mgDiagonalBlockOperator<dim, degree, number>::get_matrix_free() const
+{
+  return system_matrix->get_matrix_free();
+}
+
+template <int dim, int degree, typename number>
+inline const std::shared_ptr<dealii::DiagonalMatrix<
+  typename mgDiagonalBlockOperator<dim, degree, number>::VectorType>> &
+mgDiagonalBlockOperator<dim, degree, number>::get_matrix_diagonal_inverse() const
+{
+  return inverse_diagonal_entries;
+}
+
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::add_global_to_local_mapping(
+  const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                           unsigned int,
+                           pairHash> &global_to_local_solution)
+{
+  system_matrix->add_global_to_local_mapping(global_to_local_solution);
+}
+
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::add_src_solution_subset(
+  const std::vector<VectorType *> &src_solution_subset)
+{
+  system_matrix->add_src_solution_subset(src_solution_subset);
+}
+
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::vmult(VectorType       &dst,
+                                                    const VectorType &src) const
+{
+  // The other blocks of the source stay zero, so only the block of the field is copied
+  block_src.block(block).copy_locally_owned_data_from(src);
+  system_matrix->vmult(block_dst, block_src);
+  dst.copy_locally_owned_data_from(block_dst.block(block));
+}
+
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::compute_diagonal(
+  [[maybe_unused]] unsigned int field_index)
+{
+  Assert(field_index == field_indices[block],
+         dealii::ExcMessage("The diagonal must be computed for the field of the block"));
+
+  BlockVectorType inverse_diagonal;
+  inverse_diagonal.reinit(block_dst);
+  system_matrix->compute_block_diagonal(inverse_diagonal);
+
+  inverse_diagonal_entries = std::make_shared<dealii::DiagonalMatrix<VectorType>>();
+  inverse_diagonal_entries->get_vector().reinit(inverse_diagonal.block(block));
+  inverse_diagonal_entries->get_vector().copy_locally_owned_data_from(
+    inverse_diagonal.block(block));
+}
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+template <int dim, int degree, typename number>
+inline void
+mgDiagonalBlockOperator<dim, degree, number>::compute_system_matrix(
+  [[maybe_unused]] SparseMatrixType                        &matrix,
+  [[maybe_unused]] const dealii::AffineConstraints<double> &constraints,
+  [[maybe_unused]] unsigned int                             field_index) const
+{
+  AssertThrow(false,
+              FeatureNotImplemented(
+                "Assembly of the diagonal blocks of co-nonlinear fields"));
+}
+#endif
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -0,0 +1,412 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef mg_level_operator_h
+#define mg_level_operator_h
+
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attributes.h>
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+#  include <deal.II/lac/trilinos_sparse_matrix.h>
+#elif defined(PRISMS_PF_WITH_PETSC)
+#  include <deal.II/lac/petsc_sparse_matrix.h>
+#endif
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Operator of a single multigrid level.
+ *
+ * The polynomial degree of the matrix-free operators is a template parameter, so the
+ * levels of a polynomial coarsening sequence each have a different type. This class
+ * hides the degree, so that all levels can be stored in the same `MGLevelObject` and be
+ * used by deal.II's multigrid classes.
+ *
+ * \tparam dim The number of dimensions in the problem.
+ * \tparam number Datatype to use for `LinearAlgebra::distributed::Vector<number>`.
+ */
+template <int dim, typename number>
+class mgLevelOperator : public dealii::Subscriptor
+{
+public:
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<number>;
+  using value_type = number;
+  using size_type  = dealii::VectorizedArray<number>;
+
+#if defined(PRISMS_PF_WITH_TRILINOS)
+  using SparseMatrixType = dealii::TrilinosWrappers::SparseMatrix;
+#elif defined(PRISMS_PF_WITH_PETSC)
+  using SparseMatrixType = dealii::PETScWrappers::MPI::SparseMatrix;
+#endif
+
+  /**
+   * \brief Constructor.
+   */
+  mgLevelOperator() = default;
+
+  /**
+   * \brief Set the operator of this level. This takes ownership of the operator.
+   */
+  template <typename OperatorType>
+  void
+  reinit(std::unique_ptr<OperatorType> _level_operator);
+
+  /**
+   * \brief Initialize operator.
+   */
+  void
+  initialize(std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data);
+
+  /**
+   * \brief Return the number of DoFs.
+   */
+  [[nodiscard]] dealii::types::global_dof_index
+  m() const;
+
+  /**
+   * \brief Return the value of the matrix entry. This is only here so that we may
+   * compile.
+   */
+  [[nodiscard]] number
+  el(const unsigned int &row, const unsigned int &col) const;
+
+  /**
+   * \brief Initialize a given vector with the MatrixFree object of this level.
+   */
+  void
+  initialize_dof_vector(VectorType &dst, unsigned int dof_handler_index = 0) const;
+
+  /**
+   * \brief Get read access to the MatrixFree object of this level.
+   */
+  [[nodiscard]] std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>>
+  get_matrix_free() const;
+
+  /**
+   * \brief Get read access to the inverse diagonal of this level.
+   */
+  [[nodiscard]] const std::shared_ptr<dealii::DiagonalMatrix<VectorType>> &
+  get_matrix_diagonal_inverse() const;
+
+  /**
+   * \brief Add the mappings from global to local solution vectors.
+   */
+  void
+  add_global_to_local_mapping(
+    const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                             unsigned int,
+                             pairHash> &global_to_local_solution);
+
+  /**
+   * \brief Add the solution subset for src vector.
+   */
+  void
+  add_src_solution_subset(const std::vector<VectorType *> &src_solution_subset);
+
+  /**
+   * \brief Matrix-vector multiplication.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * \brief Transpose matrix-vector multiplication.
+   */
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * \brief Compute the diagonal of this level.
+   */
+  void
+  compute_diagonal(unsigned int field_index);
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+  /**
+   * \brief Assemble the sparse matrix of this level.
+   */
+  void
+  compute_system_matrix(SparseMatrixType                        &matrix,
+                        const dealii::AffineConstraints<double> &constraints,
+                        unsigned int                             field_index) const;
+#endif
+
+private:
+  /**
+   * \brief Interface to the operator of this level.
+   */
+  class operatorInterface
+  {
+  public:
+    virtual ~operatorInterface() = default;
+
+    virtual void
+    initialize(
+      std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data) = 0;
+
+    [[nodiscard]] virtual dealii::types::global_dof_index
+    m() const = 0;
+
+    [[nodiscard]] virtual number
+    el(const unsigned int &row, const unsigned int &col) const = 0;
+
+    virtual void
+    initialize_dof_vector(VectorType &dst, unsigned int dof_handler_index) const = 0;
+
+    [[nodiscard]] virtual std::shared_ptr<
+      const dealii::MatrixFree<dim, number, size_type>>
+    get_matrix_free() const = 0;
+
+    [[nodiscard]] virtual const std::shared_ptr<dealii::DiagonalMatrix<VectorType>> &
+    get_matrix_diagonal_inverse() const = 0;
+
+    virtual void
+    add_global_to_local_mapping(
+      const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                               unsigned int,
+                               pairHash> &global_to_local_solution) = 0;
+
+    virtual void
+    add_src_solution_subset(const std::vector<VectorType *> &src_solution_subset) = 0;
+
+    virtual void
+    vmult(VectorType &dst, const VectorType &src) const = 0;
+
+    virtual void
+    compute_diagonal(unsigned int field_index) = 0;
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+    virtual void
+    compute_system_matrix(SparseMatrixType                        &matrix,
+                          const dealii::AffineConstraints<double> &constraints,
+                          unsigned int                             field_index) const = 0;
+#endif
+  };
+
+  /**
+   * \brief Implementation of the interface for a given operator type.
+   */
+  template <typename OperatorType>
+  class operatorModel : public operatorInterface
+  {
+  public:
+    explicit operatorModel(std::unique_ptr<OperatorType> _level_operator)
+      : level_operator(std::move(_level_operator))
+    {}
+
+    void
+    initialize(
+      std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data) override
+    {
+      level_operator->initialize(data);
+    }
+
+    [[nodiscard]] dealii::types::global_dof_index
+    m() const override
+    {
+      return level_operator->m();
+    }
+
+    [[nodiscard]] number
+    el(const unsigned int &row, const unsigned int &col) const override
+    {
+      return level_operator->el(row, col);
+    }
+
+    void
+    initialize_dof_vector(VectorType &dst, unsigned int dof_handler_index) const override
+    {
+      level_operator->initialize_dof_vector(dst, dof_handler_index);
+    }
+
+    [[nodiscard]] std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>>
+    get_matrix_free() const override
+    {
+      return level_operator->get_matrix_free();
+    }
+
+    [[nodiscard]] const std::shared_ptr<dealii::DiagonalMatrix<VectorType>> &
+    get_matrix_diagonal_inverse() const override
+    {
+      return level_operator->get_matrix_diagonal_inverse();
+    }
+
+    void
+    add_global_to_local_mapping(
+      const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                               unsigned int,
+                               pairHash> &global_to_local_solution) override
+    {
+      level_operator->add_global_to_local_mapping(global_to_local_solution);
+    }
+
+    void
+    add_src_solution_subset(const std::vector<VectorType *> &src_solution_subset) override
+    {
+      level_operator->add_src_solution_subset(src_solution_subset);
+    }
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const override
+    {
+      level_operator->vmult(dst, src);
+    }
+
+    void
+    compute_diagonal(unsigned int field_index) override
+    {
+      level_operator->compute_diagonal(field_index);
+    }
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+    void
+    compute_system_matrix(SparseMatrixType                        &matrix,
+                          const dealii::AffineConstraints<double> &constraints,
+                          unsigned int field_index) const override
+    {
+      level_operator->compute_system_matrix(matrix, constraints, field_index);
+    }
+#endif
+
+  private:
+    std::unique_ptr<OperatorType> level_operator;
+  };
+
+  /**
+   * \brief The operator of this level.
+   */
+  std::unique_ptr<operatorInterface> level_operator;
+};
+
+template <int dim, typename number>
+template <typename OperatorType>
+inline void
+mgLevelOperator<dim, number>::reinit(std::unique_ptr<OperatorType> _level_operator)
+{
+  level_operator =
+    std::make_unique<operatorModel<OperatorType>>(std::move(_level_operator));
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::initialize(
+  std::shared_ptr<const dealii::MatrixFree<dim, number, size_type>> data)
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->initialize(data);
+}
+
+template <int dim, typename number>
+inline dealii::types::global_dof_index
+mgLevelOperator<dim, number>::m() const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  return level_operator->m();
+}
+
+template <int dim, typename number>
+inline number
+mgLevelOperator<dim, number>::el(const unsigned int &row, const unsigned int &col) const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  return level_operator->el(row, col);
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::initialize_dof_vector(VectorType  &dst,
+                                                    unsigned int dof_handler_index) const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->initialize_dof_vector(dst, dof_handler_index);
+}
+
+template <int dim, typename number>
+inline std::shared_ptr<
+  const dealii::MatrixFree<dim, number, typename mgLevelOperator<dim, number>::size_type>>
+mgLevelOperator<dim, number>::get_matrix_free() const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  return level_operator->get_matrix_free();
+}
+
+template <int dim, typename number>
+inline const std::shared_ptr<
+  dealii::DiagonalMatrix<typename mgLevelOperator<dim, number>::VectorType>> &
+mgLevelOperator<dim, number>::get_matrix_diagonal_inverse() const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  return level_operator->get_matrix_diagonal_inverse();
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::add_global_to_local_mapping(
+  const std::unordered_map<std::pair<unsigned int, dependencyType>,
+                           unsigned int,
+                           pairHash> &global_to_local_solution)
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->add_global_to_local_mapping(global_to_local_solution);
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::add_src_solution_subset(
+  const std::vector<VectorType *> &src_solution_subset)
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->add_src_solution_subset(src_solution_subset);
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::vmult(VectorType &dst, const VectorType &src) const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->vmult(dst, src);
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::Tvmult(VectorType &dst, const VectorType &src) const
+{
+  vmult(dst, src);
+}
+
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::compute_diagonal(unsigned int field_index)
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->compute_diagonal(field_index);
+}
+
+#if defined(PRISMS_PF_WITH_TRILINOS) || defined(PRISMS_PF_WITH_PETSC)
+template <int dim, typename number>
+inline void
+mgLevelOperator<dim, number>::compute_system_matrix(
+  SparseMatrixType                        &matrix,
+  const dealii::AffineConstraints<double> &constraints,
+  unsigned int                             field_index) const
+{
+  Assert(level_operator, dealii::ExcNotInitialized());
+  level_operator->compute_system_matrix(matrix, constraints, field_index);
+}
+#endif
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
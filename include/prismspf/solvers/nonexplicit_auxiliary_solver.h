@@ -40,16 +40,15 @@ public:
   /**
    * \brief Constructor.
    */
-  nonexplicitAuxiliarySolver(
-    const userInputParameters<dim>                       &_user_inputs,
-    const matrixfreeHandler<dim>                         &_matrix_free_handler,
-    const triangulationHandler<dim>                      &_triangulation_handler,
-    const invmHandler<dim, degree>                       &_invm_handler,
-    const constraintHandler<dim>                         &_constraint_handler,
-    const dofHandler<dim>                                &_dof_handler,
-    const dealii::MappingQ1<dim>                         &_mapping,
-    dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-    solutionHandler<dim>                                 &_solution_handler);
+  nonexplicitAuxiliarySolver(const userInputParameters<dim>  &_user_inputs,
+                             const matrixfreeHandler<dim>    &_matrix_free_handler,
+                             const triangulationHandler<dim> &_triangulation_handler,
+                             const invmHandler<dim, degree>  &_invm_handler,
+                             const constraintHandler<dim>    &_constraint_handler,
+                             const dofHandler<dim>           &_dof_handler,
+                             const dealii::MappingQ1<dim>    &_mapping,
+                             mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+                             solutionHandler<dim>            &_solution_handler);
 
   /**
    * \brief Destructor.
@@ -62,6 +61,12 @@ public:
   void
   init() override;
 
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
   /**
    * \brief Solve a single update step.
    */
@@ -95,15 +100,15 @@ private:
 
 template <int dim, int degree>
 nonexplicitAuxiliarySolver<dim, degree>::nonexplicitAuxiliarySolver(
-  const userInputParameters<dim>                       &_user_inputs,
-  const matrixfreeHandler<dim>                         &_matrix_free_handler,
-  const triangulationHandler<dim>                      &_triangulation_handler,
-  const invmHandler<dim, degree>                       &_invm_handler,
-  const constraintHandler<dim>                         &_constraint_handler,
-  const dofHandler<dim>                                &_dof_handler,
-  const dealii::MappingQ1<dim>                         &_mapping,
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-  solutionHandler<dim>                                 &_solution_handler)
+  const userInputParameters<dim>  &_user_inputs,
+  const matrixfreeHandler<dim>    &_matrix_free_handler,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const invmHandler<dim, degree>  &_invm_handler,
+  const constraintHandler<dim>    &_constraint_handler,
+  const dofHandler<dim>           &_dof_handler,
+  const dealii::MappingQ1<dim>    &_mapping,
+  mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+  solutionHandler<dim>            &_solution_handler)
   : nonexplicitBase<dim, degree>(_user_inputs,
                                  _matrix_free_handler,
                                  _triangulation_handler,
@@ -111,7 +116,7 @@ nonexplicitAuxiliarySolver<dim, degree>::nonexplicitAuxiliarySolver(
                                  _constraint_handler,
                                  _dof_handler,
                                  _mapping,
-                                 _mg_matrix_free_handler,
+                                 _mg_hierarchy_handler,
                                  _solution_handler)
 {}
 
@@ -185,6 +190,17 @@ nonexplicitAuxiliarySolver<dim, degree>::init()
     }
 }
 
+template <int dim, int degree>
+inline void
+nonexplicitAuxiliarySolver<dim, degree>::reinit()
+{
+  for (const auto &[index, variable] : this->subset_attributes)
+    {
+      this->system_matrix.at(index)->initialize(
+        this->matrix_free_handler.get_matrix_free());
+    }
+}
+
 template <int dim, int degree>
 inline void
 nonexplicitAuxiliarySolver<dim, degree>::solve()
@@ -13,12 +13,15 @@
 #include <prismspf/core/initial_conditions.h>
 #include <prismspf/core/invm_handler.h>
 #include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/multigrid_hierarchy.h>
 #include <prismspf/core/solution_handler.h>
 #include <prismspf/core/triangulation_handler.h>
 #include <prismspf/core/type_enums.h>
 #include <prismspf/core/variable_attributes.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <algorithm>
+
 PRISMS_PF_BEGIN_NAMESPACE
 
 /**
@@ -39,16 +42,15 @@ public:
   /**
    * \brief Constructor.
    */
-  nonexplicitBase(
-    const userInputParameters<dim>                       &_user_inputs,
-    const matrixfreeHandler<dim>                         &_matrix_free_handler,
-    const triangulationHandler<dim>                      &_triangulation_handler,
-    const invmHandler<dim, degree>                       &_invm_handler,
-    const constraintHandler<dim>                         &_constraint_handler,
-    const dofHandler<dim>                                &_dof_handler,
-    const dealii::MappingQ1<dim>                         &_mapping,
-    dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-    solutionHandler<dim>                                 &_solution_handler);
+  nonexplicitBase(const userInputParameters<dim>  &_user_inputs,
+                  const matrixfreeHandler<dim>    &_matrix_free_handler,
+                  const triangulationHandler<dim> &_triangulation_handler,
+                  const invmHandler<dim, degree>  &_invm_handler,
+                  const constraintHandler<dim>    &_constraint_handler,
+                  const dofHandler<dim>           &_dof_handler,
+                  const dealii::MappingQ1<dim>    &_mapping,
+                  mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+                  solutionHandler<dim>            &_solution_handler);
 
   /**
    * \brief Destructor.
@@ -61,6 +63,12 @@ public:
   virtual void
   init() = 0;
 
+  /**
+   * \brief Reinitialize the system after the mesh has changed.
+   */
+  virtual void
+  reinit() = 0;
+
   /**
    * \brief Solve a single update step.
    */
@@ -78,10 +86,11 @@ protected:
   compute_subset_attributes(const fieldSolveType &field_solve_type);
 
   /**
-   * \brief Compute the shared dependency set and copy it to all eval_flag_set_RHS. Also
-   * do something similar with dependency_set_RHS so that all the FEEvaluation objects are
-   * initialized. This should only be called for concurrent nonexplicit fieldSolveTypes
-   * like NONEXPLICIT_CO_NONLINEAR.
+   * \brief Compute the shared dependency set and copy it to all eval_flag_set_RHS and
+   * eval_flag_set_LHS. Also do something similar with dependency_set_RHS and
+   * dependency_set_LHS so that all the FEEvaluation objects are initialized. This should
+   * only be called for concurrent nonexplicit fieldSolveTypes like
+   * NONEXPLICIT_CO_NONLINEAR.
    */
   void
   compute_shared_dependencies();
@@ -99,6 +108,33 @@ protected:
   void
   print();
 
+  /**
+   * \brief Backtrack from the given step length until the residual decreases
+   * sufficiently, or until the next step would be shorter than the minimum step length,
+   * in which case the current step is accepted. `add_update(delta)` adds delta times the
+   * newton update to the solution and `compute_residual_norm()` returns the residual norm
+   * of the current solution. Returns the number of backtracks.
+   */
+  template <typename AddUpdateFunction, typename ResidualNormFunction>
+  static unsigned int
+  backtrack_line_search(const nonlinearSolverParameters &parameters,
+                        const double                    &residual_norm,
+                        double                          &step_length,
+                        double                          &new_residual_norm,
+                        const AddUpdateFunction         &add_update,
+                        const ResidualNormFunction      &compute_residual_norm);
+
+  /**
+   * \brief Compute the Eisenstat-Walker forcing term of the next newton iteration from
+   * the reduction of the residual in the last one.
+   */
+  [[nodiscard]] static double
+  compute_forcing_term(const nonlinearSolverParameters &parameters,
+                       const double                    &forcing_term,
+                       const double                    &residual_norm,
+                       const double                    &new_residual_norm,
+                       const double                    &initial_residual_norm);
+
   /**
    * \brief User-inputs.
    */
@@ -135,9 +171,9 @@ protected:
   const dealii::MappingQ1<dim> &mapping;
 
   /**
-   * \brief Matrix-free object handler for multigrid data.
+   * \brief Handler of the multigrid hierarchies.
    */
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &mg_matrix_free_handler;
+  mgHierarchyHandler<dim> &mg_hierarchy_handler;
 
   /**
    * \brief Solution handler.
@@ -162,15 +198,15 @@ protected:
 
 template <int dim, int degree>
 nonexplicitBase<dim, degree>::nonexplicitBase(
-  const userInputParameters<dim>                       &_user_inputs,
-  const matrixfreeHandler<dim>                         &_matrix_free_handler,
-  const triangulationHandler<dim>                      &_triangulation_handler,
-  const invmHandler<dim, degree>                       &_invm_handler,
-  const constraintHandler<dim>                         &_constraint_handler,
-  const dofHandler<dim>                                &_dof_handler,
-  const dealii::MappingQ1<dim>                         &_mapping,
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-  solutionHandler<dim>                                 &_solution_handler)
+  const userInputParameters<dim>  &_user_inputs,
+  const matrixfreeHandler<dim>    &_matrix_free_handler,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const invmHandler<dim, degree>  &_invm_handler,
+  const constraintHandler<dim>    &_constraint_handler,
+  const dofHandler<dim>           &_dof_handler,
+  const dealii::MappingQ1<dim>    &_mapping,
+  mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+  solutionHandler<dim>            &_solution_handler)
   : user_inputs(_user_inputs)
   , matrix_free_handler(_matrix_free_handler)
   , triangulation_handler(_triangulation_handler)
@@ -178,7 +214,7 @@ nonexplicitBase<dim, degree>::nonexplicitBase(
   , constraint_handler(_constraint_handler)
   , dof_handler(_dof_handler)
   , mapping(_mapping)
-  , mg_matrix_free_handler(_mg_matrix_free_handler)
+  , mg_hierarchy_handler(_mg_hierarchy_handler)
   , solution_handler(_solution_handler)
 {}
 
@@ -216,41 +252,72 @@ nonexplicitBase<dim, degree>::compute_shared_dependencies()
          dealii::ExcMessage("compute_shared_dependencies() should only be used for "
                             "NONEXPLICIT_CO_NONLINEAR fieldSolveTypes"));
 
-  // Compute the shared dependency flags
-  auto &dependency_flag_set = subset_attributes.begin()->second.eval_flag_set_RHS;
+  // Compute the shared RHS dependency flags
+  auto &dependency_flag_set_RHS = subset_attributes.begin()->second.eval_flag_set_RHS;
   for (const auto &[index, variable] : subset_attributes)
     {
-      if (!variable.eval_flag_set_RHS.empty())
+      for (const auto &[pair, flag] : variable.eval_flag_set_RHS)
         {
-          for (const auto &[pair, flag] : variable.eval_flag_set_RHS)
+          dependency_flag_set_RHS[pair] |= flag;
+        }
+    }
+  for (auto &[index, variable] : subset_attributes)
+    {
+      for (const auto &[pair, flag] : dependency_flag_set_RHS)
+        {
+          variable.eval_flag_set_RHS[pair] |= flag;
+        }
+    }
+
+  // Compute the shared RHS dependency set
+  auto &dependency_set_RHS = subset_attributes.begin()->second.dependency_set_RHS;
+  for (const auto &[index, variable] : subset_attributes)
+    {
+      for (const auto &[dependency_index, map] : variable.dependency_set_RHS)
+        {
+          for (const auto &[dependency_type, field_type] : map)
             {
-              dependency_flag_set[pair] |= flag;
+              dependency_set_RHS[dependency_index].emplace(dependency_type, field_type);
             }
         }
     }
   for (auto &[index, variable] : subset_attributes)
     {
-      for (const auto &[pair, flag] : dependency_flag_set)
+      variable.dependency_set_RHS = dependency_set_RHS;
+    }
+
+  // Compute the shared LHS dependency flags
+  auto &dependency_flag_set_LHS = subset_attributes.begin()->second.eval_flag_set_LHS;
+  for (const auto &[index, variable] : subset_attributes)
+    {
+      for (const auto &[pair, flag] : variable.eval_flag_set_LHS)
         {
-          variable.eval_flag_set_RHS[pair] |= flag;
+          dependency_flag_set_LHS[pair] |= flag;
+        }
+    }
+  for (auto &[index, variable] : subset_attributes)
+    {
+      for (const auto &[pair, flag] : dependency_flag_set_LHS)
+        {
+          variable.eval_flag_set_LHS[pair] |= flag;
         }
     }
 
-  // Compute the shared dependency set
-  auto &dependency_set = subset_attributes.begin()->second.dependency_set_RHS;
+  // Compute the shared LHS dependency set
+  auto &dependency_set_LHS = subset_attributes.begin()->second.dependency_set_LHS;
   for (const auto &[index, variable] : subset_attributes)
     {
-      for (const auto &[index, map] : variable.dependency_set_RHS)
+      for (const auto &[dependency_index, map] : variable.dependency_set_LHS)
         {
           for (const auto &[dependency_type, field_type] : map)
             {
-              dependency_set[index].emplace(dependency_type, field_type);
+              dependency_set_LHS[dependency_index].emplace(dependency_type, field_type);
             }
         }
     }
   for (auto &[index, variable] : subset_attributes)
     {
-      variable.dependency_set_RHS = dependency_set;
+      variable.dependency_set_LHS = dependency_set_LHS;
     }
 
 #ifdef DEBUG
@@ -327,6 +394,67 @@ nonexplicitBase<dim, degree>::print()
   conditionalOStreams::pout_summary() << "\n" << std::flush;
 }
 
+template <int dim, int degree>
+template <typename AddUpdateFunction, typename ResidualNormFunction>
+inline unsigned int
+nonexplicitBase<dim, degree>::backtrack_line_search(
+  const nonlinearSolverParameters &parameters,
+  const double                    &residual_norm,
+  double                          &step_length,
+  double                          &new_residual_norm,
+  const AddUpdateFunction         &add_update,
+  const ResidualNormFunction      &compute_residual_norm)
+{
+  unsigned int n_backtracks = 0;
+  if (!parameters.backtrack_line_search)
+    {
+      return n_backtracks;
+    }
+
+  while (new_residual_norm >
+           (1.0 - parameters.residual_decrease_coefficient * step_length) *
+             residual_norm &&
+         step_length * parameters.step_modifier >= parameters.min_step_length)
+    {
+      const double new_step_length = step_length * parameters.step_modifier;
+      add_update(new_step_length - step_length);
+      step_length       = new_step_length;
+      new_residual_norm = compute_residual_norm();
+      n_backtracks++;
+    }
+
+  return n_backtracks;
+}
+
+template <int dim, int degree>
+inline double
+nonexplicitBase<dim, degree>::compute_forcing_term(
+  const nonlinearSolverParameters &parameters,
+  const double                    &forcing_term,
+  const double                    &residual_norm,
+  const double                    &new_residual_norm,
+  const double                    &initial_residual_norm)
+{
+  // Choice 2 with gamma = 0.9 and alpha = 2
+  const double ratio            = new_residual_norm / residual_norm;
+  const double safeguard        = 0.9 * forcing_term * forcing_term;
+  double       new_forcing_term = 0.9 * ratio * ratio;
+  if (safeguard > 0.1)
+    {
+      new_forcing_term = std::max(new_forcing_term, safeguard);
+    }
+
+  // Avoid oversolving once we're close to the nonlinear tolerance
+  const double absolute_tolerance =
+    parameters.tolerance_type == solverToleranceType::ABSOLUTE_RESIDUAL
+      ? parameters.tolerance
+      : parameters.tolerance * initial_residual_norm;
+  new_forcing_term =
+    std::max(new_forcing_term, 0.5 * absolute_tolerance / new_residual_norm);
+
+  return std::min(new_forcing_term, parameters.max_forcing_term);
+}
+
 PRISMS_PF_END_NAMESPACE
 
 #endif
\ No newline at end of file
@@ -4,7 +4,19 @@
 #ifndef nonexplicit_co_nonlinear_solver_h
 #define nonexplicit_co_nonlinear_solver_h
 
+#include <deal.II/base/config.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+
 #include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/solvers/block_gmg_preconditioner.h>
+#include <prismspf/solvers/nonexplicit_base.h>
+
+#include <cmath>
 
 #ifdef PRISMS_PF_WITH_CALIPER
 #  include <caliper/cali.h>
@@ -12,12 +24,590 @@
 
 PRISMS_PF_BEGIN_NAMESPACE
 
+/**
+ * Forward declaration for user-implemented PDE class.
+ */
+template <int dim, int degree, typename number>
+class customPDE;
+
 /**
  * \brief This class handles the nonlinear solves of a several nonexplicit fields
+ *
+ * All co-nonlinear fields are solved together with a monolithic Newton method. Each field
+ * is a block of the residual and newton update, so the Jacobian includes the coupling
+ * between the fields. The linear systems are solved with GMRES, since the coupled
+ * Jacobian is generally nonsymmetric, and preconditioned block-diagonally. Each diagonal
+ * block is either approximated by its inverse diagonal (JACOBI) or by a V-cycle on the
+ * multigrid hierarchy that the fields share (GMG).
+ *
+ * The linear and nonlinear solver parameters of the first field in the set are used for
+ * the whole set.
  */
-class nonexplicitCoNonlinearSolver
-{};
+template <int dim, int degree>
+class nonexplicitCoNonlinearSolver : public nonexplicitBase<dim, degree>
+{
+public:
+  using SystemMatrixType = customPDE<dim, degree, double>;
+  using VectorType       = dealii::LinearAlgebra::distributed::Vector<double>;
+  using BlockVectorType  = dealii::LinearAlgebra::distributed::BlockVector<double>;
+
+  /**
+   * \brief Constructor.
+   */
+  nonexplicitCoNonlinearSolver(const userInputParameters<dim>  &_user_inputs,
+                               const matrixfreeHandler<dim>    &_matrix_free_handler,
+                               const triangulationHandler<dim> &_triangulation_handler,
+                               const invmHandler<dim, degree>  &_invm_handler,
+                               const constraintHandler<dim>    &_constraint_handler,
+                               const dofHandler<dim>           &_dof_handler,
+                               const dealii::MappingQ1<dim>    &_mapping,
+                               mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+                               solutionHandler<dim>            &_solution_handler);
+
+  /**
+   * \brief Destructor.
+   */
+  ~nonexplicitCoNonlinearSolver() = default;
+
+  /**
+   * \brief Initialize system.
+   */
+  void
+  init() override;
+
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
+  /**
+   * \brief Solve a single update step.
+   */
+  void
+  solve() override;
+
+private:
+  /**
+   * \brief Set up the operators and the block vectors on the current matrix-free
+   * object.
+   */
+  void
+  setup_system();
+
+  /**
+   * \brief Compute the residual of the current solutions and return its l2-norm.
+   */
+  double
+  compute_residual_norm();
+
+  /**
+   * \brief Solve the linearized system for the newton update with the given tolerance.
+   */
+  void
+  solve_linear_system(const double &tolerance);
+
+  /**
+   * \brief Add the scaled newton update to the solutions.
+   */
+  void
+  add_newton_update(const double &step_length);
+
+  /**
+   * \brief Return the l2-norm of the solutions of all fields in the set.
+   */
+  [[nodiscard]] double
+  get_solution_norm() const;
+
+  /**
+   * \brief Global indices of the fields in the set. The position in this vector is the
+   * block of the field.
+   */
+  std::vector<unsigned int> field_indices;
+
+  /**
+   * \brief Mapping from global solution vectors to the local ones for the residual solve.
+   */
+  std::unordered_map<std::pair<unsigned int, dependencyType>, unsigned int, pairHash>
+    residual_global_to_local_solution;
+
+  /**
+   * \brief Subset of fields that are necessary for the source of the residual solve.
+   */
+  std::vector<VectorType *> residual_src;
+
+  /**
+   * \brief Mapping from global solution vectors to the local ones for the newton update.
+   * The change terms map to blocks of the newton update.
+   */
+  std::unordered_map<std::pair<unsigned int, dependencyType>, unsigned int, pairHash>
+    newton_update_global_to_local_solution;
+
+  /**
+   * \brief Subset of fields that are necessary for the source of the newton update.
+   */
+  std::vector<VectorType *> newton_update_src;
+
+  /**
+   * \brief Residual block vector.
+   */
+  BlockVectorType residual;
+
+  /**
+   * \brief Newton update block vector.
+   */
+  BlockVectorType newton_update;
+
+  /**
+   * \brief Block Jacobi preconditioner.
+   */
+  dealii::DiagonalMatrix<BlockVectorType> block_jacobi;
+
+  /**
+   * \brief Block-diagonal multigrid preconditioner. This is only created for the GMG
+   * preconditioner.
+   */
+  std::unique_ptr<blockGMGPreconditioner<dim, degree>> block_gmg;
+
+  /**
+   * \brief Solver control.
+   */
+  dealii::SolverControl solver_control;
+};
+
+template <int dim, int degree>
+nonexplicitCoNonlinearSolver<dim, degree>::nonexplicitCoNonlinearSolver(
+  const userInputParameters<dim>  &_user_inputs,
+  const matrixfreeHandler<dim>    &_matrix_free_handler,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const invmHandler<dim, degree>  &_invm_handler,
+  const constraintHandler<dim>    &_constraint_handler,
+  const dofHandler<dim>           &_dof_handler,
+  const dealii::MappingQ1<dim>    &_mapping,
+  mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+  solutionHandler<dim>            &_solution_handler)
+  : nonexplicitBase<dim, degree>(_user_inputs,
+                                 _matrix_free_handler,
+                                 _triangulation_handler,
+                                 _invm_handler,
+                                 _constraint_handler,
+                                 _dof_handler,
+                                 _mapping,
+                                 _mg_hierarchy_handler,
+                                 _solution_handler)
+{}
+
+template <int dim, int degree>
+inline void
+nonexplicitCoNonlinearSolver<dim, degree>::init()
+{
+  this->compute_subset_attributes(fieldSolveType::NONEXPLICIT_CO_NONLINEAR);
+
+  // If the subset attribute is empty return early
+  if (this->subset_attributes.empty())
+    {
+      return;
+    }
+
+  for (const auto &[index, variable] : this->subset_attributes)
+    {
+      AssertThrow(variable.pde_type == PDEType::TIME_INDEPENDENT ||
+                    variable.pde_type == PDEType::IMPLICIT_TIME_DEPENDENT,
+                  FeatureNotImplemented("Auxiliary fields in a co-nonlinear set"));
+      field_indices.push_back(index);
+    }
+
+  this->compute_shared_dependencies();
+  this->set_initial_condition();
+
+  const unsigned int group_index = field_indices.front();
+  const unsigned int n_blocks    = field_indices.size();
+
+  // Create the residual subset of solution vectors. The solutions of the fields in the
+  // set come first so that their local index matches their block in the residual.
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      residual_src.push_back(this->solution_handler.solution_set.at(
+        std::make_pair(field_indices[block], dependencyType::NORMAL)));
+      residual_global_to_local_solution.emplace(std::make_pair(field_indices[block],
+                                                               dependencyType::NORMAL),
+                                                block);
+    }
+  for (const auto &[variable_index, map] :
+       this->subset_attributes.begin()->second.dependency_set_RHS)
+    {
+      for (const auto &[dependency_type, field_type] : map)
+        {
+          const auto pair = std::make_pair(variable_index, dependency_type);
+          if (residual_global_to_local_solution.find(pair) !=
+              residual_global_to_local_solution.end())
+            {
+              continue;
+            }
+
+          Assert(this->solution_handler.solution_set.find(pair) !=
+                   this->solution_handler.solution_set.end(),
+                 dealii::ExcMessage("There is no solution vector for the given index = " +
+                                    std::to_string(variable_index) +
+                                    " and type = " + to_string(dependency_type)));
+
+          residual_src.push_back(this->solution_handler.solution_set.at(pair));
+          residual_global_to_local_solution.emplace(pair, residual_src.size() - 1);
+        }
+    }
+
+  // Create the newton update subset of solution vectors. The change terms are read from
+  // the blocks of the src vector in vmult, so they map to the block of the field.
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      newton_update_global_to_local_solution.emplace(
+        std::make_pair(field_indices[block], dependencyType::CHANGE),
+        block);
+    }
+  for (const auto &[variable_index, map] :
+       this->subset_attributes.begin()->second.dependency_set_LHS)
+    {
+      for (const auto &[dependency_type, field_type] : map)
+        {
+          if (dependency_type == dependencyType::CHANGE)
+            {
+              continue;
+            }
+          const auto pair = std::make_pair(variable_index, dependency_type);
+
+          Assert(this->solution_handler.solution_set.find(pair) !=
+                   this->solution_handler.solution_set.end(),
+                 dealii::ExcMessage("There is no solution vector for the given index = " +
+                                    std::to_string(variable_index) +
+                                    " and type = " + to_string(dependency_type)));
+
+          newton_update_src.push_back(this->solution_handler.solution_set.at(pair));
+          newton_update_global_to_local_solution.emplace(pair,
+                                                         newton_update_src.size() - 1);
+        }
+    }
+
+  // Create the implementation of customPDE with the subset of variable attributes
+  this->system_matrix[group_index] =
+    std::make_unique<SystemMatrixType>(this->user_inputs, this->subset_attributes);
+  this->update_system_matrix[group_index] =
+    std::make_unique<SystemMatrixType>(this->user_inputs, this->subset_attributes);
+
+  setup_system();
+
+  if (this->user_inputs.linear_solve_parameters.linear_solve.at(group_index)
+        .preconditioner == preconditionerType::GMG)
+    {
+      block_gmg = std::make_unique<blockGMGPreconditioner<dim, degree>>(
+        this->user_inputs,
+        this->dof_handler,
+        this->mg_hierarchy_handler);
+      block_gmg->init(this->subset_attributes,
+                      field_indices,
+                      newton_update_global_to_local_solution);
+    }
+
+  solver_control.set_max_steps(
+    this->user_inputs.linear_solve_parameters.linear_solve.at(group_index)
+      .max_iterations);
+
+  // Apply constraints
+  for (const auto &index : field_indices)
+    {
+      this->constraint_handler.get_constraint(index).distribute(
+        *(this->solution_handler.solution_set.at(
+          std::make_pair(index, dependencyType::NORMAL))));
+    }
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitCoNonlinearSolver<dim, degree>::reinit()
+{
+  if (this->subset_attributes.empty())
+    {
+      return;
+    }
+
+  setup_system();
+
+  // The shared hierarchy of the old mesh has been released, so the first field to
+  // request it builds the new one
+  if (block_gmg)
+    {
+      block_gmg->clear();
+      block_gmg->init(this->subset_attributes,
+                      field_indices,
+                      newton_update_global_to_local_solution);
+    }
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitCoNonlinearSolver<dim, degree>::setup_system()
+{
+  const unsigned int group_index = field_indices.front();
+  const unsigned int n_blocks    = field_indices.size();
+
+  auto &system_matrix        = *(this->system_matrix.at(group_index));
+  auto &update_system_matrix = *(this->update_system_matrix.at(group_index));
+
+  system_matrix.clear();
+  system_matrix.initialize(this->matrix_free_handler.get_matrix_free(), field_indices);
+  system_matrix.add_global_to_local_mapping(residual_global_to_local_solution);
+  system_matrix.add_src_solution_subset(residual_src);
+
+  update_system_matrix.clear();
+  update_system_matrix.initialize(this->matrix_free_handler.get_matrix_free(),
+                                  field_indices);
+  update_system_matrix.add_global_to_local_mapping(
+    newton_update_global_to_local_solution);
+  update_system_matrix.add_src_solution_subset(newton_update_src);
+
+  // Create the block vectors
+  residual.reinit(n_blocks);
+  newton_update.reinit(n_blocks);
+  block_jacobi.get_vector().reinit(n_blocks);
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      this->matrix_free_handler.get_matrix_free()->initialize_dof_vector(
+        residual.block(block),
+        field_indices[block]);
+      this->matrix_free_handler.get_matrix_free()->initialize_dof_vector(
+        newton_update.block(block),
+        field_indices[block]);
+      this->matrix_free_handler.get_matrix_free()->initialize_dof_vector(
+        block_jacobi.get_vector().block(block),
+        field_indices[block]);
+    }
+  residual.collect_sizes();
+  newton_update.collect_sizes();
+  block_jacobi.get_vector().collect_sizes();
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitCoNonlinearSolver<dim, degree>::solve()
+{
+  // If the subset attribute is empty return early
+  if (this->subset_attributes.empty())
+    {
+      return;
+    }
+
+  // Shift the old solutions of the fields, so the current solutions are the initial
+  // guess for the newton iterations.
+  for (const auto &index : field_indices)
+    {
+      this->solution_handler.update(fieldSolveType::NONEXPLICIT_CO_NONLINEAR, index);
+    }
+
+  const unsigned int group_index = field_indices.front();
+  const auto        &parameters =
+    this->user_inputs.nonlinear_solve_parameters.nonlinear_solve.at(group_index);
+  const auto &linear_parameters =
+    this->user_inputs.linear_solve_parameters.linear_solve.at(group_index);
+
+  // Compute the initial residual
+  double       residual_norm           = compute_residual_norm();
+  const double initial_residual_norm   = residual_norm;
+  double       forcing_term            = parameters.max_forcing_term;
+  double       update_norm             = 0.0;
+  unsigned int iteration               = 0;
+  unsigned int total_linear_iterations = 0;
+
+  const auto is_converged = [&]()
+  {
+    const bool residual_converged =
+      parameters.tolerance_type == solverToleranceType::ABSOLUTE_RESIDUAL
+        ? residual_norm < parameters.tolerance
+        : residual_norm < parameters.tolerance * initial_residual_norm;
+    const bool update_converged =
+      iteration > 0 && parameters.update_tolerance > 0.0 &&
+      update_norm <= parameters.update_tolerance * get_solution_norm();
+    return residual_converged || update_converged;
+  };
+
+  while (!is_converged() && iteration < parameters.max_iterations)
+    {
+      // Determine the linear solver tolerance
+      double tolerance = linear_parameters.tolerance;
+      if (parameters.use_eisenstat_walker)
+        {
+          tolerance = forcing_term * residual_norm;
+        }
+      else if (linear_parameters.tolerance_type ==
+               solverToleranceType::RELATIVE_RESIDUAL_CHANGE)
+        {
+          tolerance *= residual_norm;
+        }
+
+      // Perform the linear solve with the step length
+      solve_linear_system(tolerance);
+      total_linear_iterations += solver_control.last_step();
+
+      double step_length =
+        parameters.backtrack_line_search ? 1.0 : parameters.step_length;
+      add_newton_update(step_length);
+
+      // Backtrack until the residual decreases sufficiently
+      double             new_residual_norm = compute_residual_norm();
+      const unsigned int n_backtracks      = this->backtrack_line_search(
+        parameters,
+        residual_norm,
+        step_length,
+        new_residual_norm,
+        [this](const double &delta)
+        {
+          add_newton_update(delta);
+        },
+        [this]()
+        {
+          return compute_residual_norm();
+        });
+      update_norm = step_length * newton_update.l2_norm();
+
+      if (parameters.use_eisenstat_walker)
+        {
+          forcing_term = this->compute_forcing_term(parameters,
+                                                    forcing_term,
+                                                    residual_norm,
+                                                    new_residual_norm,
+                                                    initial_residual_norm);
+        }
+
+      residual_norm = new_residual_norm;
+      iteration++;
+
+      conditionalOStreams::pout_summary()
+        << "  co-nonlinear fields Newton iteration: " << iteration
+        << " Residual: " << residual_norm << " Update: " << update_norm
+        << " Step length: " << step_length << " Backtracks: " << n_backtracks
+        << " Linear steps: " << solver_control.last_step() << "\n"
+        << std::flush;
+    }
+
+  if (!is_converged())
+    {
+      conditionalOStreams::pout_base()
+        << "Warning: nonlinear solver for co-nonlinear fields did not converge in "
+        << iteration << " iterations. Residual: " << residual_norm << "\n";
+    }
+
+  conditionalOStreams::pout_summary()
+    << "  co-nonlinear fields Newton iterations: " << iteration
+    << " Linear iterations: " << total_linear_iterations
+    << " Initial residual: " << initial_residual_norm
+    << " Final residual: " << residual_norm << "\n"
+    << std::flush;
+}
+
+template <int dim, int degree>
+inline double
+nonexplicitCoNonlinearSolver<dim, degree>::compute_residual_norm()
+{
+  this->system_matrix.at(field_indices.front())->compute_residual(residual);
+
+  return residual.l2_norm();
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitCoNonlinearSolver<dim, degree>::solve_linear_system(const double &tolerance)
+{
+  const auto &update_system_matrix =
+    *(this->update_system_matrix.at(field_indices.front()));
+
+  solver_control.set_tolerance(tolerance);
+
+  const unsigned int gmres_restart =
+    this->user_inputs.linear_solve_parameters.linear_solve.at(field_indices.front())
+      .gmres_restart;
+  typename dealii::SolverGMRES<BlockVectorType>::AdditionalData gmres_data;
+#if DEAL_II_VERSION_GTE(9, 6, 0)
+  gmres_data.max_basis_size = gmres_restart;
+#else
+  // Before deal.II 9.6, the two auxiliary vectors count towards the basis size
+  gmres_data.max_n_tmp_vectors = gmres_restart + 2;
+#endif
+  dealii::SolverGMRES<BlockVectorType> gmres(solver_control, gmres_data);
+
+  // The Jacobian changes every iteration, so we have to rebuild the preconditioner
+  const auto preconditioner =
+    this->user_inputs.linear_solve_parameters.linear_solve.at(field_indices.front())
+      .preconditioner;
+  try
+    {
+      newton_update = 0.0;
+      switch (preconditioner)
+        {
+          case preconditionerType::NONE:
+            {
+              gmres.solve(update_system_matrix,
+                          newton_update,
+                          residual,
+                          dealii::PreconditionIdentity());
+              break;
+            }
+          case preconditionerType::JACOBI:
+            {
+              update_system_matrix.compute_block_diagonal(block_jacobi.get_vector());
+              gmres.solve(update_system_matrix, newton_update, residual, block_jacobi);
+              break;
+            }
+          case preconditionerType::GMG:
+            {
+              block_gmg->setup(newton_update_src);
+              gmres.solve(update_system_matrix, newton_update, residual, *block_gmg);
+              break;
+            }
+          default:
+            AssertThrow(false, UnreachableCode());
+        }
+    }
+  catch (...)
+    {
+      conditionalOStreams::pout_base()
+        << "Warning: linear solver did not converge as per set tolerances.\n";
+    }
+
+  for (unsigned int block = 0; block < field_indices.size(); ++block)
+    {
+      this->constraint_handler.get_constraint(field_indices[block])
+        .set_zero(newton_update.block(block));
+    }
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitCoNonlinearSolver<dim, degree>::add_newton_update(const double &step_length)
+{
+  for (unsigned int block = 0; block < field_indices.size(); ++block)
+    {
+      auto *solution = this->solution_handler.solution_set.at(
+        std::make_pair(field_indices[block], dependencyType::NORMAL));
+
+      solution->add(step_length, newton_update.block(block));
+      this->constraint_handler.get_constraint(field_indices[block]).distribute(*solution);
+      this->solution_handler.mark_changed(field_indices[block]);
+    }
+}
+
+template <int dim, int degree>
+inline double
+nonexplicitCoNonlinearSolver<dim, degree>::get_solution_norm() const
+{
+  double norm_sq = 0.0;
+  for (const auto &index : field_indices)
+    {
+      const double norm = this->solution_handler.solution_set
+                            .at(std::make_pair(index, dependencyType::NORMAL))
+                            ->l2_norm();
+      norm_sq += norm * norm;
+    }
+  return std::sqrt(norm_sq);
+}
 
 PRISMS_PF_END_NAMESPACE
 
-#endif
\ No newline at end of file
+#endif
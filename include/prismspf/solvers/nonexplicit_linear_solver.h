@@ -4,22 +4,30 @@
 #ifndef nonexplicit_linear_solver_h
 #define nonexplicit_linear_solver_h
 
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/solver_control.h>
 
 #include <prismspf/config.h>
+#include <prismspf/core/batched_operator.h>
 #include <prismspf/core/constraint_handler.h>
 #include <prismspf/core/dof_handler.h>
 #include <prismspf/core/matrix_free_handler.h>
 #include <prismspf/core/solution_handler.h>
 #include <prismspf/core/type_enums.h>
 #include <prismspf/core/variable_attributes.h>
+#include <prismspf/solvers/batched_cg.h>
 #include <prismspf/solvers/linear_solver_gmg.h>
 #include <prismspf/solvers/linear_solver_identity.h>
+#include <prismspf/solvers/linear_solver_jacobi.h>
 #include <prismspf/solvers/nonexplicit_base.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <algorithm>
+#include <vector>
+
 #ifdef PRISMS_PF_WITH_CALIPER
 #  include <caliper/cali.h>
 #endif
@@ -34,26 +42,30 @@ class customPDE;
 
 /**
  * \brief This class handles all linear solves.
+ *
+ * Fields that enable batched solves are solved together, before the other fields, with
+ * one CG per field that shares the operator applications and global reductions.
  */
 template <int dim, int degree>
 class nonexplicitLinearSolver : public nonexplicitBase<dim, degree>
 {
 public:
   using SystemMatrixType = customPDE<dim, degree, double>;
+  using OperatorType     = matrixFreeOperator<dim, degree, double>;
+  using BlockVectorType  = dealii::LinearAlgebra::distributed::BlockVector<double>;
 
   /**
    * \brief Constructor.
    */
-  nonexplicitLinearSolver(
-    const userInputParameters<dim>                       &_user_inputs,
-    const matrixfreeHandler<dim>                         &_matrix_free_handler,
-    const triangulationHandler<dim>                      &_triangulation_handler,
-    const invmHandler<dim, degree>                       &_invm_handler,
-    const constraintHandler<dim>                         &_constraint_handler,
-    const dofHandler<dim>                                &_dof_handler,
-    const dealii::MappingQ1<dim>                         &_mapping,
-    dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-    solutionHandler<dim>                                 &_solution_handler);
+  nonexplicitLinearSolver(const userInputParameters<dim>  &_user_inputs,
+                          const matrixfreeHandler<dim>    &_matrix_free_handler,
+                          const triangulationHandler<dim> &_triangulation_handler,
+                          const invmHandler<dim, degree>  &_invm_handler,
+                          const constraintHandler<dim>    &_constraint_handler,
+                          const dofHandler<dim>           &_dof_handler,
+                          const dealii::MappingQ1<dim>    &_mapping,
+                          mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+                          solutionHandler<dim>            &_solution_handler);
 
   /**
    * \brief Destructor.
@@ -66,6 +78,12 @@ public:
   void
   init() override;
 
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
   /**
    * \brief Solve a single update step.
    */
@@ -73,6 +91,24 @@ public:
   solve() override;
 
 private:
+  /**
+   * \brief Get the linear solver of a field.
+   */
+  [[nodiscard]] linearSolverBase<dim, degree> *
+  get_linear_solver(unsigned int index) const;
+
+  /**
+   * \brief Set up the batched solve of the fields that enable it.
+   */
+  void
+  init_batch();
+
+  /**
+   * \brief Solve the batched fields together.
+   */
+  void
+  solve_batch();
+
   /**
    * \brief Map of identity linear solvers
    */
@@ -82,19 +118,45 @@ private:
    * \brief Map of geometric multigrid linear solvers
    */
   std::map<unsigned int, std::unique_ptr<GMGSolver<dim, degree>>> gmg_solvers;
+
+  /**
+   * \brief Map of linear solvers with Jacobi or Chebyshev preconditioners
+   */
+  std::map<unsigned int, std::unique_ptr<jacobiSolver<dim, degree>>> jacobi_solvers;
+
+  /**
+   * \brief Global indices of the batched fields. The position in this vector is the
+   * block of the field.
+   */
+  std::vector<unsigned int> batched_fields;
+
+  /**
+   * \brief Residual block vector of the batched fields.
+   */
+  BlockVectorType batch_residual;
+
+  /**
+   * \brief Newton update block vector of the batched fields.
+   */
+  BlockVectorType batch_newton_update;
+
+  /**
+   * \brief Block diagonal preconditioner of the batched fields.
+   */
+  dealii::DiagonalMatrix<BlockVectorType> batch_preconditioner;
 };
 
 template <int dim, int degree>
 nonexplicitLinearSolver<dim, degree>::nonexplicitLinearSolver(
-  const userInputParameters<dim>                       &_user_inputs,
-  const matrixfreeHandler<dim>                         &_matrix_free_handler,
-  const triangulationHandler<dim>                      &_triangulation_handler,
-  const invmHandler<dim, degree>                       &_invm_handler,
-  const constraintHandler<dim>                         &_constraint_handler,
-  const dofHandler<dim>                                &_dof_handler,
-  const dealii::MappingQ1<dim>                         &_mapping,
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-  solutionHandler<dim>                                 &_solution_handler)
+  const userInputParameters<dim>  &_user_inputs,
+  const matrixfreeHandler<dim>    &_matrix_free_handler,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const invmHandler<dim, degree>  &_invm_handler,
+  const constraintHandler<dim>    &_constraint_handler,
+  const dofHandler<dim>           &_dof_handler,
+  const dealii::MappingQ1<dim>    &_mapping,
+  mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+  solutionHandler<dim>            &_solution_handler)
   : nonexplicitBase<dim, degree>(_user_inputs,
                                  _matrix_free_handler,
                                  _triangulation_handler,
@@ -102,7 +164,7 @@ nonexplicitLinearSolver<dim, degree>::nonexplicitLinearSolver(
                                  _constraint_handler,
                                  _dof_handler,
                                  _mapping,
-                                 _mg_matrix_free_handler,
+                                 _mg_hierarchy_handler,
                                  _solution_handler)
 {}
 
@@ -122,6 +184,15 @@ nonexplicitLinearSolver<dim, degree>::init()
 
   for (const auto &[index, variable] : this->subset_attributes)
     {
+      // Skipped solves keep the previous solution, which is only valid for fields
+      // without an explicit time dependence
+      AssertThrow(this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                        .resolve_criterion == resolveCriterion::ALWAYS_RESOLVE ||
+                    variable.pde_type == PDEType::TIME_INDEPENDENT,
+                  dealii::ExcMessage("The resolve criterion of the field " +
+                                     variable.name +
+                                     " requires a time-independent field."));
+
       if (this->user_inputs.linear_solve_parameters.linear_solve.at(index)
             .preconditioner == preconditionerType::GMG)
         {
@@ -131,12 +202,27 @@ nonexplicitLinearSolver<dim, degree>::init()
                                                      variable,
                                                      this->matrix_free_handler,
                                                      this->constraint_handler,
-                                                     this->triangulation_handler,
                                                      this->dof_handler,
-                                                     this->mg_matrix_free_handler,
+                                                     this->mg_hierarchy_handler,
                                                      this->solution_handler));
           gmg_solvers.at(index)->init();
         }
+      else if (this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                   .preconditioner == preconditionerType::JACOBI ||
+               this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                   .preconditioner == preconditionerType::CHEBYSHEV ||
+               this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                   .preconditioner == preconditionerType::CELL_PATCH)
+        {
+          jacobi_solvers.emplace(
+            index,
+            std::make_unique<jacobiSolver<dim, degree>>(this->user_inputs,
+                                                        variable,
+                                                        this->matrix_free_handler,
+                                                        this->constraint_handler,
+                                                        this->solution_handler));
+          jacobi_solvers.at(index)->init();
+        }
       else
         {
           identity_solvers.emplace(
@@ -149,6 +235,28 @@ nonexplicitLinearSolver<dim, degree>::init()
           identity_solvers.at(index)->init();
         }
     }
+
+  init_batch();
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitLinearSolver<dim, degree>::reinit()
+{
+  for (auto &[index, solver] : gmg_solvers)
+    {
+      solver->reinit();
+    }
+  for (auto &[index, solver] : jacobi_solvers)
+    {
+      solver->reinit();
+    }
+  for (auto &[index, solver] : identity_solvers)
+    {
+      solver->reinit();
+    }
+
+  init_batch();
 }
 
 template <int dim, int degree>
@@ -161,13 +269,31 @@ nonexplicitLinearSolver<dim, degree>::solve()
       return;
     }
 
+  if (!batched_fields.empty())
+    {
+      solve_batch();
+    }
+
   for (const auto &[index, variable] : this->subset_attributes)
     {
+      if (std::find(batched_fields.begin(), batched_fields.end(), index) !=
+          batched_fields.end())
+        {
+          continue;
+        }
+      if (get_linear_solver(index)->try_skip_solve())
+        {
+          continue;
+        }
       if (this->user_inputs.linear_solve_parameters.linear_solve.at(index)
             .preconditioner == preconditionerType::GMG)
         {
           gmg_solvers.at(index)->solve();
         }
+      else if (jacobi_solvers.find(index) != jacobi_solvers.end())
+        {
+          jacobi_solvers.at(index)->solve();
+        }
       else
         {
           identity_solvers.at(index)->solve();
@@ -175,6 +301,129 @@ nonexplicitLinearSolver<dim, degree>::solve()
     }
 }
 
+template <int dim, int degree>
+inline linearSolverBase<dim, degree> *
+nonexplicitLinearSolver<dim, degree>::get_linear_solver(unsigned int index) const
+{
+  if (gmg_solvers.find(index) != gmg_solvers.end())
+    {
+      return gmg_solvers.at(index).get();
+    }
+  if (jacobi_solvers.find(index) != jacobi_solvers.end())
+    {
+      return jacobi_solvers.at(index).get();
+    }
+  return identity_solvers.at(index).get();
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitLinearSolver<dim, degree>::init_batch()
+{
+  batched_fields.clear();
+  for (const auto &[index, variable] : this->subset_attributes)
+    {
+      if (this->user_inputs.linear_solve_parameters.linear_solve.at(index).batched_solve)
+        {
+          batched_fields.push_back(index);
+        }
+    }
+
+  // A single field gains nothing from batching
+  if (batched_fields.size() < 2)
+    {
+      batched_fields.clear();
+      return;
+    }
+
+  // The batched fields are solved before the others, so they must not depend on them
+  for (const auto &index : batched_fields)
+    {
+      const auto &variable = this->subset_attributes.at(index);
+      for (const auto &[other_index, other_variable] : this->subset_attributes)
+        {
+          AssertThrow(other_index == index ||
+                        (variable.dependency_set_RHS.find(other_index) ==
+                           variable.dependency_set_RHS.end() &&
+                         variable.dependency_set_LHS.find(other_index) ==
+                           variable.dependency_set_LHS.end()),
+                      dealii::ExcMessage("The batched field " + variable.name +
+                                         " must not depend on the linear field " +
+                                         other_variable.name + "."));
+        }
+    }
+
+  const unsigned int n_blocks = batched_fields.size();
+  batch_residual.reinit(n_blocks);
+  batch_newton_update.reinit(n_blocks);
+  batch_preconditioner.get_vector().reinit(n_blocks);
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      this->matrix_free_handler.get_matrix_free()->initialize_dof_vector(
+        batch_residual.block(block),
+        batched_fields[block]);
+      this->matrix_free_handler.get_matrix_free()->initialize_dof_vector(
+        batch_newton_update.block(block),
+        batched_fields[block]);
+      this->matrix_free_handler.get_matrix_free()->initialize_dof_vector(
+        batch_preconditioner.get_vector().block(block),
+        batched_fields[block]);
+    }
+  batch_residual.collect_sizes();
+  batch_newton_update.collect_sizes();
+  batch_preconditioner.get_vector().collect_sizes();
+}
+
+template <int dim, int degree>
+inline void
+nonexplicitLinearSolver<dim, degree>::solve_batch()
+{
+  std::vector<const OperatorType *>    operators;
+  std::vector<dealii::SolverControl *> solver_controls;
+  for (unsigned int block = 0; block < batched_fields.size(); ++block)
+    {
+      const unsigned int index  = batched_fields[block];
+      auto              *solver = get_linear_solver(index);
+
+      solver->begin_batched_solve();
+      batch_residual.block(block).copy_locally_owned_data_from(solver->get_residual());
+      batch_newton_update.block(block).copy_locally_owned_data_from(
+        solver->get_newton_update());
+      if (jacobi_solvers.find(index) != jacobi_solvers.end())
+        {
+          batch_preconditioner.get_vector().block(block).copy_locally_owned_data_from(
+            jacobi_solvers.at(index)->get_inverse_diagonal());
+        }
+      else
+        {
+          batch_preconditioner.get_vector().block(block) = 1.0;
+        }
+
+      operators.push_back(&solver->get_update_system_matrix());
+      solver_controls.push_back(&solver->get_solver_control());
+    }
+
+  // Fields that did not converge are reported when their solve is finished
+  try
+    {
+      batchedCG<BlockVectorType> cg(solver_controls);
+      cg.solve(batchedOperator<dim, degree, double>(operators),
+               batch_newton_update,
+               batch_residual,
+               batch_preconditioner);
+    }
+  catch (const dealii::SolverControl::NoConvergence &)
+    {}
+
+  for (unsigned int block = 0; block < batched_fields.size(); ++block)
+    {
+      auto *solver = get_linear_solver(batched_fields[block]);
+      solver->get_newton_update().copy_locally_owned_data_from(
+        batch_newton_update.block(block));
+      solver->end_batched_solve();
+    }
+}
+
 PRISMS_PF_END_NAMESPACE
 
 #endif
\ No newline at end of file
@@ -5,6 +5,8 @@
 #define nonexplicit_self_nonlinear_solver_h
 
 #include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/solvers/linear_solver_base.h>
 
 #ifdef PRISMS_PF_WITH_CALIPER
 #  include <caliper/cali.h>
@@ -30,16 +32,15 @@ public:
   /**
    * \brief Constructor.
    */
-  nonexplicitSelfNonlinearSolver(
-    const userInputParameters<dim>                       &_user_inputs,
-    const matrixfreeHandler<dim>                         &_matrix_free_handler,
-    const triangulationHandler<dim>                      &_triangulation_handler,
-    const invmHandler<dim, degree>                       &_invm_handler,
-    const constraintHandler<dim>                         &_constraint_handler,
-    const dofHandler<dim>                                &_dof_handler,
-    const dealii::MappingQ1<dim>                         &_mapping,
-    dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-    solutionHandler<dim>                                 &_solution_handler);
+  nonexplicitSelfNonlinearSolver(const userInputParameters<dim>  &_user_inputs,
+                                 const matrixfreeHandler<dim>    &_matrix_free_handler,
+                                 const triangulationHandler<dim> &_triangulation_handler,
+                                 const invmHandler<dim, degree>  &_invm_handler,
+                                 const constraintHandler<dim>    &_constraint_handler,
+                                 const dofHandler<dim>           &_dof_handler,
+                                 const dealii::MappingQ1<dim>    &_mapping,
+                                 mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+                                 solutionHandler<dim>            &_solution_handler);
 
   /**
    * \brief Destructor.
@@ -52,6 +53,12 @@ public:
   void
   init() override;
 
+  /**
+   * \brief Reinitialize system after the mesh has changed.
+   */
+  void
+  reinit() override;
+
   /**
    * \brief Solve a single update step.
    */
@@ -68,19 +75,24 @@ private:
    * \brief Map of geometric multigrid linear solvers
    */
   std::map<unsigned int, std::unique_ptr<GMGSolver<dim, degree>>> gmg_solvers;
+
+  /**
+   * \brief Map of linear solvers with Jacobi or Chebyshev preconditioners
+   */
+  std::map<unsigned int, std::unique_ptr<jacobiSolver<dim, degree>>> jacobi_solvers;
 };
 
 template <int dim, int degree>
 nonexplicitSelfNonlinearSolver<dim, degree>::nonexplicitSelfNonlinearSolver(
-  const userInputParameters<dim>                       &_user_inputs,
-  const matrixfreeHandler<dim>                         &_matrix_free_handler,
-  const triangulationHandler<dim>                      &_triangulation_handler,
-  const invmHandler<dim, degree>                       &_invm_handler,
-  const constraintHandler<dim>                         &_constraint_handler,
-  const dofHandler<dim>                                &_dof_handler,
-  const dealii::MappingQ1<dim>                         &_mapping,
-  dealii::MGLevelObject<matrixfreeHandler<dim, float>> &_mg_matrix_free_handler,
-  solutionHandler<dim>                                 &_solution_handler)
+  const userInputParameters<dim>  &_user_inputs,
+  const matrixfreeHandler<dim>    &_matrix_free_handler,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const invmHandler<dim, degree>  &_invm_handler,
+  const constraintHandler<dim>    &_constraint_handler,
+  const dofHandler<dim>           &_dof_handler,
+  const dealii::MappingQ1<dim>    &_mapping,
+  mgHierarchyHandler<dim>         &_mg_hierarchy_handler,
+  solutionHandler<dim>            &_solution_handler)
   : nonexplicitBase<dim, degree>(_user_inputs,
                                  _matrix_free_handler,
                                  _triangulation_handler,
@@ -88,7 +100,7 @@ nonexplicitSelfNonlinearSolver<dim, degree>::nonexplicitSelfNonlinearSolver(
                                  _constraint_handler,
                                  _dof_handler,
                                  _mapping,
-                                 _mg_matrix_free_handler,
+                                 _mg_hierarchy_handler,
                                  _solution_handler)
 {}
 
@@ -117,12 +129,27 @@ nonexplicitSelfNonlinearSolver<dim, degree>::init()
                                                      variable,
                                                      this->matrix_free_handler,
                                                      this->constraint_handler,
-                                                     this->triangulation_handler,
                                                      this->dof_handler,
-                                                     this->mg_matrix_free_handler,
+                                                     this->mg_hierarchy_handler,
                                                      this->solution_handler));
           gmg_solvers.at(index)->init();
         }
+      else if (this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                   .preconditioner == preconditionerType::JACOBI ||
+               this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                   .preconditioner == preconditionerType::CHEBYSHEV ||
+               this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+                   .preconditioner == preconditionerType::CELL_PATCH)
+        {
+          jacobi_solvers.emplace(
+            index,
+            std::make_unique<jacobiSolver<dim, degree>>(this->user_inputs,
+                                                        variable,
+                                                        this->matrix_free_handler,
+                                                        this->constraint_handler,
+                                                        this->solution_handler));
+          jacobi_solvers.at(index)->init();
+        }
       else
         {
           identity_solvers.emplace(
@@ -137,6 +164,24 @@ nonexplicitSelfNonlinearSolver<dim, degree>::init()
     }
 }
 
+template <int dim, int degree>
+inline void
+nonexplicitSelfNonlinearSolver<dim, degree>::reinit()
+{
+  for (auto &[index, solver] : gmg_solvers)
+    {
+      solver->reinit();
+    }
+  for (auto &[index, solver] : jacobi_solvers)
+    {
+      solver->reinit();
+    }
+  for (auto &[index, solver] : identity_solvers)
+    {
+      solver->reinit();
+    }
+}
+
 template <int dim, int degree>
 inline void
 nonexplicitSelfNonlinearSolver<dim, degree>::solve()
@@ -149,36 +194,117 @@ nonexplicitSelfNonlinearSolver<dim, degree>::solve()
 
   for (const auto &[index, variable] : this->subset_attributes)
     {
-      bool         is_converged = true;
-      unsigned int iteration    = 0;
-      auto        &step_length =
-        this->user_inputs.nonlinear_solve_parameters.nonlinear_solve.at(index)
-          .step_length;
+      const auto &parameters =
+        this->user_inputs.nonlinear_solve_parameters.nonlinear_solve.at(index);
 
-      while (is_converged)
+      linearSolverBase<dim, degree> *linear_solver = nullptr;
+      if (this->user_inputs.linear_solve_parameters.linear_solve.at(index)
+            .preconditioner == preconditionerType::GMG)
         {
-          is_converged = false;
+          linear_solver = gmg_solvers.at(index).get();
+        }
+      else if (jacobi_solvers.find(index) != jacobi_solvers.end())
+        {
+          linear_solver = jacobi_solvers.at(index).get();
+        }
+      else
+        {
+          linear_solver = identity_solvers.at(index).get();
+        }
 
-          // Perform the linear solve with the step length
-          if (this->user_inputs.linear_solve_parameters.linear_solve.at(index)
-                .preconditioner == preconditionerType::GMG)
+      const auto *solution = this->solution_handler.solution_set.at(
+        std::make_pair(index, dependencyType::NORMAL));
+
+      // Compute the initial residual. This is reused by the first linear solve.
+      double       residual_norm           = linear_solver->compute_residual_norm();
+      const double initial_residual_norm   = residual_norm;
+      double       forcing_term            = parameters.max_forcing_term;
+      double       update_norm             = 0.0;
+      unsigned int iteration               = 0;
+      unsigned int total_linear_iterations = 0;
+
+      const auto is_converged = [&]()
+      {
+        const bool residual_converged =
+          parameters.tolerance_type == solverToleranceType::ABSOLUTE_RESIDUAL
+            ? residual_norm < parameters.tolerance
+            : residual_norm < parameters.tolerance * initial_residual_norm;
+        const bool update_converged =
+          iteration > 0 && parameters.update_tolerance > 0.0 &&
+          update_norm <= parameters.update_tolerance * solution->l2_norm();
+        return residual_converged || update_converged;
+      };
+
+      while (!is_converged() && iteration < parameters.max_iterations)
+        {
+          // Set the linear solver tolerance relative to the current residual
+          if (parameters.use_eisenstat_walker)
             {
-              gmg_solvers.at(index)->solve(step_length);
+              linear_solver->set_forcing_term(forcing_term);
             }
-          else
+
+          // Only the first Newton update of each time step is extrapolated from the
+          // previous ones
+          linear_solver->set_use_update_history(iteration == 0);
+
+          // Perform the linear solve with the step length
+          double step_length =
+            parameters.backtrack_line_search ? 1.0 : parameters.step_length;
+          linear_solver->solve(step_length);
+          total_linear_iterations += linear_solver->get_n_linear_iterations();
+
+          // Backtrack until the residual decreases sufficiently. The residual of the
+          // accepted step is reused by the next linear solve.
+          double             new_residual_norm = linear_solver->compute_residual_norm();
+          const unsigned int n_backtracks      = this->backtrack_line_search(
+            parameters,
+            residual_norm,
+            step_length,
+            new_residual_norm,
+            [&](const double &delta)
+            {
+              linear_solver->add_newton_update(delta);
+            },
+            [&]()
             {
-              identity_solvers.at(index)->solve(step_length);
+              return linear_solver->compute_residual_norm();
+            });
+          update_norm = step_length * linear_solver->get_newton_update_norm();
+
+          if (parameters.use_eisenstat_walker)
+            {
+              forcing_term = this->compute_forcing_term(parameters,
+                                                        forcing_term,
+                                                        residual_norm,
+                                                        new_residual_norm,
+                                                        initial_residual_norm);
             }
 
+          residual_norm = new_residual_norm;
           iteration++;
 
-          if (iteration <
-              this->user_inputs.nonlinear_solve_parameters.nonlinear_solve.at(index)
-                .max_iterations)
-            {
-              is_converged = true;
-            }
+          conditionalOStreams::pout_summary()
+            << "  field: " << index << " Newton iteration: " << iteration
+            << " Residual: " << residual_norm << " Update: " << update_norm
+            << " Step length: " << step_length << " Backtracks: " << n_backtracks
+            << " Linear steps: " << linear_solver->get_n_linear_iterations() << "\n"
+            << std::flush;
         }
+
+      if (!is_converged())
+        {
+          conditionalOStreams::pout_base()
+            << "Warning: nonlinear solver for field " << index
+            << " did not converge in " << iteration << " iterations. Residual: "
+            << residual_norm << "\n";
+        }
+
+      conditionalOStreams::pout_summary()
+        << "  field: " << index << " Newton iterations: " << iteration
+        << " Linear iterations: " << total_linear_iterations
+        << " Initial residual: " << initial_residual_norm
+        << " Final residual: " << residual_norm << "\n"
+        << std::flush;
     }
 }
 
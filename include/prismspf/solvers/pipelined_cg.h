@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef pipelined_cg_h
+#define pipelined_cg_h
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <prismspf/config.h>
+
+#include <array>
+#include <cmath>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Pipelined preconditioned conjugate gradient solver (Ghysels and Vanroose). All
+ * dot products of an iteration are fused into one global reduction, which runs in the
+ * background while the preconditioner and the operator are applied. This hides the
+ * latency of the reduction on large MPI runs, where standard CG is bound by its two or
+ * three blocking reductions per iteration.
+ *
+ * The vector updates of an iteration are fused into a single pass over the locally owned
+ * entries, which also computes the local dot products of the next iteration. The price is
+ * more auxiliary vectors than standard CG, one more operator and preconditioner
+ * application per solve, and a residual that is updated by recurrence. The latter limits
+ * the attainable accuracy, so for badly conditioned systems the solver may stagnate above
+ * tolerances that standard CG reaches. It is meant to be used with a good
+ * preconditioner, such as GMG.
+ */
+template <typename VectorType>
+class pipelinedCG
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  explicit pipelinedCG(dealii::SolverControl &_solver_control);
+
+  /**
+   * \brief Solve the system Ax=b, starting from the given solution.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType         &matrix,
+        VectorType               &solution,
+        const VectorType         &rhs,
+        const PreconditionerType &preconditioner);
+
+private:
+  /**
+   * \brief Start the global reduction of the local dot products.
+   */
+  void
+  start_reduction(const MPI_Comm &communicator);
+
+  /**
+   * \brief Wait for the global reduction of the local dot products to finish.
+   */
+  void
+  finish_reduction();
+
+  /**
+   * \brief Solver control.
+   */
+  dealii::SolverControl &solver_control;
+
+  /**
+   * \brief Local dot products (r,r), (r,u), and (w,u).
+   */
+  std::array<double, 3> local_products {};
+
+  /**
+   * \brief Global dot products (r,r), (r,u), and (w,u).
+   */
+  std::array<double, 3> products {};
+
+#ifdef DEAL_II_WITH_MPI
+  /**
+   * \brief Request of the nonblocking reduction.
+   */
+  MPI_Request request = MPI_REQUEST_NULL;
+#endif
+};
+
+template <typename VectorType>
+pipelinedCG<VectorType>::pipelinedCG(dealii::SolverControl &_solver_control)
+  : solver_control(_solver_control)
+{}
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+inline void
+pipelinedCG<VectorType>::solve(const MatrixType         &matrix,
+                               VectorType               &solution,
+                               const VectorType         &rhs,
+                               const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  const MPI_Comm communicator = solution.get_partitioner()->get_mpi_communicator();
+
+  // Following the notation of Ghysels and Vanroose, u = M r, w = A u, m = M w, n = A m,
+  // and p, s, q, z are the search direction and its images under A, M A, and A M A.
+  VectorType residual;
+  VectorType u;
+  VectorType w;
+  VectorType m;
+  VectorType n;
+  VectorType p;
+  VectorType s;
+  VectorType q;
+  VectorType z;
+  residual.reinit(solution, true);
+  u.reinit(solution, true);
+  w.reinit(solution, true);
+  m.reinit(solution, true);
+  n.reinit(solution, true);
+  p.reinit(solution, true);
+  s.reinit(solution, true);
+  q.reinit(solution, true);
+  z.reinit(solution, true);
+
+  matrix.vmult(residual, solution);
+  residual.sadd(-1.0, 1.0, rhs);
+  preconditioner.vmult(u, residual);
+  matrix.vmult(w, u);
+
+  const unsigned int n_local = solution.locally_owned_size();
+  local_products.fill(0.0);
+  for (unsigned int i = 0; i < n_local; ++i)
+    {
+      local_products[0] += residual.local_element(i) * residual.local_element(i);
+      local_products[1] += residual.local_element(i) * u.local_element(i);
+      local_products[2] += w.local_element(i) * u.local_element(i);
+    }
+
+  unsigned int iteration      = 0;
+  double       previous_gamma = 0.0;
+  double       previous_alpha = 0.0;
+  auto         state          = dealii::SolverControl::iterate;
+  while (true)
+    {
+      // Overlap the reduction with the preconditioner and operator applications
+      start_reduction(communicator);
+      preconditioner.vmult(m, w);
+      matrix.vmult(n, m);
+      finish_reduction();
+
+      state = solver_control.check(iteration, std::sqrt(std::abs(products[0])));
+      if (state != dealii::SolverControl::iterate)
+        {
+          break;
+        }
+
+      const double gamma = products[1];
+      const double delta = products[2];
+      const double beta  = iteration == 0 ? 0.0 : gamma / previous_gamma;
+      const double curvature =
+        iteration == 0 ? delta : delta - beta * gamma / previous_alpha;
+      AssertThrow(curvature > 0.0,
+                  dealii::ExcMessage("Pipelined CG requires a symmetric positive "
+                                     "definite operator and preconditioner."));
+      const double alpha = gamma / curvature;
+
+      // Update all vectors in a single pass and compute the local dot products of the
+      // next iteration along the way
+      const auto beta_number  = static_cast<number>(beta);
+      const auto alpha_number = static_cast<number>(alpha);
+      number    *x_data       = solution.begin();
+      number    *r_data       = residual.begin();
+      number    *u_data       = u.begin();
+      number    *w_data       = w.begin();
+      number    *m_data       = m.begin();
+      number    *n_data       = n.begin();
+      number    *p_data       = p.begin();
+      number    *s_data       = s.begin();
+      number    *q_data       = q.begin();
+      number    *z_data       = z.begin();
+      local_products.fill(0.0);
+      for (unsigned int i = 0; i < n_local; ++i)
+        {
+          z_data[i] = n_data[i] + beta_number * z_data[i];
+          q_data[i] = m_data[i] + beta_number * q_data[i];
+          s_data[i] = w_data[i] + beta_number * s_data[i];
+          p_data[i] = u_data[i] + beta_number * p_data[i];
+          x_data[i] += alpha_number * p_data[i];
+          r_data[i] -= alpha_number * s_data[i];
+          u_data[i] -= alpha_number * q_data[i];
+          w_data[i] -= alpha_number * z_data[i];
+
+          local_products[0] += r_data[i] * r_data[i];
+          local_products[1] += r_data[i] * u_data[i];
+          local_products[2] += w_data[i] * u_data[i];
+        }
+
+      previous_gamma = gamma;
+      previous_alpha = alpha;
+      iteration++;
+    }
+
+  AssertThrow(state == dealii::SolverControl::success,
+              dealii::SolverControl::NoConvergence(solver_control.last_step(),
+                                                   solver_control.last_value()));
+}
+
+template <typename VectorType>
+inline void
+pipelinedCG<VectorType>::start_reduction([[maybe_unused]] const MPI_Comm &communicator)
+{
+#ifdef DEAL_II_WITH_MPI
+  if (dealii::Utilities::MPI::job_supports_mpi())
+    {
+      const int ierr = MPI_Iallreduce(local_products.data(),
+                                      products.data(),
+                                      static_cast<int>(products.size()),
+                                      MPI_DOUBLE,
+                                      MPI_SUM,
+                                      communicator,
+                                      &request);
+      AssertThrowMPI(ierr);
+      return;
+    }
+#endif
+  products = local_products;
+}
+
+template <typename VectorType>
+inline void
+pipelinedCG<VectorType>::finish_reduction()
+{
+#ifdef DEAL_II_WITH_MPI
+  if (request != MPI_REQUEST_NULL)
+    {
+      const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+    }
+#endif
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
@@ -108,6 +108,12 @@ public:
   void
   declare_checkpoint_parameters();
 
+  /**
+   * \brief Declare parameters for parareal time-parallel solves.
+   */
+  void
+  declare_parareal_parameters();
+
   /**
    * \brief Declare parameters for boundary conditions.
    */
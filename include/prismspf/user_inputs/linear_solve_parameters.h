@@ -4,9 +4,12 @@
 #ifndef linear_solve_parameters_h
 #define linear_solve_parameters_h
 
+#include <deal.II/base/exceptions.h>
+
 #include <prismspf/config.h>
 #include <prismspf/core/conditional_ostreams.h>
 #include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attributes.h>
 
 #include <map>
 
@@ -27,20 +30,106 @@ public:
   // Max number of iterations for the linear solve
   unsigned int max_iterations = 100;
 
-  // Preconditioner
+  // Krylov method. CG requires a symmetric positive definite operator.
+  linearSolverType solver_type = linearSolverType::SOLVER_CG;
+
+  // Number of GMRES and FGMRES iterations between restarts
+  unsigned int gmres_restart = 30;
+
+  // Number of approximate eigenvectors that CG recycles between solves to deflate the
+  // slowest modes. A value of zero disables this.
+  unsigned int recycled_subspace_size = 0;
+
+  // Initial guess for the Krylov solve. The extrapolations use the updates of the
+  // previous solves, assuming a constant time step, and POD projects the system onto
+  // the span of the last few updates.
+  initialGuessType initial_guess = initialGuessType::ZERO_INITIAL_GUESS;
+
+  // Number of previous updates that span the subspace of the POD initial guess
+  unsigned int initial_guess_history = 4;
+
+  // Whether to linearize the LHS once per solve and cache the coefficients at each
+  // quadrature point, so that operator applications only act on the change.
+  bool frozen_linearization = false;
+
+  // Whether the Krylov iterations run in single precision. The single precision solves
+  // are corrected with the defect in double precision until the tolerance is met.
+  bool mixed_precision = false;
+
+  // Residual reduction of the single precision solve in each refinement step
+  double mixed_precision_reduction = 1.0e-3;
+
+  // Whether this field is solved together with the other decoupled linear fields that
+  // enable this, with a single batched CG
+  bool batched_solve = false;
+
+  // When a TIME_INDEPENDENT field is solved again. Otherwise, it keeps the previous
+  // solution.
+  resolveCriterion resolve_criterion = resolveCriterion::ALWAYS_RESOLVE;
+
+  // Threshold of the resolve criterion. For the residual criterion, this is relative to
+  // the residual at the start of the last solve. For the dependency change criterion,
+  // this is the relative change of each dependency since the last solve.
+  double resolve_tolerance = 1.0e-3;
+
+  // Maximum number of consecutive increments without a solve. A value of zero removes
+  // the limit.
+  unsigned int max_skipped_solves = 10;
+
+  // Whether the Jacobian-vector products are finite differences of the residual. The
+  // user LHS is then only used to build the preconditioner.
+  bool jacobian_free = false;
+
+  // Whether to compare the user LHS against finite differences of the residual before
+  // each solve
+  bool check_jacobian = false;
+
+  // Preconditioner. The cell patch preconditioner is an additive Schwarz method with
+  // one block per cell, inverted by fast diagonalization.
   preconditionerType preconditioner = preconditionerType::GMG;
 
   // Smoothing range for eigenvalues. This denotes the lower bound of eigenvalues that are
   // smoothed [1.2 λ^max / smoothing_range, 1.2 λ^max], where λ^max is the estimated
   // maximum eigenvalue. A choice between 5 and 20 is usually useful when the
-  // preconditioner is used as a smoother in multigrid.
+  // preconditioner is used as a smoother in multigrid. For the standalone Chebyshev
+  // preconditioner, larger values approximate the inverse better.
   double smoothing_range = 15.0;
 
-  // Polynomial degree for the Chebyshev smoother
+  // Polynomial degree for the Chebyshev smoother and preconditioner
   unsigned int smoother_degree = 5;
 
   // Maximum number of CG iterations used to find the maximum eigenvalue
   unsigned int eig_cg_n_iterations = 10;
+
+  // Number of solves between rebuilds of the preconditioner (the diagonals and Chebyshev
+  // eigenvalue estimates). A value of zero never rebuilds it after the first solve.
+  unsigned int preconditioner_rebuild_period = 1;
+
+  // Percentage growth of the number of linear iterations, relative to the first solve
+  // after the last rebuild, that triggers a rebuild of the preconditioner. A value of
+  // zero disables this.
+  double preconditioner_rebuild_iteration_growth = 0.0;
+
+  // Sequence of polynomial degrees for the multigrid preconditioner. If enabled, the
+  // finest mesh is first coarsened in degree down to linear elements, after which the
+  // mesh itself is coarsened.
+  polynomialCoarseningType polynomial_coarsening =
+    polynomialCoarseningType::NO_POLYNOMIAL_COARSENING;
+
+  // Preconditioner of the Chebyshev smoother on each multigrid level. The cell patch
+  // smoother is more robust in the polynomial degree than point-Jacobi, but assumes
+  // Cartesian cells and a Laplace-like operator.
+  smootherType smoother_type = smootherType::JACOBI_SMOOTHER;
+
+  // Solver for the coarsest multigrid level. The AMG and direct solvers assemble the
+  // coarse operator and require deal.II with Trilinos or PETSc.
+  coarseSolverType coarse_solver = coarseSolverType::COARSE_SMOOTHER;
+
+  // Relative residual reduction for the iterative coarse solvers
+  double coarse_tolerance = 1.0e-10;
+
+  // Max number of iterations for the iterative coarse solvers
+  unsigned int coarse_max_iterations = 1000;
 };
 
 /**
@@ -53,7 +142,8 @@ public:
    * \brief Postprocess and validate parameters.
    */
   void
-  postprocess_and_validate();
+  postprocess_and_validate(
+    const std::map<unsigned int, variableAttributes> &var_attributes);
 
   /**
    * \brief Print parameters to summary.log
@@ -66,9 +156,110 @@ public:
 };
 
 inline void
-linearSolveParameters::postprocess_and_validate()
+linearSolveParameters::postprocess_and_validate(
+  const std::map<unsigned int, variableAttributes> &var_attributes)
 {
-  // Nothing to do here for now
+  for (const auto &[index, linear_solver_parameters] : linear_solve)
+    {
+      AssertThrow(linear_solver_parameters.recycled_subspace_size == 0 ||
+                    linear_solver_parameters.solver_type == linearSolverType::SOLVER_CG,
+                  dealii::ExcMessage("Subspace recycling is only available for CG."));
+#ifndef DEAL_II_WITH_LAPACK
+      AssertThrow(linear_solver_parameters.recycled_subspace_size == 0,
+                  dealii::ExcMessage("Subspace recycling requires deal.II with LAPACK."));
+      AssertThrow(linear_solver_parameters.preconditioner !=
+                      preconditionerType::CELL_PATCH &&
+                    (linear_solver_parameters.preconditioner != preconditionerType::GMG ||
+                     linear_solver_parameters.smoother_type !=
+                       smootherType::CELL_PATCH_SMOOTHER),
+                  dealii::ExcMessage(
+                    "The cell patch preconditioner and smoother require deal.II with "
+                    "LAPACK."));
+#endif
+      AssertThrow(!linear_solver_parameters.mixed_precision ||
+                    linear_solver_parameters.preconditioner == preconditionerType::NONE ||
+                    linear_solver_parameters.preconditioner == preconditionerType::GMG,
+                  dealii::ExcMessage(
+                    "Mixed precision is only available with the NONE and GMG "
+                    "preconditioners."));
+      AssertThrow(!linear_solver_parameters.mixed_precision ||
+                    linear_solver_parameters.recycled_subspace_size == 0,
+                  dealii::ExcMessage(
+                    "Mixed precision cannot be combined with subspace recycling."));
+      AssertThrow(!linear_solver_parameters.batched_solve ||
+                    linear_solver_parameters.solver_type == linearSolverType::SOLVER_CG,
+                  dealii::ExcMessage("Batched solves are only available for CG."));
+      AssertThrow(!linear_solver_parameters.batched_solve ||
+                    linear_solver_parameters.preconditioner == preconditionerType::NONE ||
+                    linear_solver_parameters.preconditioner == preconditionerType::JACOBI,
+                  dealii::ExcMessage(
+                    "Batched solves are only available with the NONE and JACOBI "
+                    "preconditioners."));
+      AssertThrow(!linear_solver_parameters.batched_solve ||
+                    (!linear_solver_parameters.mixed_precision &&
+                     linear_solver_parameters.recycled_subspace_size == 0),
+                  dealii::ExcMessage("Batched solves cannot be combined with mixed "
+                                     "precision or subspace recycling."));
+      AssertThrow(!linear_solver_parameters.batched_solve ||
+                    linear_solver_parameters.resolve_criterion ==
+                      resolveCriterion::ALWAYS_RESOLVE,
+                  dealii::ExcMessage(
+                    "Batched solves cannot be combined with skipped solves."));
+      AssertThrow(!linear_solver_parameters.jacobian_free ||
+                    (!linear_solver_parameters.mixed_precision &&
+                     linear_solver_parameters.recycled_subspace_size == 0),
+                  dealii::ExcMessage("Jacobian-free solves cannot be combined with mixed "
+                                     "precision or subspace recycling."));
+      AssertThrow(!linear_solver_parameters.batched_solve ||
+                    (!linear_solver_parameters.jacobian_free &&
+                     !linear_solver_parameters.check_jacobian),
+                  dealii::ExcMessage("Batched solves cannot be combined with "
+                                     "Jacobian-free solves or Jacobian checks."));
+    }
+  // Co-nonlinear fields are solved with GMRES on the coupled system, which only
+  // supports the block versions of some of the options
+  for (const auto &[index, linear_solver_parameters] : linear_solve)
+    {
+      if (var_attributes.at(index).field_solve_type !=
+          fieldSolveType::NONEXPLICIT_CO_NONLINEAR)
+        {
+          continue;
+        }
+      const preconditionerType preconditioner = linear_solver_parameters.preconditioner;
+      AssertThrow(preconditioner == preconditionerType::NONE ||
+                    preconditioner == preconditionerType::JACOBI ||
+                    preconditioner == preconditionerType::GMG,
+                  dealii::ExcMessage(
+                    "Co-nonlinear fields are only available with the NONE, JACOBI, and "
+                    "GMG preconditioners."));
+      AssertThrow(preconditioner != preconditionerType::GMG ||
+                    linear_solver_parameters.coarse_solver ==
+                      coarseSolverType::COARSE_SMOOTHER ||
+                    linear_solver_parameters.coarse_solver ==
+                      coarseSolverType::COARSE_CG,
+                  dealii::ExcMessage(
+                    "The AMG and direct coarse solvers are not available for "
+                    "co-nonlinear fields."));
+      AssertThrow(!linear_solver_parameters.mixed_precision &&
+                    !linear_solver_parameters.batched_solve &&
+                    !linear_solver_parameters.jacobian_free &&
+                    linear_solver_parameters.recycled_subspace_size == 0,
+                  dealii::ExcMessage(
+                    "Co-nonlinear fields cannot be combined with mixed precision, "
+                    "batched or Jacobian-free solves, or subspace recycling."));
+    }
+#if !defined(PRISMS_PF_WITH_TRILINOS) && !defined(PRISMS_PF_WITH_PETSC)
+  for (const auto &[index, linear_solver_parameters] : linear_solve)
+    {
+      AssertThrow(linear_solver_parameters.coarse_solver !=
+                      coarseSolverType::COARSE_AMG &&
+                    linear_solver_parameters.coarse_solver !=
+                      coarseSolverType::COARSE_DIRECT,
+                  dealii::ExcMessage(
+                    "The AMG and direct coarse solvers require PRISMS-PF to be compiled "
+                    "with PRISMS_PF_WITH_TRILINOS or PRISMS_PF_WITH_PETSC."));
+    }
+#endif
 }
 
 inline void
@@ -88,10 +279,76 @@ linearSolveParameters::print_parameter_summary() const
             << "  Tolerance: " << linear_solver_parameters.tolerance << "\n"
             << "  Type: " << to_string(linear_solver_parameters.tolerance_type) << "\n"
             << "  Max iterations: " << linear_solver_parameters.max_iterations << "\n"
+            << "  Solver: " << to_string(linear_solver_parameters.solver_type) << "\n";
+          if (linear_solver_parameters.recycled_subspace_size > 0)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Recycled subspace size: "
+                << linear_solver_parameters.recycled_subspace_size << "\n";
+            }
+          if (linear_solver_parameters.solver_type == linearSolverType::SOLVER_GMRES ||
+              linear_solver_parameters.solver_type == linearSolverType::SOLVER_FGMRES)
+            {
+              conditionalOStreams::pout_summary()
+                << "  GMRES restart: " << linear_solver_parameters.gmres_restart << "\n";
+            }
+          conditionalOStreams::pout_summary()
+            << "  Initial guess: " << to_string(linear_solver_parameters.initial_guess)
+            << "\n";
+          if (linear_solver_parameters.initial_guess == initialGuessType::POD_PROJECTION)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Initial guess history: "
+                << linear_solver_parameters.initial_guess_history << "\n";
+            }
+          if (linear_solver_parameters.frozen_linearization)
+            {
+              conditionalOStreams::pout_summary() << "  Frozen linearization: true\n";
+            }
+          if (linear_solver_parameters.resolve_criterion !=
+              resolveCriterion::ALWAYS_RESOLVE)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Resolve criterion: "
+                << to_string(linear_solver_parameters.resolve_criterion) << "\n"
+                << "  Resolve tolerance: " << linear_solver_parameters.resolve_tolerance
+                << "\n"
+                << "  Max skipped solves: " << linear_solver_parameters.max_skipped_solves
+                << "\n";
+            }
+          if (linear_solver_parameters.batched_solve)
+            {
+              conditionalOStreams::pout_summary() << "  Batched solve: true\n";
+            }
+          if (linear_solver_parameters.jacobian_free)
+            {
+              conditionalOStreams::pout_summary() << "  Jacobian-free: true\n";
+            }
+          if (linear_solver_parameters.check_jacobian)
+            {
+              conditionalOStreams::pout_summary() << "  Check Jacobian: true\n";
+            }
+          if (linear_solver_parameters.mixed_precision)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Mixed precision reduction: "
+                << linear_solver_parameters.mixed_precision_reduction << "\n";
+            }
+          conditionalOStreams::pout_summary()
             << "  Preconditioner: " << to_string(linear_solver_parameters.preconditioner)
             << "\n";
 
-          if (linear_solver_parameters.preconditioner == preconditionerType::GMG)
+          if (linear_solver_parameters.preconditioner != preconditionerType::NONE)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Preconditioner rebuild period: "
+                << linear_solver_parameters.preconditioner_rebuild_period << "\n"
+                << "  Preconditioner rebuild iteration growth: "
+                << linear_solver_parameters.preconditioner_rebuild_iteration_growth
+                << "%\n";
+            }
+          if (linear_solver_parameters.preconditioner == preconditionerType::GMG ||
+              linear_solver_parameters.preconditioner == preconditionerType::CHEBYSHEV)
             {
               conditionalOStreams::pout_summary()
                 << "  Smoothing range: " << linear_solver_parameters.smoothing_range
@@ -101,6 +358,25 @@ linearSolveParameters::print_parameter_summary() const
                 << "  Max eigenvalue CG iterations: "
                 << linear_solver_parameters.eig_cg_n_iterations << "\n";
             }
+          if (linear_solver_parameters.preconditioner == preconditionerType::GMG)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Smoother type: "
+                << to_string(linear_solver_parameters.smoother_type) << "\n"
+                << "  Polynomial coarsening: "
+                << to_string(linear_solver_parameters.polynomial_coarsening) << "\n"
+                << "  Coarse solver: "
+                << to_string(linear_solver_parameters.coarse_solver) << "\n";
+              if (linear_solver_parameters.coarse_solver !=
+                  coarseSolverType::COARSE_SMOOTHER)
+                {
+                  conditionalOStreams::pout_summary()
+                    << "  Coarse tolerance: " << linear_solver_parameters.coarse_tolerance
+                    << "\n"
+                    << "  Coarse max iterations: "
+                    << linear_solver_parameters.coarse_max_iterations << "\n";
+                }
+            }
         }
 
       conditionalOStreams::pout_summary() << "\n" << std::flush;
@@ -4,8 +4,13 @@
 #ifndef nonlinear_solve_parameters_h
 #define nonlinear_solve_parameters_h
 
+#include <deal.II/base/exceptions.h>
+
 #include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/core/type_enums.h>
 #include <prismspf/user_inputs/linear_solve_parameters.h>
+#include <prismspf/utilities.h>
 
 PRISMS_PF_BEGIN_NAMESPACE
 
@@ -20,6 +25,35 @@ public:
 
   // Max number of iterations for the nonlinear solve
   unsigned int max_iterations = 100;
+
+  // Nonlinear solver tolerance
+  double tolerance = 1.0e-10;
+
+  // Nonlinear solver tolerance type
+  solverToleranceType tolerance_type = solverToleranceType::ABSOLUTE_RESIDUAL;
+
+  // Tolerance on the l2-norm of the newton update relative to the l2-norm of the
+  // solution. A value of zero disables this criterion.
+  double update_tolerance = 0.0;
+
+  // Whether to use a backtracking line search
+  bool backtrack_line_search = true;
+
+  // Factor the step length is multiplied by per backtrack (tau)
+  double step_modifier = 0.5;
+
+  // Sufficient decrease coefficient for the residual (c)
+  double residual_decrease_coefficient = 0.5;
+
+  // Smallest step length the line search will try. If the sufficient decrease condition
+  // still fails, the smallest step is accepted rather than failing the solve.
+  double min_step_length = 1.0e-4;
+
+  // Whether to use Eisenstat-Walker adaptive linear solver tolerances
+  bool use_eisenstat_walker = false;
+
+  // Maximum Eisenstat-Walker forcing term
+  double max_forcing_term = 0.9;
 };
 
 /**
@@ -47,7 +81,15 @@ public:
 inline void
 nonlinearSolveParameters::postprocess_and_validate()
 {
-  // Nothing to do here for now
+  for (const auto &[index, nonlinear_solver_parameters] : nonlinear_solve)
+    {
+      AssertThrow(nonlinear_solver_parameters.step_modifier > 0.0 &&
+                    nonlinear_solver_parameters.step_modifier < 1.0,
+                  dealii::ExcMessage("The step size modifier must be in (0, 1)."));
+      AssertThrow(nonlinear_solver_parameters.min_step_length > 0.0 &&
+                    nonlinear_solver_parameters.min_step_length <= 1.0,
+                  dealii::ExcMessage("The minimum step size must be in (0, 1]."));
+    }
 }
 
 inline void
@@ -65,7 +107,31 @@ nonlinearSolveParameters::print_parameter_summary() const
           conditionalOStreams::pout_summary()
             << "Index: " << index << "\n"
             << "  Max iterations: " << nonlinear_solver_parameters.max_iterations << "\n"
-            << "  Step length: " << nonlinear_solver_parameters.step_length << "\n";
+            << "  Tolerance: " << nonlinear_solver_parameters.tolerance << "\n"
+            << "  Type: " << to_string(nonlinear_solver_parameters.tolerance_type)
+            << "\n"
+            << "  Update tolerance: " << nonlinear_solver_parameters.update_tolerance
+            << "\n"
+            << "  Eisenstat-Walker: "
+            << bool_to_string(nonlinear_solver_parameters.use_eisenstat_walker) << "\n"
+            << "  Backtracking line search: "
+            << bool_to_string(nonlinear_solver_parameters.backtrack_line_search)
+            << "\n";
+          if (nonlinear_solver_parameters.backtrack_line_search)
+            {
+              conditionalOStreams::pout_summary()
+                << "  Step size modifier: " << nonlinear_solver_parameters.step_modifier
+                << "\n"
+                << "  Residual decrease coefficient: "
+                << nonlinear_solver_parameters.residual_decrease_coefficient << "\n"
+                << "  Min step size: " << nonlinear_solver_parameters.min_step_length
+                << "\n";
+            }
+          else
+            {
+              conditionalOStreams::pout_summary()
+                << "  Step length: " << nonlinear_solver_parameters.step_length << "\n";
+            }
         }
 
       conditionalOStreams::pout_summary() << "\n" << std::flush;
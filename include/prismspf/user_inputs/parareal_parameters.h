@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#ifndef parareal_parameters_h
+#define parareal_parameters_h
+
+#include <deal.II/base/exceptions.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/user_inputs/temporal_discretization.h>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+/**
+ * \brief Struct that holds parareal (parallel-in-time) parameters.
+ */
+struct pararealParameters
+{
+public:
+  /**
+   * \brief Return whether parareal is enabled.
+   */
+  [[nodiscard]] bool
+  is_enabled() const;
+
+  /**
+   * \brief Postprocess and validate parameters.
+   */
+  void
+  postprocess_and_validate(const temporalDiscretization &temporal_discretization);
+
+  /**
+   * \brief Print parameters to summary.log
+   */
+  void
+  print_parameter_summary() const;
+
+  // Number of time slices. Each time slice is assigned to a group of MPI processes.
+  unsigned int n_time_slices = 1;
+
+  // Ratio of the coarse propagator timestep to the fine propagator timestep
+  unsigned int coarse_timestep_ratio = 10;
+
+  // Maximum number of parareal iterations. A value of zero defaults to the number of
+  // time slices, where parareal is guaranteed to reproduce the serial result.
+  unsigned int max_iterations = 0;
+
+  // Relative tolerance on the change of the slice boundary states between iterations
+  double tolerance = 1.0e-8;
+
+  // Number of fine increments per time slice
+  unsigned int increments_per_slice = 0;
+};
+
+inline bool
+pararealParameters::is_enabled() const
+{
+  return n_time_slices > 1;
+}
+
+inline void
+pararealParameters::postprocess_and_validate(
+  const temporalDiscretization &temporal_discretization)
+{
+  if (!is_enabled())
+    {
+      return;
+    }
+
+  AssertThrow(temporal_discretization.total_increments % n_time_slices == 0,
+              dealii::ExcMessage("The total number of increments must be divisible by "
+                                 "the number of parareal time slices."));
+  increments_per_slice = temporal_discretization.total_increments / n_time_slices;
+
+  AssertThrow(coarse_timestep_ratio > 0 &&
+                increments_per_slice % coarse_timestep_ratio == 0,
+              dealii::ExcMessage("The number of increments per parareal time slice must "
+                                 "be divisible by the coarse timestep ratio."));
+
+  if (max_iterations == 0 || max_iterations > n_time_slices)
+    {
+      max_iterations = n_time_slices;
+    }
+}
+
+inline void
+pararealParameters::print_parameter_summary() const
+{
+  if (!is_enabled())
+    {
+      return;
+    }
+
+  conditionalOStreams::pout_summary()
+    << "================================================\n"
+    << "  Parareal Parameters\n"
+    << "================================================\n"
+    << "Number of time slices: " << n_time_slices << "\n"
+    << "Increments per time slice: " << increments_per_slice << "\n"
+    << "Coarse timestep ratio: " << coarse_timestep_ratio << "\n"
+    << "Max iterations: " << max_iterations << "\n"
+    << "Tolerance: " << tolerance << "\n\n"
+    << std::flush;
+}
+
+PRISMS_PF_END_NAMESPACE
+
+#endif
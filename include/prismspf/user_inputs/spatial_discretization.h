@@ -61,6 +61,9 @@ public:
   // Global refinement of mesh
   unsigned int global_refinement = 0;
 
+  // Whether each process only creates its own partition of the rectangular mesh
+  bool fully_distributed = false;
+
   // Element polynomial degree
   unsigned int degree = 1;
 
@@ -76,6 +79,18 @@ public:
   // The number of steps between remeshing
   unsigned int remeshing_period = UINT_MAX;
 
+  // The extra cost of a cell for each field that varies over it, relative to a bulk
+  // cell. This weights the partitioning after remeshing. Zero disables the weights.
+  double active_field_cost = 0.0;
+
+  // Whether the active field cost is fitted to the measured cost of each process before
+  // each remeshing, with the input value as the starting point
+  bool calibrate_active_field_cost = true;
+
+  // A field is active on a cell if its variation over the cell exceeds this fraction of
+  // its maximum magnitude
+  double active_field_threshold = 1.0e-3;
+
   // The criteria used for remeshing
   std::vector<RefinementCriterion> refinement_criteria;
 };
@@ -104,6 +119,17 @@ spatialDiscretization<dim>::postprocess_and_validate()
     dealii::ExcMessage(
       "Adaptive meshing for the matrix-free method is not currently supported."));
 
+  // The fully distributed mesh is created from its description and can't be refined
+  if (fully_distributed)
+    {
+      AssertThrow(type == TriangulationType::rectangular && dim != 1,
+                  dealii::ExcMessage(
+                    "Fully distributed meshes are only supported for rectangular "
+                    "domains in 2D and 3D."));
+      AssertThrow(!has_adaptivity,
+                  FeatureNotImplemented("Adaptive meshing of fully distributed meshes"));
+    }
+
   // Some check if AMR is enabled
   if (has_adaptivity)
     {
@@ -175,11 +201,16 @@ spatialDiscretization<dim>::print_parameter_summary() const
 
   conditionalOStreams::pout_summary()
     << "Global refinement: " << global_refinement << "\n"
+    << "Fully distributed: " << bool_to_string(fully_distributed) << "\n"
     << "Degree: " << degree << "\n"
     << "Adaptivity enabled: " << bool_to_string(has_adaptivity) << "\n"
     << "Max refinement: " << max_refinement << "\n"
     << "Min refinement: " << min_refinement << "\n"
-    << "Remeshing period: " << remeshing_period << "\n";
+    << "Remeshing period: " << remeshing_period << "\n"
+    << "Active field cost: " << active_field_cost << "\n"
+    << "Calibrate active field cost: " << bool_to_string(calibrate_active_field_cost)
+    << "\n"
+    << "Active field threshold: " << active_field_threshold << "\n";
 
   if (!refinement_criteria.empty())
     {
@@ -29,6 +29,13 @@ public:
   void
   print_parameter_summary() const;
 
+  /**
+   * \brief Return whether the steady-state criterion should be evaluated at the
+   * given increment.
+   */
+  [[nodiscard]] bool
+  should_check_steady_state(unsigned int increment) const;
+
   // Final time
   double final_time = 0.0;
 
@@ -43,8 +50,21 @@ public:
 
   // The current time
   mutable double time = 0.0;
+
+  // Relative change tolerance below which all time-dependent fields are considered to be
+  // at steady-state. A value of zero disables steady-state detection.
+  double steady_state_tolerance = 0.0;
+
+  // Number of increments between steady-state checks
+  unsigned int steady_state_check_period = 1;
 };
 
+inline bool
+temporalDiscretization::should_check_steady_state(unsigned int increment) const
+{
+  return steady_state_tolerance > 0.0 && increment % steady_state_check_period == 0;
+}
+
 inline void
 temporalDiscretization::postprocess_and_validate(
   const std::map<unsigned int, variableAttributes> &var_attributes)
@@ -67,10 +87,15 @@ temporalDiscretization::postprocess_and_validate(
     }
   if (only_time_independent_pdes)
     {
-      total_increments = 1;
+      total_increments       = 1;
+      steady_state_tolerance = 0.0;
       return;
     }
 
+  // Check that the steady-state check period is nonzero
+  AssertThrow(steady_state_check_period > 0,
+              dealii::ExcMessage("The steady-state check period must be at least 1."));
+
   // Check that the timestep is greater than zero
   AssertThrow(dt > 0.0,
               dealii::ExcMessage(
@@ -90,8 +115,15 @@ temporalDiscretization::print_parameter_summary() const
     << "================================================\n"
     << "Timestep: " << dt << "\n"
     << "Total increments: " << total_increments << "\n"
-    << "Final time: " << final_time << "\n\n"
-    << std::flush;
+    << "Final time: " << final_time << "\n";
+
+  if (steady_state_tolerance > 0.0)
+    {
+      conditionalOStreams::pout_summary()
+        << "Steady-state tolerance: " << steady_state_tolerance << "\n"
+        << "Steady-state check period: " << steady_state_check_period << "\n";
+    }
+  conditionalOStreams::pout_summary() << "\n" << std::flush;
 }
 
 PRISMS_PF_END_NAMESPACE
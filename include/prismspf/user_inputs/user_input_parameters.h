@@ -11,6 +11,7 @@
 #include <prismspf/user_inputs/linear_solve_parameters.h>
 #include <prismspf/user_inputs/nonlinear_solve_parameters.h>
 #include <prismspf/user_inputs/output_parameters.h>
+#include <prismspf/user_inputs/parareal_parameters.h>
 #include <prismspf/user_inputs/spatial_discretization.h>
 #include <prismspf/user_inputs/temporal_discretization.h>
 #include <prismspf/user_inputs/user_constants.h>
@@ -54,6 +55,9 @@ public:
   // Checkpoint parameters
   checkpointParameters checkpoint_parameters;
 
+  // Parareal parameters
+  pararealParameters parareal_parameters;
+
   // Boundary parameters
   boundaryParameters<dim> boundary_parameters;
 
@@ -103,6 +107,13 @@ private:
   void
   assign_checkpoint_parameters(dealii::ParameterHandler &parameter_handler);
 
+  /**
+   * \brief Assign the provided user inputs to parameters for anything related to
+   * parareal.
+   */
+  void
+  assign_parareal_parameters(dealii::ParameterHandler &parameter_handler);
+
   /**
    * \brief Assign the provided user inputs to parameters for anything related to
    * loading in initial condition.
@@ -11,6 +11,7 @@
 #include <prismspf/user_inputs/user_input_parameters.h>
 
 #include <map>
+#include <utility>
 #include <vector>
 
 PRISMS_PF_BEGIN_NAMESPACE
@@ -43,14 +44,15 @@ dofHandler<dim>::~dofHandler()
 template <int dim>
 void
 dofHandler<dim>::init(const triangulationHandler<dim> &triangulation_handler,
-                      const std::map<fieldType, dealii::FESystem<dim>> &fe_system)
+                      const FESystemMap               &fe_system)
 {
   // TODO: Fix so we can make unique instances of dof handlers.
   unsigned int n_dofs = 0;
   for (const auto &[index, variable] : user_inputs.var_attributes)
     {
       dof_handlers.at(index)->reinit(triangulation_handler.get_triangulation());
-      dof_handlers.at(index)->distribute_dofs(fe_system.at(variable.field_type));
+      dof_handlers.at(index)->distribute_dofs(
+        fe_system.at(std::make_pair(variable.field_type, variable.degree_reduction)));
 
       n_dofs += dof_handlers.at(index)->n_dofs();
     }
@@ -60,6 +62,23 @@ dofHandler<dim>::init(const triangulationHandler<dim> &triangulation_handler,
     << std::flush;
 }
 
+template <int dim>
+void
+dofHandler<dim>::reinit(const FESystemMap &fe_system)
+{
+  unsigned int n_dofs = 0;
+  for (const auto &[index, variable] : user_inputs.var_attributes)
+    {
+      dof_handlers.at(index)->distribute_dofs(
+        fe_system.at(std::make_pair(variable.field_type, variable.degree_reduction)));
+
+      n_dofs += dof_handlers.at(index)->n_dofs();
+    }
+  conditionalOStreams::pout_summary()
+    << "  number of degrees of freedom: " << n_dofs << "\n"
+    << std::flush;
+}
+
 INSTANTIATE_UNI_TEMPLATE(dofHandler)
 
 PRISMS_PF_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,364 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/matrix_free/evaluation_flags.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/core/field_evaluation.h>
+#include <prismspf/core/grid_refiner.h>
+#include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/refinement_criterion.h>
+#include <prismspf/core/solution_handler.h>
+#include <prismspf/core/triangulation_handler.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+template <int dim, int degree>
+gridRefiner<dim, degree>::gridRefiner(
+  const userInputParameters<dim>  &_user_inputs,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const matrixfreeHandler<dim>    &_matrix_free_handler,
+  const solutionHandler<dim>      &_solution_handler)
+  : user_inputs(_user_inputs)
+  , triangulation_handler(_triangulation_handler)
+  , matrix_free_handler(_matrix_free_handler)
+  , solution_handler(_solution_handler)
+  , active_field_cost(_user_inputs.spatial_discretization.active_field_cost)
+{
+  for (const auto &criterion : user_inputs.spatial_discretization.refinement_criteria)
+    {
+      AssertThrow(user_inputs.var_attributes.at(criterion.variable_index).field_type ==
+                    fieldType::SCALAR,
+                  FeatureNotImplemented("Refinement criteria for vector fields"));
+    }
+}
+
+template <int dim, int degree>
+void
+gridRefiner<dim, degree>::mark_cells() const
+{
+  const auto &spatial_discretization = user_inputs.spatial_discretization;
+  const auto &triangulation          = triangulation_handler.get_triangulation();
+
+  // Indicator of the cells where any criterion is met, by active cell index
+  std::vector<bool> indicator(triangulation.n_active_cells(), false);
+  for (const auto &criterion : spatial_discretization.refinement_criteria)
+    {
+      evaluate_criterion(criterion, indicator);
+    }
+
+  for (const auto &cell : triangulation.active_cell_iterators())
+    {
+      if (!cell->is_locally_owned())
+        {
+          continue;
+        }
+
+      // Keep the cells within the refinement limits, regardless of the criteria
+      const bool criteria_met = indicator[cell->active_cell_index()];
+      const auto level        = static_cast<unsigned int>(cell->level());
+      if ((criteria_met && level < spatial_discretization.max_refinement) ||
+          level < spatial_discretization.min_refinement)
+        {
+          cell->set_refine_flag();
+        }
+      else if ((!criteria_met && level > spatial_discretization.min_refinement) ||
+               level > spatial_discretization.max_refinement)
+        {
+          cell->set_coarsen_flag();
+        }
+    }
+}
+
+template <int dim, int degree>
+void
+gridRefiner<dim, degree>::evaluate_criterion(const RefinementCriterion &criterion,
+                                             std::vector<bool>         &indicator) const
+{
+  using size_type        = dealii::VectorizedArray<double>;
+  using FEEvaluationType = fieldEvaluation<dim, degree, 1, double>;
+  using dealii::SIMDComparison;
+
+  const bool check_value =
+    (criterion.criterion_type & RefinementCriterionFlags::criterion_value) != 0U;
+  const bool check_gradient =
+    (criterion.criterion_type & RefinementCriterionFlags::criterion_gradient) != 0U;
+
+  dealii::EvaluationFlags::EvaluationFlags flags = dealii::EvaluationFlags::nothing;
+  if (check_value)
+    {
+      flags |= dealii::EvaluationFlags::values;
+    }
+  if (check_gradient)
+    {
+      flags |= dealii::EvaluationFlags::gradients;
+    }
+
+  const auto &data     = *matrix_free_handler.get_matrix_free();
+  const auto &solution = *solution_handler.solution_set.at(
+    std::make_pair(criterion.variable_index, dependencyType::NORMAL));
+  const size_type one(1.0);
+  const size_type value_lower_bound(criterion.value_lower_bound);
+  const size_type value_upper_bound(criterion.value_upper_bound);
+  const size_type gradient_lower_bound(criterion.gradient_lower_bound);
+
+  // The quadrature points of the matrix-free object are the nodes of the elements
+  FEEvaluationType fe_eval(data, criterion.variable_index);
+  for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+    {
+      // The solution already satisfies the constraints, so read it as is
+      fe_eval.reinit(cell);
+      fe_eval.read_dof_values_plain(solution);
+      fe_eval.evaluate(flags);
+
+      // Lanes where the criterion is met are set to one
+      size_type met(0.0);
+      for (unsigned int q = 0; q < fe_eval.n_q_points; ++q)
+        {
+          if (check_value)
+            {
+              const size_type value = fe_eval.get_value(q);
+              const size_type below_upper_bound =
+                dealii::compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+                  value,
+                  value_upper_bound,
+                  one,
+                  met);
+              met = dealii::compare_and_apply_mask<SIMDComparison::greater_than_or_equal>(
+                value,
+                value_lower_bound,
+                below_upper_bound,
+                met);
+            }
+          if (check_gradient)
+            {
+              met = dealii::compare_and_apply_mask<SIMDComparison::greater_than>(
+                fe_eval.get_gradient(q).norm(),
+                gradient_lower_bound,
+                one,
+                met);
+            }
+        }
+
+      for (unsigned int lane = 0; lane < data.n_active_entries_per_cell_batch(cell);
+           ++lane)
+        {
+          if (met[lane] > 0.0)
+            {
+              indicator[data.get_cell_iterator(cell, lane)->active_cell_index()] = true;
+            }
+        }
+    }
+}
+
+template <int dim, int degree>
+void
+gridRefiner<dim, degree>::compute_cell_weights()
+{
+  using size_type        = dealii::VectorizedArray<double>;
+  using FEEvaluationType = fieldEvaluation<dim, degree, 1, double>;
+
+  const auto &data = *matrix_free_handler.get_matrix_free();
+
+  const double active_field_threshold =
+    user_inputs.spatial_discretization.active_field_threshold;
+
+  // Count the scalar fields that vary over each cell
+  n_active_fields.assign(triangulation_handler.get_triangulation().n_active_cells(), 0);
+  for (const auto &[index, variable] : user_inputs.var_attributes)
+    {
+      if (variable.field_type != fieldType::SCALAR)
+        {
+          continue;
+        }
+
+      const auto &solution = *solution_handler.solution_set.at(
+        std::make_pair(index, dependencyType::NORMAL));
+
+      // Variations that are small compared to the magnitude of the field are ignored
+      const double tolerance = active_field_threshold * solution.linfty_norm();
+
+      FEEvaluationType fe_eval(data, index);
+      for (unsigned int cell = 0; cell < data.n_cell_batches(); ++cell)
+        {
+          fe_eval.reinit(cell);
+          fe_eval.read_dof_values_plain(solution);
+
+          size_type min_value = fe_eval.get_dof_value(0);
+          size_type max_value = min_value;
+          for (unsigned int i = 1; i < fe_eval.dofs_per_cell; ++i)
+            {
+              min_value = std::min(min_value, fe_eval.get_dof_value(i));
+              max_value = std::max(max_value, fe_eval.get_dof_value(i));
+            }
+          const size_type variation = max_value - min_value;
+
+          for (unsigned int lane = 0; lane < data.n_active_entries_per_cell_batch(cell);
+               ++lane)
+            {
+              if (variation[lane] > tolerance)
+                {
+                  n_active_fields[data.get_cell_iterator(cell, lane)
+                                    ->active_cell_index()]++;
+                }
+            }
+        }
+    }
+
+  update_cell_weights();
+}
+
+template <int dim, int degree>
+void
+gridRefiner<dim, degree>::calibrate_active_field_cost(const double &local_cost)
+{
+  const auto &triangulation = triangulation_handler.get_triangulation();
+  Assert(n_active_fields.size() == triangulation.n_active_cells(),
+         dealii::ExcMessage(
+           "The cell weights must be computed before the cost is calibrated."));
+
+  // Number of cells and of active fields of this process
+  double n_cells  = 0.0;
+  double n_active = 0.0;
+  for (const auto &cell : triangulation.active_cell_iterators())
+    {
+      if (cell->is_locally_owned())
+        {
+          n_cells += 1.0;
+          n_active += n_active_fields[cell->active_cell_index()];
+        }
+    }
+
+  // Least squares fit of local_cost = bulk_cost * (n_cells + active_field_cost *
+  // n_active) over all processes, with the normal equations summed over the processes
+  std::vector<double> normal_equations = {n_cells * n_cells,
+                                          n_cells * n_active,
+                                          n_active * n_active,
+                                          local_cost * n_cells,
+                                          local_cost * n_active};
+  dealii::Utilities::MPI::sum(normal_equations,
+                              triangulation_handler.get_mpi_communicator(),
+                              normal_equations);
+  const double determinant =
+    (normal_equations[0] * normal_equations[2]) -
+    (normal_equations[1] * normal_equations[1]);
+
+  // If all processes have the same share of active fields, the two costs can't be told
+  // apart
+  if (determinant <= 1.0e-8 * normal_equations[0] * normal_equations[2])
+    {
+      return;
+    }
+  const double bulk_cost =
+    ((normal_equations[2] * normal_equations[3]) -
+     (normal_equations[1] * normal_equations[4])) /
+    determinant;
+  const double active_cost =
+    ((normal_equations[0] * normal_equations[4]) -
+     (normal_equations[1] * normal_equations[3])) /
+    determinant;
+  if (bulk_cost <= 0.0 || active_cost < 0.0)
+    {
+      return;
+    }
+
+  active_field_cost = active_cost / bulk_cost;
+  update_cell_weights();
+}
+
+template <int dim, int degree>
+double
+gridRefiner<dim, degree>::get_active_field_cost() const
+{
+  return active_field_cost;
+}
+
+template <int dim, int degree>
+void
+gridRefiner<dim, degree>::update_cell_weights()
+{
+  cell_weights.resize(n_active_fields.size());
+  for (unsigned int i = 0; i < n_active_fields.size(); ++i)
+    {
+      cell_weights[i] = static_cast<unsigned int>(
+        std::lround(bulk_cell_weight * (1.0 + (active_field_cost * n_active_fields[i]))));
+    }
+}
+
+template <int dim, int degree>
+unsigned int
+gridRefiner<dim, degree>::get_cell_weight(
+  const typename dealii::Triangulation<dim>::cell_iterator &cell,
+  const typename triangulationHandler<dim>::CellStatus     &status) const
+{
+  using Triangulation = dealii::Triangulation<dim>;
+
+  Assert(cell_weights.size() ==
+           triangulation_handler.get_triangulation().n_active_cells(),
+         dealii::ExcMessage(
+           "The cell weights must be computed before the mesh is refined."));
+
+  // The cells are those of the mesh before refinement, so a refined cell is still active
+  // and a coarsened cell has active children
+  switch (status)
+    {
+      case Triangulation::CELL_PERSIST:
+      case Triangulation::CELL_REFINE:
+        return cell_weights[cell->active_cell_index()];
+      case Triangulation::CELL_COARSEN:
+        {
+          unsigned int weight = 0;
+          for (unsigned int child = 0; child < cell->n_children(); ++child)
+            {
+              weight =
+                std::max(weight, cell_weights[cell->child(child)->active_cell_index()]);
+            }
+          return weight;
+        }
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+  return bulk_cell_weight;
+}
+
+template <int dim, int degree>
+double
+gridRefiner<dim, degree>::get_predicted_load_imbalance() const
+{
+  const auto &triangulation = triangulation_handler.get_triangulation();
+
+  double local_weight = 0.0;
+  for (const auto &cell : triangulation.active_cell_iterators())
+    {
+      if (cell->is_locally_owned())
+        {
+          local_weight += cell_weights[cell->active_cell_index()];
+        }
+    }
+  return compute_load_imbalance(local_weight);
+}
+
+template <int dim, int degree>
+double
+gridRefiner<dim, degree>::compute_load_imbalance(const double &local_cost) const
+{
+  const auto statistics =
+    dealii::Utilities::MPI::min_max_avg(local_cost,
+                                        triangulation_handler.get_mpi_communicator());
+  return statistics.avg > 0.0 ? statistics.max / statistics.avg : 1.0;
+}
+
+INSTANTIATE_BI_TEMPLATE(gridRefiner)
+
+PRISMS_PF_END_NAMESPACE
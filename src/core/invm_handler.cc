@@ -2,17 +2,18 @@
 // SPDX-License-Identifier: GNU Lesser General Public Version 2.1
 
 #include <deal.II/lac/la_parallel_vector.h>
-#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/evaluation_flags.h>
 #include <deal.II/matrix_free/matrix_free.h>
 
 #include <prismspf/config.h>
-#include <prismspf/core/exceptions.h>
+#include <prismspf/core/field_evaluation.h>
 #include <prismspf/core/invm_handler.h>
 #include <prismspf/core/type_enums.h>
 #include <prismspf/core/variable_attributes.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
 #include <map>
+#include <utility>
 
 PRISMS_PF_BEGIN_NAMESPACE
 
@@ -21,24 +22,16 @@ invmHandler<dim, degree, number>::invmHandler(
   const std::map<unsigned int, variableAttributes> &_variable_attributes)
   : variable_attributes(_variable_attributes)
   , data(nullptr)
-  , invm_scalar(VectorType())
-  , invm_vector(VectorType())
 {
   for (const auto &[index, variable] : variable_attributes)
     {
-      if (variable.field_type == fieldType::SCALAR && !scalar_needed &&
-          (variable.pde_type == PDEType::EXPLICIT_TIME_DEPENDENT ||
-           variable.pde_type == PDEType::AUXILIARY))
+      if (variable.pde_type == PDEType::EXPLICIT_TIME_DEPENDENT ||
+          variable.pde_type == PDEType::AUXILIARY)
         {
-          scalar_needed = true;
-          scalar_index  = index;
-        }
-      if (variable.field_type == fieldType::VECTOR && !vector_needed &&
-          (variable.pde_type == PDEType::EXPLICIT_TIME_DEPENDENT ||
-           variable.pde_type == PDEType::AUXILIARY))
-        {
-          vector_needed = true;
-          vector_index  = index;
+          // Keep the first field of each field type and degree reduction
+          invm_index.emplace(std::make_pair(variable.field_type,
+                                            variable.degree_reduction),
+                             index);
         }
     }
 }
@@ -63,74 +56,66 @@ invmHandler<dim, degree, number>::compute_invm()
   Assert(data != nullptr, dealii::ExcNotInitialized());
 
   // Initialize the invm vectors and cell loop to compute the invm vector, as neccessary
-  if (scalar_needed)
+  for (const auto &[key, index] : invm_index)
     {
-      data->initialize_dof_vector(invm_scalar, scalar_index);
-
-      dealii::FEEvaluation<dim, degree, degree + 1, 1, number> fe_eval(*data,
-                                                                       scalar_index);
-
-      for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+      if (key.first == fieldType::SCALAR)
         {
-          fe_eval.reinit(cell);
-          for (const unsigned int q : fe_eval.quadrature_point_indices())
-            {
-              fe_eval.submit_value(dealii::VectorizedArray<number>(1.0), q);
-            }
-          fe_eval.integrate(dealii::EvaluationFlags::values);
-          fe_eval.distribute_local_to_global(invm_scalar);
+          compute_field_invm<1>(invm[key], index);
         }
-      invm_scalar.compress(dealii::VectorOperation::add);
-
-      // Loop over cells and take the inverse
-      for (unsigned int i = 0; i < invm_scalar.locally_owned_size(); ++i)
+      else
         {
-          if (invm_scalar.local_element(i) > 1.0e-15)
-            {
-              invm_scalar.local_element(i) = 1.0 / invm_scalar.local_element(i);
-            }
-          else
-            {
-              invm_scalar.local_element(i) = 1;
-            }
+          compute_field_invm<dim>(invm[key], index);
         }
     }
-  if (vector_needed)
-    {
-      data->initialize_dof_vector(invm_vector, vector_index);
+}
 
-      dealii::FEEvaluation<dim, degree, degree + 1, dim, number> fe_eval(*data,
-                                                                         vector_index);
+template <int dim, int degree, typename number>
+template <unsigned int n_components>
+void
+invmHandler<dim, degree, number>::compute_field_invm(VectorType         &field_invm,
+                                                     const unsigned int &index) const
+{
+  data->initialize_dof_vector(field_invm, index);
 
-      dealii::Tensor<1, dim, dealii::VectorizedArray<number>> one;
-      for (unsigned int i = 0; i < dim; i++)
+  // Fields with a reduced degree are integrated at the quadrature points of the problem
+  // degree too, so the mass matrix is the same as the one used for their RHS
+  fieldEvaluation<dim, degree, n_components, number> fe_eval(*data, index);
+
+  typename fieldEvaluation<dim, degree, n_components, number>::value_type one;
+  if constexpr (n_components == 1)
+    {
+      one = 1.0;
+    }
+  else
+    {
+      for (unsigned int i = 0; i < n_components; i++)
         {
           one[i] = 1.0;
         }
+    }
 
-      for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+  for (unsigned int cell = 0; cell < data->n_cell_batches(); ++cell)
+    {
+      fe_eval.reinit(cell);
+      for (unsigned int q = 0; q < fe_eval.n_q_points; ++q)
         {
-          fe_eval.reinit(cell);
-          for (const unsigned int q : fe_eval.quadrature_point_indices())
-            {
-              fe_eval.submit_value(one, q);
-            }
-          fe_eval.integrate(dealii::EvaluationFlags::values);
-          fe_eval.distribute_local_to_global(invm_vector);
+          fe_eval.submit_value(one, q);
         }
-      invm_vector.compress(dealii::VectorOperation::add);
+      fe_eval.integrate(dealii::EvaluationFlags::values);
+      fe_eval.distribute_local_to_global(field_invm);
+    }
+  field_invm.compress(dealii::VectorOperation::add);
 
-      // Loop over cells and take the inverse
-      for (unsigned int i = 0; i < invm_vector.locally_owned_size(); ++i)
+  // Loop over cells and take the inverse
+  for (unsigned int i = 0; i < field_invm.locally_owned_size(); ++i)
+    {
+      if (field_invm.local_element(i) > 1.0e-15)
+        {
+          field_invm.local_element(i) = 1.0 / field_invm.local_element(i);
+        }
+      else
         {
-          if (invm_vector.local_element(i) > 1.0e-15)
-            {
-              invm_vector.local_element(i) = 1.0 / invm_vector.local_element(i);
-            }
-          else
-            {
-              invm_vector.local_element(i) = 1;
-            }
+          field_invm.local_element(i) = 1;
         }
     }
 }
@@ -153,47 +138,26 @@ invmHandler<dim, degree, number>::get_invm(const unsigned int &index) const
            "Invalid index. The provided index does not have an entry in the variable "
            "attributes that were provided to the constructor."));
 
-  if (variable_attributes.at(index).field_type == fieldType::SCALAR)
-    {
-      Assert(scalar_needed,
-             dealii::ExcMessage(
-               "The invm for scalar fields is marked as not needed. Make sure the "
-               "variable attributes correspond with the provided index. Additionally, "
-               "the invm is only necessary for explicit fields."));
-      Assert(invm_scalar.size() != 0,
-             dealii::ExcMessage("The scalar invm has size 0. Please make sure to call "
-                                "compute_invm() prior to calling the getter function."));
-
-      return invm_scalar;
-    }
-  else if (variable_attributes.at(index).field_type == fieldType::VECTOR)
-    {
-      Assert(vector_needed,
-             dealii::ExcMessage(
-               "The invm for vector fields is marked as not needed. Make sure the "
-               "variable attributes correspond with the provided index. Additionally, "
-               "the invm is only necessary for explicit fields."));
-      Assert(invm_vector.size() != 0,
-             dealii::ExcMessage("The vector invm has size 0. Please make sure to call "
-                                "compute_invm() prior to calling the getter function."));
-
-      return invm_vector;
-    }
-
-  AssertThrow(false, UnreachableCode());
+  const auto &variable = variable_attributes.at(index);
+  const auto  key = std::make_pair(variable.field_type, variable.degree_reduction);
+  Assert(invm_index.find(key) != invm_index.end(),
+         dealii::ExcMessage(
+           "The invm for this field type and degree is marked as not needed. Make sure "
+           "the variable attributes correspond with the provided index. Additionally, "
+           "the invm is only necessary for explicit fields."));
+  Assert(invm.find(key) != invm.end() && invm.at(key).size() != 0,
+         dealii::ExcMessage("The invm has size 0. Please make sure to call "
+                            "compute_invm() prior to calling the getter function."));
+
+  return invm.at(key);
 }
 
 template <int dim, int degree, typename number>
 void
 invmHandler<dim, degree, number>::clear()
 {
-  data          = nullptr;
-  invm_scalar   = VectorType();
-  invm_vector   = VectorType();
-  scalar_needed = false;
-  vector_needed = false;
-  scalar_index  = numbers::invalid_index;
-  vector_index  = numbers::invalid_index;
+  data = nullptr;
+  invm.clear();
 }
 
 INSTANTIATE_TRI_TEMPLATE(invmHandler)
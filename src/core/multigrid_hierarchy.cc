@@ -0,0 +1,412 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/multigrid/mg_tools.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+#include <deal.II/numerics/vector_tools_boundary.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/core/dof_handler.h>
+#include <prismspf/core/exceptions.h>
+#include <prismspf/core/matrix_free_handler.h>
+#include <prismspf/core/multigrid_hierarchy.h>
+#include <prismspf/core/triangulation_handler.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+template <int dim>
+mgHierarchy<dim>::mgHierarchy(const userInputParameters<dim>  &_user_inputs,
+                              const triangulationHandler<dim> &_triangulation_handler,
+                              const dofHandler<dim>           &_dof_handler,
+                              const unsigned int              &_field_index)
+  : user_inputs(_user_inputs)
+  , field_index(_field_index)
+{
+  // We solve the system with a global coarsening approach. There are two options when
+  // doing this: geometric coarsening and polynomial coarsening. The geometric coarsening
+  // follows the levels of the triangulation.
+  const auto &triangulation = _triangulation_handler.get_triangulation();
+  Assert(triangulation.n_global_levels() > 1,
+         dealii::ExcMessage(
+           "Multigrid preconditioner requires a multilevel triangulation"));
+  if constexpr (dim != 1)
+    {
+      Assert(triangulation.is_multilevel_hierarchy_constructed(),
+             dealii::ExcMessage(
+               "The triangulation must be constructed with multilevel hierarchy"));
+    }
+
+  // Create the triangulations for the coarser levels
+  coarse_triangulations = _triangulation_handler.create_coarsening_sequence();
+
+  const auto &fe = _dof_handler.const_dof_handlers.at(field_index)->get_fe();
+  create_levels(fe.degree);
+
+  // Distribute DoFs for each level of the triangulation
+  mg_dof_handlers.resize(min_level, max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      const auto &[h_level, p_level] = levels[level];
+      mg_dof_handlers[level].reinit(*coarse_triangulations[h_level]);
+
+      mg_dof_handlers[level].distribute_dofs(
+        dealii::FESystem<dim>(dealii::FE_Q<dim>(dealii::QGaussLobatto<1>(p_level + 1)),
+                              fe.n_components()));
+    }
+
+  // Apply constraints on each level
+  level_constraints.resize(min_level, max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      make_level_constraints(level);
+    }
+
+  // Setup the matrix-free objects on each level
+  mg_matrix_free_handler.resize(min_level, max_level, user_inputs);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      // TODO: Fix so mapping is same as rest of the problem. Do the same for the finite
+      // element I think.
+      // TODO: Fix so that we include all DoF handlers and constraints and select only the
+      // ones we need.
+      mg_matrix_free_handler[level].reinit(
+        mapping,
+        mg_dof_handlers[level],
+        level_constraints[level],
+        dealii::QGaussLobatto<1>(mg_dof_handlers[level].get_fe().degree + 1));
+    }
+
+  // Setup transfer operators
+  mg_transfer_operators.resize(min_level, max_level);
+  for (unsigned int level = min_level; level < max_level; ++level)
+    {
+      mg_transfer_operators[level + 1].reinit(mg_dof_handlers[level + 1],
+                                              mg_dof_handlers[level],
+                                              level_constraints[level + 1],
+                                              level_constraints[level]);
+    }
+  mg_transfer = std::make_unique<dealii::MGTransferGlobalCoarsening<dim, MGVectorType>>(
+    mg_transfer_operators);
+
+#ifdef DEBUG
+  conditionalOStreams::pout_summary()
+    << "\nMultigrid Setup Information for index " << field_index << ":\n"
+    << "  Min level: " << min_level << "\n"
+    << "  Max level: " << max_level << "\n";
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      conditionalOStreams::pout_summary()
+        << "  Level: " << level << "\n"
+        << "    Cells: "
+        << mg_dof_handlers[level].get_triangulation().n_global_active_cells() << "\n"
+        << "    Degree: " << mg_dof_handlers[level].get_fe().degree << "\n"
+        << "    DoFs: " << mg_dof_handlers[level].n_dofs() << "\n"
+        << "    Constrained DoFs: " << level_constraints[level].n_constraints() << "\n";
+    }
+  conditionalOStreams::pout_summary()
+    << "  MG vertical communication efficiency: "
+    << dealii::MGTools::vertical_communication_efficiency(coarse_triangulations) << "\n"
+    << "  MG workload imbalance: "
+    << dealii::MGTools::workload_imbalance(coarse_triangulations) << "\n\n"
+    << std::flush;
+#endif
+}
+
+template <int dim>
+void
+mgHierarchy<dim>::create_levels(const unsigned int &fe_degree)
+{
+  // Create the sequence of polynomial degrees, ordered from coarse to fine
+  std::vector<unsigned int> polynomial_coarsening_sequence = {fe_degree};
+  using SequenceType =
+    dealii::MGTransferGlobalCoarseningTools::PolynomialCoarseningSequenceType;
+  switch (user_inputs.linear_solve_parameters.linear_solve.at(field_index)
+            .polynomial_coarsening)
+    {
+      case polynomialCoarseningType::NO_POLYNOMIAL_COARSENING:
+        break;
+      case polynomialCoarseningType::DECREASE_BY_ONE:
+        polynomial_coarsening_sequence =
+          dealii::MGTransferGlobalCoarseningTools::create_polynomial_coarsening_sequence(
+            fe_degree,
+            SequenceType::decrease_by_one);
+        break;
+      case polynomialCoarseningType::BISECT:
+        polynomial_coarsening_sequence =
+          dealii::MGTransferGlobalCoarseningTools::create_polynomial_coarsening_sequence(
+            fe_degree,
+            SequenceType::bisect);
+        break;
+      case polynomialCoarseningType::GO_TO_ONE:
+        polynomial_coarsening_sequence =
+          dealii::MGTransferGlobalCoarseningTools::create_polynomial_coarsening_sequence(
+            fe_degree,
+            SequenceType::go_to_one);
+        break;
+      default:
+        AssertThrow(false, UnreachableCode());
+    }
+
+  levels.clear();
+  for (unsigned int i = 0; i < coarse_triangulations.size(); ++i)
+    {
+      levels.emplace_back(i, polynomial_coarsening_sequence.front());
+    }
+  for (unsigned int i = 1; i < polynomial_coarsening_sequence.size(); ++i)
+    {
+      levels.emplace_back(coarse_triangulations.size() - 1,
+                          polynomial_coarsening_sequence[i]);
+    }
+
+  // Set the maximum and minimum levels for the multigrid based on the triangulation.
+  min_level = 0;
+  max_level = levels.size() - 1;
+}
+
+template <int dim>
+void
+mgHierarchy<dim>::make_level_constraints(const unsigned int &level)
+{
+  level_constraints[level].clear();
+
+  const dealii::IndexSet locally_relevant_dofs =
+    dealii::DoFTools::extract_locally_relevant_dofs(mg_dof_handlers[level]);
+
+  level_constraints[level].reinit(locally_relevant_dofs);
+
+  dealii::DoFTools::make_hanging_node_constraints(mg_dof_handlers[level],
+                                                  level_constraints[level]);
+
+  const bool is_vector =
+    user_inputs.var_attributes.at(field_index).field_type == fieldType::VECTOR;
+
+  // TODO: Fix for pinned points
+  const auto &boundary_condition =
+    user_inputs.boundary_parameters.boundary_condition_list.at(field_index);
+  for (const auto &[component, condition] : boundary_condition)
+    {
+      for (const auto &[boundary_id, boundary_type] : condition.boundary_condition_map)
+        {
+          // Create a mask. This is only applied for vector fields to apply boundary
+          // conditions to each component of the vector.
+          std::vector<bool> mask(dim, false);
+          mask.at(component) = true;
+
+          if (boundary_type == boundaryCondition::type::NATURAL)
+            {
+              // Do nothing because they are naturally enforced.
+              continue;
+            }
+          else if (boundary_type == boundaryCondition::type::DIRICHLET ||
+                   boundary_type == boundaryCondition::type::NON_UNIFORM_DIRICHLET)
+            {
+              if (!is_vector)
+                {
+                  dealii::VectorTools::interpolate_boundary_values(
+                    mapping,
+                    mg_dof_handlers[level],
+                    boundary_id,
+                    dealii::Functions::ZeroFunction<dim, float>(1),
+                    level_constraints[level]);
+                }
+              else
+                {
+                  dealii::VectorTools::interpolate_boundary_values(
+                    mapping,
+                    mg_dof_handlers[level],
+                    boundary_id,
+                    dealii::Functions::ZeroFunction<dim, float>(dim),
+                    level_constraints[level],
+                    mask);
+                }
+            }
+          else if (boundary_type == boundaryCondition::type::PERIODIC)
+            {
+              // Skip boundary ids that are odd since those map to the even faces
+              if (boundary_id % 2 != 0)
+                {
+                  continue;
+                }
+              // Create a vector of matched pairs that we fill and enforce upon the
+              // constaints
+              std::vector<dealii::GridTools::PeriodicFacePair<
+                typename dealii::DoFHandler<dim>::cell_iterator>>
+                periodicity_vector;
+
+              // Determine the direction
+              const auto direction =
+                static_cast<unsigned int>(std::floor(boundary_id / dim));
+
+              // Collect the matched pairs on the coarsest level of the mesh
+              dealii::GridTools::collect_periodic_faces(mg_dof_handlers[level],
+                                                        boundary_id,
+                                                        boundary_id + 1,
+                                                        direction,
+                                                        periodicity_vector);
+
+              // Set constraints
+              if (!is_vector)
+                {
+                  dealii::DoFTools::make_periodicity_constraints<dim, dim>(
+                    periodicity_vector,
+                    level_constraints[level]);
+                }
+              else
+                {
+                  dealii::DoFTools::make_periodicity_constraints<dim, dim>(
+                    periodicity_vector,
+                    level_constraints[level],
+                    mask);
+                }
+            }
+          else if (boundary_type == boundaryCondition::type::NEUMANN)
+            {
+              Assert(false, FeatureNotImplemented("Neumann boundary conditions"));
+            }
+          else if (boundary_type == boundaryCondition::type::NON_UNIFORM_NEUMANN)
+            {
+              Assert(false,
+                     FeatureNotImplemented("Nonuniform neumann boundary conditions"));
+            }
+        }
+    }
+  level_constraints[level].close();
+}
+
+template <int dim>
+unsigned int
+mgHierarchy<dim>::get_min_level() const
+{
+  return min_level;
+}
+
+template <int dim>
+unsigned int
+mgHierarchy<dim>::get_max_level() const
+{
+  return max_level;
+}
+
+template <int dim>
+unsigned int
+mgHierarchy<dim>::get_level_degree(const unsigned int &level) const
+{
+  AssertIndexRange(level, levels.size());
+  return levels[level].second;
+}
+
+template <int dim>
+const dealii::DoFHandler<dim> &
+mgHierarchy<dim>::get_dof_handler(const unsigned int &level) const
+{
+  return mg_dof_handlers[level];
+}
+
+template <int dim>
+const dealii::AffineConstraints<float> &
+mgHierarchy<dim>::get_constraint(const unsigned int &level) const
+{
+  return level_constraints[level];
+}
+
+template <int dim>
+std::shared_ptr<dealii::MatrixFree<dim, float>>
+mgHierarchy<dim>::get_matrix_free(const unsigned int &level) const
+{
+  return mg_matrix_free_handler[level].get_matrix_free();
+}
+
+template <int dim>
+const dealii::MGTransferGlobalCoarsening<dim, typename mgHierarchy<dim>::MGVectorType> &
+mgHierarchy<dim>::get_transfer() const
+{
+  Assert(mg_transfer != nullptr, dealii::ExcNotInitialized());
+  return *mg_transfer;
+}
+
+template <int dim>
+mgHierarchyHandler<dim>::mgHierarchyHandler(
+  const userInputParameters<dim>  &_user_inputs,
+  const triangulationHandler<dim> &_triangulation_handler,
+  const dofHandler<dim>           &_dof_handler)
+  : user_inputs(_user_inputs)
+  , triangulation_handler(_triangulation_handler)
+  , dof_handler(_dof_handler)
+{}
+
+template <int dim>
+std::shared_ptr<const mgHierarchy<dim>>
+mgHierarchyHandler<dim>::get_hierarchy(const unsigned int &field_index)
+{
+  const KeyType key      = compute_key(field_index);
+  auto          iterator = hierarchies.find(key);
+  if (iterator == hierarchies.end())
+    {
+      iterator =
+        hierarchies
+          .emplace(key,
+                   std::make_shared<const mgHierarchy<dim>>(user_inputs,
+                                                            triangulation_handler,
+                                                            dof_handler,
+                                                            field_index))
+          .first;
+    }
+  return iterator->second;
+}
+
+template <int dim>
+void
+mgHierarchyHandler<dim>::clear()
+{
+  hierarchies.clear();
+}
+
+template <int dim>
+typename mgHierarchyHandler<dim>::KeyType
+mgHierarchyHandler<dim>::compute_key(const unsigned int &field_index) const
+{
+  // Dirichlet conditions are the same on the levels, regardless of their values
+  BoundarySignature boundary_signature;
+  for (const auto &[component, condition] :
+       user_inputs.boundary_parameters.boundary_condition_list.at(field_index))
+    {
+      for (const auto &[boundary_id, boundary_type] : condition.boundary_condition_map)
+        {
+          boundary_signature.emplace(std::make_pair(component, boundary_id),
+                                     boundary_type ==
+                                         boundaryCondition::type::NON_UNIFORM_DIRICHLET
+                                       ? boundaryCondition::type::DIRICHLET
+                                       : boundary_type);
+        }
+    }
+
+  return std::make_tuple(
+    dof_handler.const_dof_handlers.at(field_index)->get_fe().degree,
+    user_inputs.var_attributes.at(field_index).field_type,
+    user_inputs.linear_solve_parameters.linear_solve.at(field_index)
+      .polynomial_coarsening,
+    boundary_signature);
+}
+
+INSTANTIATE_UNI_TEMPLATE(mgHierarchy)
+INSTANTIATE_UNI_TEMPLATE(mgHierarchyHandler)
+
+PRISMS_PF_END_NAMESPACE
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <prismspf/config.h>
+#include <prismspf/core/conditional_ostreams.h>
+#include <prismspf/core/parareal_driver.h>
+#include <prismspf/user_inputs/parareal_parameters.h>
+
+#include <cmath>
+#include <mpi.h>
+#include <vector>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+pararealDriver::pararealDriver(const pararealParameters &_parameters)
+  : parameters(_parameters)
+{
+  if (!parameters.is_enabled())
+    {
+      return;
+    }
+
+  const unsigned int n_procs = dealii::Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int rank    = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  AssertThrow(n_procs % parameters.n_time_slices == 0,
+              dealii::ExcMessage("The number of MPI processes must be divisible by the "
+                                 "number of parareal time slices."));
+
+  const unsigned int procs_per_slice = n_procs / parameters.n_time_slices;
+  time_slice                         = rank / procs_per_slice;
+
+  int ierr = MPI_Comm_split(MPI_COMM_WORLD,
+                            static_cast<int>(time_slice),
+                            static_cast<int>(rank),
+                            &slice_communicator);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Comm_split(MPI_COMM_WORLD,
+                        static_cast<int>(rank % procs_per_slice),
+                        static_cast<int>(rank),
+                        &time_communicator);
+  AssertThrowMPI(ierr);
+}
+
+pararealDriver::~pararealDriver()
+{
+  if (!parameters.is_enabled())
+    {
+      return;
+    }
+  MPI_Comm_free(&slice_communicator);
+  MPI_Comm_free(&time_communicator);
+}
+
+const MPI_Comm &
+pararealDriver::get_slice_communicator() const
+{
+  return slice_communicator;
+}
+
+unsigned int
+pararealDriver::get_time_slice() const
+{
+  return time_slice;
+}
+
+void
+pararealDriver::pack(std::vector<double> &buffer) const
+{
+  buffer.clear();
+  for (const auto *vector : state)
+    {
+      for (unsigned int i = 0; i < vector->locally_owned_size(); ++i)
+        {
+          buffer.push_back(vector->local_element(i));
+        }
+    }
+}
+
+void
+pararealDriver::unpack(const std::vector<double> &buffer) const
+{
+  std::size_t offset = 0;
+  for (auto *vector : state)
+    {
+      for (unsigned int i = 0; i < vector->locally_owned_size(); ++i)
+        {
+          vector->local_element(i) = buffer[offset++];
+        }
+    }
+  Assert(offset == buffer.size(),
+         dealii::ExcMessage("The parareal buffer does not match the state vectors."));
+}
+
+unsigned int
+pararealDriver::solve(const std::vector<VectorType *> &_state,
+                      const Propagator                &coarse_propagator,
+                      const Propagator                &fine_propagator)
+{
+  AssertThrow(parameters.is_enabled(),
+              dealii::ExcMessage("Parareal must be enabled to call this function."));
+
+  state = _state;
+
+  const unsigned int n_slices = parameters.n_time_slices;
+
+  // The states at the slice boundaries and the coarse propagation of each from the
+  // previous iteration
+  std::vector<std::vector<double>> boundary_state(n_slices + 1);
+  std::vector<std::vector<double>> coarse_state(n_slices + 1);
+  pack(boundary_state[0]);
+
+  // The exchange relies on matching processes owning the same entries
+  const std::size_t n_local = boundary_state[0].size();
+  AssertThrow(dealii::Utilities::MPI::min(n_local, time_communicator) ==
+                dealii::Utilities::MPI::max(n_local, time_communicator),
+              dealii::ExcMessage("The time slices must have identical partitions."));
+
+  // Initial coarse sweep
+  conditionalOStreams::pout_base() << "parareal initial coarse sweep...\n" << std::flush;
+  for (unsigned int slice = 0; slice < n_slices; ++slice)
+    {
+      unpack(boundary_state[slice]);
+      coarse_propagator(slice);
+      pack(coarse_state[slice + 1]);
+      boundary_state[slice + 1] = coarse_state[slice + 1];
+    }
+
+  std::vector<double> fine_local;
+  std::vector<double> fine_all(n_slices * n_local);
+  std::vector<double> coarse_new;
+
+  unsigned int iteration = 0;
+  while (iteration < parameters.max_iterations)
+    {
+      // Fine propagation of every slice concurrently. Slices before the current
+      // iteration are already exact, so there's no need to propagate them again.
+      if (time_slice < iteration)
+        {
+          fine_local = boundary_state[time_slice + 1];
+        }
+      else
+        {
+          unpack(boundary_state[time_slice]);
+          fine_propagator(time_slice);
+          pack(fine_local);
+        }
+      const int ierr = MPI_Allgather(fine_local.data(),
+                                     static_cast<int>(n_local),
+                                     MPI_DOUBLE,
+                                     fine_all.data(),
+                                     static_cast<int>(n_local),
+                                     MPI_DOUBLE,
+                                     time_communicator);
+      AssertThrowMPI(ierr);
+
+      // Sequential correction sweep: U_{n+1} = G(U_n^{k+1}) + F(U_n^k) - G(U_n^k)
+      double change_norm_sq = 0.0;
+      double state_norm_sq  = 0.0;
+      for (unsigned int slice = 0; slice < n_slices; ++slice)
+        {
+          const double *fine      = fine_all.data() + slice * n_local;
+          auto         &new_state = boundary_state[slice + 1];
+
+          if (slice <= iteration)
+            {
+              for (std::size_t i = 0; i < n_local; ++i)
+                {
+                  const double difference = fine[i] - new_state[i];
+                  change_norm_sq += difference * difference;
+                  state_norm_sq += fine[i] * fine[i];
+                  new_state[i] = fine[i];
+                }
+              continue;
+            }
+
+          unpack(boundary_state[slice]);
+          coarse_propagator(slice);
+          pack(coarse_new);
+          for (std::size_t i = 0; i < n_local; ++i)
+            {
+              const double value = coarse_new[i] + fine[i] - coarse_state[slice + 1][i];
+              const double difference = value - new_state[i];
+              change_norm_sq += difference * difference;
+              state_norm_sq += value * value;
+              new_state[i] = value;
+            }
+          coarse_state[slice + 1].swap(coarse_new);
+        }
+      iteration++;
+
+      change_norm_sq = dealii::Utilities::MPI::sum(change_norm_sq, slice_communicator);
+      state_norm_sq  = dealii::Utilities::MPI::sum(state_norm_sq, slice_communicator);
+      const double relative_change =
+        state_norm_sq > 0.0 ? std::sqrt(change_norm_sq / state_norm_sq)
+                            : std::sqrt(change_norm_sq);
+
+      conditionalOStreams::pout_base()
+        << "parareal iteration " << iteration << " relative change: " << relative_change
+        << "\n"
+        << std::flush;
+
+      if (relative_change < parameters.tolerance)
+        {
+          break;
+        }
+    }
+
+  final_state = boundary_state[n_slices];
+  unpack(boundary_state[time_slice]);
+
+  return iteration;
+}
+
+void
+pararealDriver::load_final_state() const
+{
+  Assert(!final_state.empty(),
+         dealii::ExcMessage("The parareal iterations must be solved first."));
+
+  unpack(final_state);
+}
+
+PRISMS_PF_END_NAMESPACE
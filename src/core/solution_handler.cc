@@ -133,6 +133,7 @@ solutionHandler<dim>::update(const fieldSolveType &field_solve_type,
                       .swap(
                         *(solution_set.at(std::make_pair(index, dependencyType::OLD_4))));
                   }
+                mark_changed(index);
               }
             break;
           case fieldSolveType::NONEXPLICIT_LINEAR:
@@ -173,6 +174,7 @@ solutionHandler<dim>::update(const fieldSolveType &field_solve_type,
                 (*new_vector)
                   .swap(
                     *(solution_set.at(std::make_pair(index, dependencyType::NORMAL))));
+                mark_changed(index);
               }
             break;
           case fieldSolveType::NONEXPLICIT_SELF_NONLINEAR:
@@ -212,9 +214,47 @@ solutionHandler<dim>::update(const fieldSolveType &field_solve_type,
                       .swap(
                         *(solution_set.at(std::make_pair(index, dependencyType::OLD_4))));
                   }
+                mark_changed(index);
               }
             break;
           case fieldSolveType::NONEXPLICIT_CO_NONLINEAR:
+            // The newton iterations update the current solution in place, so we only
+            // have to shift the old solutions. The new vector is used as scratch space.
+            if (attributes_list.at(index).field_solve_type == field_solve_type &&
+                variable_index == index)
+              {
+                *new_vector =
+                  *(solution_set.at(std::make_pair(index, dependencyType::NORMAL)));
+                if (solution_set.find(std::make_pair(index, dependencyType::OLD_1)) !=
+                    solution_set.end())
+                  {
+                    (*new_vector)
+                      .swap(
+                        *(solution_set.at(std::make_pair(index, dependencyType::OLD_1))));
+                  }
+                if (solution_set.find(std::make_pair(index, dependencyType::OLD_2)) !=
+                    solution_set.end())
+                  {
+                    (*new_vector)
+                      .swap(
+                        *(solution_set.at(std::make_pair(index, dependencyType::OLD_2))));
+                  }
+                if (solution_set.find(std::make_pair(index, dependencyType::OLD_3)) !=
+                    solution_set.end())
+                  {
+                    (*new_vector)
+                      .swap(
+                        *(solution_set.at(std::make_pair(index, dependencyType::OLD_3))));
+                  }
+                if (solution_set.find(std::make_pair(index, dependencyType::OLD_4)) !=
+                    solution_set.end())
+                  {
+                    (*new_vector)
+                      .swap(
+                        *(solution_set.at(std::make_pair(index, dependencyType::OLD_4))));
+                  }
+                mark_changed(index);
+              }
             break;
           case fieldSolveType::EXPLICIT_POSTPROCESS:
             if (attributes_list.at(index).field_solve_type == field_solve_type)
@@ -222,6 +262,7 @@ solutionHandler<dim>::update(const fieldSolveType &field_solve_type,
                 (*new_vector)
                   .swap(
                     *(solution_set.at(std::make_pair(index, dependencyType::NORMAL))));
+                mark_changed(index);
               }
             break;
           default:
@@ -230,6 +271,31 @@ solutionHandler<dim>::update(const fieldSolveType &field_solve_type,
     }
 }
 
+template <int dim>
+void
+solutionHandler<dim>::mark_changed(const unsigned int &index)
+{
+  versions[index] = ++n_modifications;
+}
+
+template <int dim>
+void
+solutionHandler<dim>::mark_all_changed()
+{
+  for (const auto &[index, variable] : attributes_list)
+    {
+      mark_changed(index);
+    }
+}
+
+template <int dim>
+unsigned int
+solutionHandler<dim>::get_version(const unsigned int &index) const
+{
+  const auto iterator = versions.find(index);
+  return iterator != versions.end() ? iterator->second : 0;
+}
+
 INSTANTIATE_UNI_TEMPLATE(solutionHandler)
 
 PRISMS_PF_END_NAMESPACE
\ No newline at end of file
@@ -1,12 +1,18 @@
 // SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
 // SPDX-License-Identifier: GNU Lesser General Public Version 2.1
 
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/tria.h>
+#include <deal.II/grid/cell_id.h>
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_out.h>
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_description.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
 
 #include <prismspf/config.h>
 #include <prismspf/core/conditional_ostreams.h>
@@ -14,26 +20,41 @@
 #include <prismspf/core/triangulation_handler.h>
 #include <prismspf/user_inputs/user_input_parameters.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 PRISMS_PF_BEGIN_NAMESPACE
 
 template <int dim>
 triangulationHandler<dim>::triangulationHandler(
-  const userInputParameters<dim> &_user_inputs)
+  const userInputParameters<dim> &_user_inputs,
+  const MPI_Comm                 &_mpi_communicator)
   : user_inputs(_user_inputs)
+  , mpi_communicator(_mpi_communicator)
 {
   if constexpr (dim == 1)
     {
       triangulation = std::make_unique<dealii::Triangulation<dim>>(
         dealii::Triangulation<dim>::limit_level_difference_at_vertices);
     }
+  else if (user_inputs.spatial_discretization.fully_distributed)
+    {
+      triangulation =
+        std::make_unique<dealii::parallel::fullydistributed::Triangulation<dim>>(
+          mpi_communicator);
+    }
   else
     {
       triangulation = std::make_unique<dealii::parallel::distributed::Triangulation<dim>>(
-        MPI_COMM_WORLD,
+        mpi_communicator,
         dealii::Triangulation<dim>::limit_level_difference_at_vertices,
         dealii::parallel::distributed::Triangulation<dim>::construct_multigrid_hierarchy);
     }
@@ -53,10 +74,31 @@ triangulationHandler<dim>::get_n_global_levels() const
   return triangulation->n_global_levels();
 }
 
+template <int dim>
+const MPI_Comm &
+triangulationHandler<dim>::get_mpi_communicator() const
+{
+  return mpi_communicator;
+}
+
 template <int dim>
 void
 triangulationHandler<dim>::generate_mesh()
 {
+  if (user_inputs.spatial_discretization.fully_distributed)
+    {
+      // The fully distributed triangulation can't be refined, so the description already
+      // contains all levels of the global refinement
+      create_fully_distributed_mesh(*triangulation,
+                                    user_inputs.spatial_discretization.global_refinement +
+                                      1);
+
+      // Mark periodicity
+      mark_periodic(*triangulation);
+
+      return;
+    }
+
   if (user_inputs.spatial_discretization.radius != 0.0)
     {
       // TODO: Adding assertion about periodic boundary conditions for spheres
@@ -79,7 +121,7 @@ triangulationHandler<dim>::generate_mesh()
       mark_boundaries();
 
       // Mark periodicity
-      mark_periodic();
+      mark_periodic(*triangulation);
     }
 
     // Output triangulation to vtk if in debug mode
@@ -91,6 +133,71 @@ triangulationHandler<dim>::generate_mesh()
   triangulation->refine_global(user_inputs.spatial_discretization.global_refinement);
 }
 
+template <int dim>
+std::vector<std::shared_ptr<const dealii::Triangulation<dim>>>
+triangulationHandler<dim>::create_coarsening_sequence() const
+{
+  if constexpr (dim != 1)
+    {
+      if (user_inputs.spatial_discretization.fully_distributed)
+        {
+          const unsigned int n_levels = triangulation->n_global_levels();
+          std::vector<std::shared_ptr<const dealii::Triangulation<dim>>> sequence(
+            n_levels);
+
+          // The coarser levels are partitioned like the current mesh, since the
+          // ownership follows the coarse cells
+          for (unsigned int level = 0; level + 1 < n_levels; ++level)
+            {
+              auto level_triangulation =
+                std::make_shared<dealii::parallel::fullydistributed::Triangulation<dim>>(
+                  mpi_communicator);
+              create_fully_distributed_mesh(*level_triangulation, level + 1);
+              mark_periodic(*level_triangulation);
+              sequence[level] = level_triangulation;
+            }
+
+          // The finest level is the current mesh, which is owned by this class
+          sequence.back() = std::shared_ptr<const dealii::Triangulation<dim>>(
+            triangulation.get(),
+            [](const dealii::Triangulation<dim> *) {});
+
+          return sequence;
+        }
+    }
+
+  return dealii::MGTransferGlobalCoarseningTools::create_geometric_coarsening_sequence(
+    *triangulation);
+}
+
+template <int dim>
+void
+triangulationHandler<dim>::prepare_coarsening_and_refinement()
+{
+  triangulation->prepare_coarsening_and_refinement();
+}
+
+template <int dim>
+void
+triangulationHandler<dim>::execute_coarsening_and_refinement()
+{
+  triangulation->execute_coarsening_and_refinement();
+}
+
+template <int dim>
+void
+triangulationHandler<dim>::set_cell_weight(const CellWeightFunction &cell_weight)
+{
+  triangulation->signals.weight.connect(cell_weight);
+}
+
+template <int dim>
+void
+triangulationHandler<dim>::save(const std::string &filename) const
+{
+  triangulation->save(filename);
+}
+
 template <int dim>
 void
 triangulationHandler<dim>::export_triangulation_as_vtk(const std::string &filename) const
@@ -136,7 +243,7 @@ triangulationHandler<dim>::mark_boundaries() const
 
 template <int dim>
 void
-triangulationHandler<dim>::mark_periodic()
+triangulationHandler<dim>::mark_periodic(dealii::Triangulation<dim> &_triangulation) const
 {
   // Add periodicity in the triangulation where specified in the boundary conditions. Note
   // that if one field is periodic all others should be as well.
@@ -159,7 +266,7 @@ triangulationHandler<dim>::mark_periodic()
                   // Create a vector of matched pairs that we fill and enforce upon the
                   // constaints
                   std::vector<dealii::GridTools::PeriodicFacePair<
-                    typename Triangulation::cell_iterator>>
+                    typename dealii::Triangulation<dim>::cell_iterator>>
                     periodicity_vector;
 
                   // Determine the direction
@@ -167,20 +274,353 @@ triangulationHandler<dim>::mark_periodic()
                     static_cast<unsigned int>(std::floor(boundary_id / dim));
 
                   // Collect the matched pairs on the coarsest level of the mesh
-                  dealii::GridTools::collect_periodic_faces(*triangulation,
+                  dealii::GridTools::collect_periodic_faces(_triangulation,
                                                             boundary_id,
                                                             boundary_id + 1,
                                                             direction,
                                                             periodicity_vector);
 
                   // Set constraints
-                  triangulation->add_periodicity(periodicity_vector);
+                  _triangulation.add_periodicity(periodicity_vector);
                 }
             }
         }
     }
 }
 
+template <int dim>
+std::array<bool, dim>
+triangulationHandler<dim>::get_periodic_directions() const
+{
+  std::array<bool, dim> periodic {};
+  for (const auto &[index, boundary_condition] :
+       user_inputs.boundary_parameters.boundary_condition_list)
+    {
+      for (const auto &[component, condition] : boundary_condition)
+        {
+          for (const auto &[boundary_id, boundary_type] :
+               condition.boundary_condition_map)
+            {
+              if (boundary_type == boundaryCondition::type::PERIODIC)
+                {
+                  periodic[boundary_id / 2] = true;
+                }
+            }
+        }
+    }
+  return periodic;
+}
+
+template <int dim>
+void
+triangulationHandler<dim>::create_fully_distributed_mesh(
+  dealii::Triangulation<dim> &_triangulation,
+  const unsigned int         &n_levels) const
+{
+  if constexpr (dim == 1)
+    {
+      AssertThrow(false, FeatureNotImplemented("Fully distributed meshes in 1D"));
+    }
+  else
+    {
+      using CellIndex    = std::array<unsigned int, dim>;
+      using CoarseCellId = dealii::types::coarse_cell_id;
+
+      const auto        &spatial_discretization = user_inputs.spatial_discretization;
+      const unsigned int n_processes =
+        dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
+      const unsigned int this_process =
+        dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+      const std::array<bool, dim> periodic = get_periodic_directions();
+
+      CoarseCellId n_coarse_cells = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          n_coarse_cells *= spatial_discretization.subdivisions[d];
+        }
+      AssertThrow(n_coarse_cells >= n_processes,
+                  dealii::ExcMessage(
+                    "A fully distributed mesh requires at least one coarse cell per "
+                    "process. Increase the number of subdivisions."));
+
+      // Lexicographic numbering of the coarse cells, with x running fastest
+      const auto to_coarse_cell_id = [&](const CellIndex &index)
+      {
+        CoarseCellId id = 0;
+        for (unsigned int d = dim; d-- > 0;)
+          {
+            id = (id * spatial_discretization.subdivisions[d]) + index[d];
+          }
+        return id;
+      };
+      const auto to_coarse_index = [&](CoarseCellId id)
+      {
+        CellIndex index {};
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            index[d] =
+              static_cast<unsigned int>(id % spatial_discretization.subdivisions[d]);
+            id /= spatial_discretization.subdivisions[d];
+          }
+        return index;
+      };
+
+      // Each process owns a contiguous range of the coarse cells and all of their
+      // children, so the partitions are slabs of the coarse grid. The index of a cell on
+      // a level is its position on the uniform grid of that level.
+      const auto coarse_owner = [&](const CoarseCellId &id)
+      {
+        return static_cast<unsigned int>((id * n_processes) / n_coarse_cells);
+      };
+      const auto owner = [&](const unsigned int &level, const CellIndex &index)
+      {
+        CellIndex coarse_index {};
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            coarse_index[d] = index[d] >> level;
+          }
+        return coarse_owner(to_coarse_cell_id(coarse_index));
+      };
+
+      // Call the given function for the cell of the given level and for every cell of
+      // that level that shares a vertex with it, across the periodic boundaries too
+      unsigned int n_neighbors = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          n_neighbors *= 3;
+        }
+      const auto for_each_neighbor =
+        [&](const unsigned int &level, const CellIndex &index, const auto &function)
+      {
+        for (unsigned int neighbor = 0; neighbor < n_neighbors; ++neighbor)
+          {
+            CellIndex    neighbor_index {};
+            bool         in_domain = true;
+            unsigned int remainder = neighbor;
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                const int extent =
+                  static_cast<int>(spatial_discretization.subdivisions[d] << level);
+                int coordinate =
+                  static_cast<int>(index[d]) + static_cast<int>(remainder % 3) - 1;
+                remainder /= 3;
+                if (coordinate < 0 || coordinate >= extent)
+                  {
+                    in_domain  = in_domain && periodic[d];
+                    coordinate = (coordinate + extent) % extent;
+                  }
+                neighbor_index[d] = static_cast<unsigned int>(coordinate);
+              }
+            if (in_domain)
+              {
+                function(neighbor_index);
+              }
+          }
+      };
+
+      // A cell is locally relevant if it is locally owned or touches a locally owned cell
+      // of the same level
+      const auto is_locally_relevant =
+        [&](const unsigned int &level, const CellIndex &index)
+      {
+        bool relevant = false;
+        for_each_neighbor(level,
+                          index,
+                          [&](const CellIndex &neighbor_index)
+                          {
+                            relevant =
+                              relevant || owner(level, neighbor_index) == this_process;
+                          });
+        return relevant;
+      };
+
+      // Collect the locally owned coarse cells and their neighbors
+      const CoarseCellId first_owned =
+        ((this_process * n_coarse_cells) + n_processes - 1) / n_processes;
+      const CoarseCellId last_owned =
+        (((this_process + 1) * n_coarse_cells) + n_processes - 1) / n_processes;
+      std::set<CoarseCellId> relevant_coarse_cells;
+      for (CoarseCellId id = first_owned; id < last_owned; ++id)
+        {
+          for_each_neighbor(0,
+                            to_coarse_index(id),
+                            [&](const CellIndex &neighbor_index)
+                            {
+                              relevant_coarse_cells.insert(
+                                to_coarse_cell_id(neighbor_index));
+                            });
+        }
+
+      // Periodic faces are matched on the coarse level, so the partners of the relevant
+      // coarse cells on periodic boundaries are added as artificial cells
+      std::set<CoarseCellId>    artificial_coarse_cells;
+      std::vector<CoarseCellId> queue(relevant_coarse_cells.begin(),
+                                      relevant_coarse_cells.end());
+      while (!queue.empty())
+        {
+          const CellIndex index = to_coarse_index(queue.back());
+          queue.pop_back();
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const unsigned int last = spatial_discretization.subdivisions[d] - 1;
+              if (!periodic[d] || (index[d] != 0 && index[d] != last))
+                {
+                  continue;
+                }
+              CellIndex partner = index;
+              partner[d]        = index[d] == 0 ? last : 0;
+              const CoarseCellId partner_id = to_coarse_cell_id(partner);
+              if (relevant_coarse_cells.count(partner_id) == 0 &&
+                  artificial_coarse_cells.insert(partner_id).second)
+                {
+                  queue.push_back(partner_id);
+                }
+            }
+        }
+      std::set<CoarseCellId> coarse_cells = relevant_coarse_cells;
+      coarse_cells.insert(artificial_coarse_cells.begin(), artificial_coarse_cells.end());
+
+      dealii::TriangulationDescription::Description<dim, dim> description;
+      description.comm      = mpi_communicator;
+      description.smoothing =
+        dealii::Triangulation<dim>::limit_level_difference_at_vertices;
+      description.settings =
+        dealii::TriangulationDescription::Settings::construct_multigrid_hierarchy;
+
+      // Create the coarse cells and their vertices. The vertices are numbered locally.
+      std::map<dealii::types::global_vertex_index, unsigned int> local_vertex_index;
+      for (const CoarseCellId &id : coarse_cells)
+        {
+          const CellIndex       index = to_coarse_index(id);
+          dealii::CellData<dim> coarse_cell;
+          for (unsigned int vertex = 0; vertex < coarse_cell.vertices.size(); ++vertex)
+            {
+              dealii::types::global_vertex_index vertex_id = 0;
+              dealii::Point<dim>                 point;
+              for (unsigned int d = dim; d-- > 0;)
+                {
+                  const unsigned int vertex_index = index[d] + ((vertex >> d) & 1U);
+                  vertex_id =
+                    (vertex_id * (spatial_discretization.subdivisions[d] + 1)) +
+                    vertex_index;
+                  point[d] = spatial_discretization.size[d] * vertex_index /
+                             spatial_discretization.subdivisions[d];
+                }
+
+              const auto [iterator, inserted] =
+                local_vertex_index.emplace(vertex_id, local_vertex_index.size());
+              if (inserted)
+                {
+                  description.coarse_cell_vertices.emplace_back(iterator->second, point);
+                }
+              coarse_cell.vertices[vertex] = iterator->second;
+            }
+          description.coarse_cells.push_back(coarse_cell);
+          description.coarse_cell_index_to_coarse_cell_id.push_back(id);
+        }
+
+      // Describe a cell of the given level. The boundary ids are the face numbers, as
+      // for the other meshes.
+      const auto describe_cell = [&](const unsigned int &level,
+                                     const CellIndex    &index,
+                                     const bool         &artificial)
+      {
+        dealii::TriangulationDescription::CellData<dim> cell_data;
+
+        CellIndex                 coarse_index {};
+        std::vector<std::uint8_t> child_indices(level);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            coarse_index[d] = index[d] >> level;
+            for (unsigned int child_level = 0; child_level < level; ++child_level)
+              {
+                const unsigned int bit = (index[d] >> (level - 1 - child_level)) & 1U;
+                child_indices[child_level] |= static_cast<std::uint8_t>(bit << d);
+              }
+          }
+        cell_data.id = dealii::CellId(to_coarse_cell_id(coarse_index), child_indices)
+                         .template to_binary<dim>();
+
+        const unsigned int cell_owner = owner(level, index);
+        cell_data.level_subdomain_id =
+          artificial ? dealii::numbers::artificial_subdomain_id : cell_owner;
+        cell_data.subdomain_id = artificial || level + 1 < n_levels
+                                   ? dealii::numbers::artificial_subdomain_id
+                                   : cell_owner;
+        cell_data.manifold_id = dealii::numbers::flat_manifold_id;
+        cell_data.manifold_line_ids.fill(dealii::numbers::flat_manifold_id);
+        cell_data.manifold_quad_ids.fill(dealii::numbers::flat_manifold_id);
+
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            if (index[d] == 0)
+              {
+                cell_data.boundary_ids.emplace_back(2 * d, 2 * d);
+              }
+            if (index[d] + 1 == (spatial_discretization.subdivisions[d] << level))
+              {
+                cell_data.boundary_ids.emplace_back((2 * d) + 1, (2 * d) + 1);
+              }
+          }
+        return cell_data;
+      };
+
+      // Describe the locally relevant cells of each level. Since the ownership follows
+      // the coarse cells, only the children of the relevant coarse cells are checked.
+      description.cell_infos.resize(n_levels);
+      for (unsigned int level = 0; level < n_levels; ++level)
+        {
+          const unsigned int n_children_per_direction = 1U << level;
+          unsigned int       n_children               = 1;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              n_children *= n_children_per_direction;
+            }
+
+          auto &cell_infos = description.cell_infos[level];
+          for (const CoarseCellId &id : relevant_coarse_cells)
+            {
+              const CellIndex coarse_index = to_coarse_index(id);
+              const bool      owned        = coarse_owner(id) == this_process;
+              for (unsigned int child = 0; child < n_children; ++child)
+                {
+                  CellIndex    index {};
+                  unsigned int remainder = child;
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      index[d] = (coarse_index[d] << level) +
+                                 (remainder % n_children_per_direction);
+                      remainder /= n_children_per_direction;
+                    }
+                  if (owned || is_locally_relevant(level, index))
+                    {
+                      cell_infos.push_back(describe_cell(level, index, false));
+                    }
+                }
+            }
+          if (level == 0)
+            {
+              for (const CoarseCellId &id : artificial_coarse_cells)
+                {
+                  cell_infos.push_back(describe_cell(0, to_coarse_index(id), true));
+                }
+            }
+
+          std::sort(cell_infos.begin(),
+                    cell_infos.end(),
+                    [](const auto &first, const auto &second)
+                    {
+                      return dealii::CellId(first.id) < dealii::CellId(second.id);
+                    });
+        }
+
+      auto &fully_distributed_triangulation =
+        dynamic_cast<dealii::parallel::fullydistributed::Triangulation<dim> &>(
+          _triangulation);
+      fully_distributed_triangulation.create_triangulation(description);
+    }
+}
+
 INSTANTIATE_UNI_TEMPLATE(triangulationHandler)
 
 PRISMS_PF_END_NAMESPACE
\ No newline at end of file
@@ -110,6 +110,14 @@ variableAttributeLoader::set_is_postprocessed_field(const unsigned int &index,
   var_attributes[index].is_postprocess = is_postprocess;
 }
 
+void
+variableAttributeLoader::set_variable_degree_reduction(
+  const unsigned int &index,
+  const unsigned int &degree_reduction)
+{
+  var_attributes[index].degree_reduction = degree_reduction;
+}
+
 void
 variableAttributeLoader::set_dependencies_value_term_RHS(const unsigned int &index,
                                                          const std::string  &dependencies)
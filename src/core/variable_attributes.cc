@@ -277,6 +277,7 @@ variableAttributes::print() const
     << "Variable type: " << to_string(field_type) << "\n"
     << "Equation type: " << to_string(pde_type) << "\n"
     << "Postprocessed field: " << bool_to_string(is_postprocess) << "\n"
+    << "Degree reduction: " << degree_reduction << "\n"
     << "Field solve type: " << to_string(field_solve_type) << "\n";
 
   conditionalOStreams::pout_summary() << "Evaluation flags RHS:\n";
@@ -11,6 +11,7 @@
 #include <prismspf/core/variable_container.h>
 
 #include <string>
+#include <vector>
 
 PRISMS_PF_BEGIN_NAMESPACE
 
@@ -56,12 +57,9 @@ variableContainer<dim, degree, number>::variableContainer(
       return;
     }
 
-  // TODO: Add stuff for cononlinear solves
-
-  // Loop through the variable attributes for nonexplicit solves
-  Assert(subset_attributes.size() == 1,
-         dealii::ExcMessage(
-           "For nonexplicit solves, subset attributes should only be 1 variable."));
+  // Loop through the variable attributes for nonexplicit solves. For co-nonlinear solves
+  // the dependencies have been flattened as well, so the first entry holds all of them.
+  subset_size_valid();
 
   if (solve_type == solveType::NONEXPLICIT_LHS)
     {
@@ -181,15 +179,9 @@ variableContainer<dim, degree, number>::eval_local_diagonal(
          dealii::ExcMessage(
            "For nonexplicit solves, subset attributes should only be 1 variable."));
 
-  AssertThrow(subset_attributes.begin()->second.field_type != fieldType::VECTOR,
-              FeatureNotImplemented("Vector multigrid"));
-
   const auto &global_var_index = subset_attributes.begin()->first;
 
-  auto *scalar_FEEval_ptr =
-    scalar_vars_map.at(global_var_index).at(dependencyType::CHANGE).get();
-
-  n_dofs_per_cell = scalar_FEEval_ptr->dofs_per_cell;
+  n_dofs_per_cell = get_change_dofs_per_cell(global_var_index);
   diagonal        = std::make_unique<dealii::AlignedVector<size_type>>(n_dofs_per_cell);
 
   for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
@@ -200,12 +192,9 @@ variableContainer<dim, degree, number>::eval_local_diagonal(
       for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
         {
           // Submit an identity matrix for the change term
-          for (unsigned int j = 0; j < n_dofs_per_cell; ++j)
-            {
-              scalar_FEEval_ptr->submit_dof_value(size_type(), j);
-            }
-          scalar_FEEval_ptr->submit_dof_value(dealii::make_vectorized_array<number>(1.0),
-                                              i);
+          zero_change_dof_values(global_var_index);
+          change_dof_value(global_var_index, i) =
+            dealii::make_vectorized_array<number>(1.0);
 
           // Read plain dof values for non change src
           read_dof_values(src_subset, cell);
@@ -227,14 +216,420 @@ variableContainer<dim, degree, number>::eval_local_diagonal(
 
           // Integrate the diagonal
           integrate(global_var_index);
-          (*diagonal)[i] = scalar_FEEval_ptr->get_dof_value(i);
+          (*diagonal)[i] = change_dof_value(global_var_index, i);
+        }
+
+      for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+        {
+          change_dof_value(global_var_index, i) = (*diagonal)[i];
         }
+      distribute_change(global_var_index, dst);
+    }
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::eval_local_matrix(
+  const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+    &func,
+  const std::function<void(const unsigned int                      &cell,
+                           const dealii::AlignedVector<size_type> &cell_matrix)>
+                                              &distribute,
+  const std::vector<VectorType *>             &src_subset,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  Assert(subset_attributes.size() == 1,
+         dealii::ExcMessage(
+           "For nonexplicit solves, subset attributes should only be 1 variable."));
+
+  const auto &global_var_index = subset_attributes.begin()->first;
+
+  n_dofs_per_cell = get_change_dofs_per_cell(global_var_index);
+  dealii::AlignedVector<size_type> cell_matrix(n_dofs_per_cell * n_dofs_per_cell);
+
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      // Reinit the cell for all the dependencies
+      reinit(cell, global_var_index);
 
       for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
         {
-          scalar_FEEval_ptr->submit_dof_value((*diagonal)[i], i);
+          // Submit the ith unit vector for the change term
+          zero_change_dof_values(global_var_index);
+          change_dof_value(global_var_index, i) =
+            dealii::make_vectorized_array<number>(1.0);
+
+          // Read plain dof values for non change src
+          read_dof_values(src_subset, cell);
+
+          // Evaluate the dependencies based on the flags
+          eval(global_var_index);
+
+          for (unsigned int q = 0; q < get_n_q_points(); ++q)
+            {
+              // Set the quadrature point
+              q_point = q;
+
+              // Grab the quadrature point location
+              dealii::Point<dim, size_type> q_point_loc = get_q_point_location();
+
+              // Calculate the residuals
+              func(*this, q_point_loc);
+            }
+
+          // Integrate the ith column
+          integrate(global_var_index);
+          for (unsigned int j = 0; j < n_dofs_per_cell; ++j)
+            {
+              cell_matrix[i * n_dofs_per_cell + j] =
+                change_dof_value(global_var_index, j);
+            }
+        }
+
+      distribute(cell, cell_matrix);
+    }
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::eval_local_linearization(
+  const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                              &func,
+  dealii::AlignedVector<size_type>            &coefficients,
+  const std::vector<VectorType *>             &src_subset,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  Assert(subset_attributes.size() == 1,
+         dealii::ExcMessage(
+           "For nonexplicit solves, subset attributes should only be 1 variable."));
+
+  const auto &global_var_index = subset_attributes.begin()->first;
+  const auto &variable         = subset_attributes.begin()->second;
+
+  const dealii::EvaluationFlags::EvaluationFlags input_flags =
+    get_change_eval_flags(global_var_index);
+  const dealii::EvaluationFlags::EvaluationFlags &output_flags =
+    variable.eval_flags_residual_LHS;
+
+  AssertThrow((input_flags & dealii::EvaluationFlags::hessians) == 0,
+              FeatureNotImplemented(
+                "Linearization of an LHS that depends on the hessian of the change"));
+
+  const unsigned int n_inputs   = get_n_change_terms(global_var_index, input_flags);
+  const unsigned int n_outputs  = get_n_change_terms(global_var_index, output_flags);
+  const unsigned int n_q_points = get_n_q_points();
+
+  Assert(coefficients.size() >= cell_range.second * get_n_linearization_coefficients(),
+         dealii::ExcMessage("The coefficient buffer is too small for the cell range."));
+
+  const size_type zero = dealii::make_vectorized_array<number>(0.0);
+  const size_type one  = dealii::make_vectorized_array<number>(1.0);
+
+  std::vector<size_type *> inputs;
+  std::vector<size_type *> outputs;
+
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      // Reinit the cell for all the dependencies
+      reinit(cell, global_var_index);
+
+      // Evaluate the dependencies about a zero change
+      zero_change_dof_values(global_var_index);
+      read_dof_values(src_subset, cell);
+      eval(global_var_index);
+
+      get_change_quad_terms(global_var_index, input_flags, inputs);
+      get_change_quad_terms(global_var_index, output_flags, outputs);
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          // Set the quadrature point
+          q_point = q;
+
+          // Grab the quadrature point location
+          dealii::Point<dim, size_type> q_point_loc = get_q_point_location();
+
+          size_type *local_coefficients =
+            &coefficients[(cell * n_q_points + q) * n_inputs * n_outputs];
+
+          for (unsigned int i = 0; i < n_inputs; ++i)
+            {
+              // Submit the ith unit vector for the change term at this quadrature point.
+              // The residual shares its storage with the change term, so it is cleared
+              // as well.
+              for (unsigned int j = 0; j < n_outputs; ++j)
+                {
+                  outputs[j][q] = zero;
+                }
+              for (unsigned int k = 0; k < n_inputs; ++k)
+                {
+                  inputs[k][q] = k == i ? one : zero;
+                }
+
+              // Calculate the residuals
+              func(*this, q_point_loc);
+
+              // Store the ith column
+              for (unsigned int j = 0; j < n_outputs; ++j)
+                {
+                  local_coefficients[j * n_inputs + i] = outputs[j][q];
+                }
+            }
+        }
+    }
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::apply_local_linearization(
+  const dealii::AlignedVector<size_type>      &coefficients,
+  VectorType                                  &dst,
+  const VectorType                            &src,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  Assert(subset_attributes.size() == 1,
+         dealii::ExcMessage(
+           "For nonexplicit solves, subset attributes should only be 1 variable."));
+
+  const auto &global_var_index = subset_attributes.begin()->first;
+  const auto &variable         = subset_attributes.begin()->second;
+
+  const dealii::EvaluationFlags::EvaluationFlags input_flags =
+    get_change_eval_flags(global_var_index);
+  const dealii::EvaluationFlags::EvaluationFlags &output_flags =
+    variable.eval_flags_residual_LHS;
+
+  const unsigned int n_inputs   = get_n_change_terms(global_var_index, input_flags);
+  const unsigned int n_outputs  = get_n_change_terms(global_var_index, output_flags);
+  const unsigned int n_q_points = get_n_q_points();
+
+  Assert(coefficients.size() >= cell_range.second * get_n_linearization_coefficients(),
+         dealii::ExcMessage("The linearization does not cover the cell range."));
+
+  std::vector<size_type *> inputs;
+  std::vector<size_type *> outputs;
+  std::vector<size_type>   input_values(n_inputs);
+
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      // Read and evaluate only the change term. The Krylov vectors are never
+      // distributed, so the constraints, such as hanging nodes, are resolved on reading.
+      if (variable.field_type == fieldType::SCALAR)
+        {
+          auto *scalar_FEEval_ptr =
+            scalar_vars_map.at(global_var_index).at(dependencyType::CHANGE).get();
+          scalar_FEEval_ptr->reinit(cell);
+          if (n_inputs > 0)
+            {
+              scalar_FEEval_ptr->read_dof_values(src);
+              scalar_FEEval_ptr->evaluate(input_flags);
+            }
+        }
+      else
+        {
+          auto *vector_FEEval_ptr =
+            vector_vars_map.at(global_var_index).at(dependencyType::CHANGE).get();
+          vector_FEEval_ptr->reinit(cell);
+          if (n_inputs > 0)
+            {
+              vector_FEEval_ptr->read_dof_values(src);
+              vector_FEEval_ptr->evaluate(input_flags);
+            }
+        }
+
+      // The outputs are written straight into the quadrature data of the FEEvaluation,
+      // which the integration below reads
+      get_change_quad_terms(global_var_index, input_flags, inputs);
+      get_change_quad_terms(global_var_index, output_flags, outputs);
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          const size_type *local_coefficients =
+            &coefficients[(cell * n_q_points + q) * n_inputs * n_outputs];
+
+          // The residual overwrites the change term, so gather it first
+          for (unsigned int i = 0; i < n_inputs; ++i)
+            {
+              input_values[i] = inputs[i][q];
+            }
+          for (unsigned int j = 0; j < n_outputs; ++j)
+            {
+              size_type output = dealii::make_vectorized_array<number>(0.0);
+              for (unsigned int i = 0; i < n_inputs; ++i)
+                {
+                  output += local_coefficients[j * n_inputs + i] * input_values[i];
+                }
+              outputs[j][q] = output;
+            }
+        }
+
+      // Integrate and add to global vector dst
+      integrate_and_distribute(dst);
+    }
+}
+
+template <int dim, int degree, typename number>
+unsigned int
+variableContainer<dim, degree, number>::get_n_linearization_coefficients() const
+{
+  Assert(subset_attributes.size() == 1,
+         dealii::ExcMessage(
+           "For nonexplicit solves, subset attributes should only be 1 variable."));
+
+  const auto &global_var_index = subset_attributes.begin()->first;
+  const auto &variable         = subset_attributes.begin()->second;
+
+  return get_n_q_points() *
+         get_n_change_terms(global_var_index, get_change_eval_flags(global_var_index)) *
+         get_n_change_terms(global_var_index, variable.eval_flags_residual_LHS);
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::eval_local_operator(
+  const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                              &func,
+  BlockVectorType                             &dst,
+  const std::vector<VectorType *>             &src,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      // Initialize, read DOFs, and set evaulation flags for each variable
+      reinit_and_eval(src, cell);
+
+      for (unsigned int q = 0; q < get_n_q_points(); ++q)
+        {
+          // Set the quadrature point
+          q_point = q;
+
+          // Grab the quadrature point location
+          dealii::Point<dim, size_type> q_point_loc = get_q_point_location();
+
+          // Calculate the residuals
+          func(*this, q_point_loc);
+        }
+
+      // Integrate and add to global vector dst
+      integrate_and_distribute(dst);
+    }
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::eval_local_operator(
+  const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                              &func,
+  BlockVectorType                             &dst,
+  const BlockVectorType                       &src,
+  const std::vector<VectorType *>             &src_subset,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      // Initialize, read DOFs, and set evaulation flags for each variable
+      reinit_and_eval(src, cell);
+      reinit_and_eval(src_subset, cell);
+
+      for (unsigned int q = 0; q < get_n_q_points(); ++q)
+        {
+          // Set the quadrature point
+          q_point = q;
+
+          // Grab the quadrature point location
+          dealii::Point<dim, size_type> q_point_loc = get_q_point_location();
+
+          // Calculate the residuals
+          func(*this, q_point_loc);
+        }
+
+      // Integrate and add to global vector dst
+      integrate_and_distribute(dst);
+    }
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::eval_local_diagonal(
+  const std::function<void(variableContainer &, const dealii::Point<dim, size_type> &)>
+                                              &func,
+  BlockVectorType                             &dst,
+  const std::vector<VectorType *>             &src_subset,
+  const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  for (const auto &[global_var_index, variable] : subset_attributes)
+    {
+      const auto pair = std::make_pair(global_var_index, dependencyType::CHANGE);
+
+      Assert(global_to_local_solution.find(pair) != global_to_local_solution.end(),
+             dealii::ExcMessage(
+               "The global to local mapping does not exists for global index = " +
+               std::to_string(global_var_index) +
+               "  and type = " + to_string(dependencyType::CHANGE)));
+
+      const unsigned int &block_index = global_to_local_solution.at(pair);
+
+      Assert(dst.n_blocks() > block_index,
+             dealii::ExcMessage(
+               "The provided dst block vector's size is below the given block index = " +
+               std::to_string(block_index) +
+               " for global index = " + std::to_string(global_var_index)));
+
+      n_dofs_per_cell = get_change_dofs_per_cell(global_var_index);
+      diagonal = std::make_unique<dealii::AlignedVector<size_type>>(n_dofs_per_cell);
+
+      for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+        {
+          // Reinit the cell for all the dependencies
+          reinit(cell, global_var_index);
+
+          for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+            {
+              // Submit an identity matrix for the change term of this variable and zero
+              // for the change terms of the other variables
+              for ([[maybe_unused]] const auto &[other_index, other_variable] :
+                   subset_attributes)
+                {
+                  if (variable.eval_flag_set_LHS.find(std::make_pair(
+                        other_index,
+                        dependencyType::CHANGE)) == variable.eval_flag_set_LHS.end())
+                    {
+                      continue;
+                    }
+                  zero_change_dof_values(other_index);
+                }
+              change_dof_value(global_var_index, i) =
+                dealii::make_vectorized_array<number>(1.0);
+
+              // Read plain dof values for non change src
+              read_dof_values(src_subset, cell);
+
+              // Evaluate the dependencies based on the flags
+              eval(global_var_index);
+
+              for (unsigned int q = 0; q < get_n_q_points(); ++q)
+                {
+                  // Set the quadrature point
+                  q_point = q;
+
+                  // Grab the quadrature point location
+                  dealii::Point<dim, size_type> q_point_loc = get_q_point_location();
+
+                  // Calculate the residuals
+                  func(*this, q_point_loc);
+                }
+
+              // Integrate the diagonal
+              integrate(global_var_index);
+              (*diagonal)[i] = change_dof_value(global_var_index, i);
+            }
+
+          for (unsigned int i = 0; i < n_dofs_per_cell; ++i)
+            {
+              change_dof_value(global_var_index, i) = (*diagonal)[i];
+            }
+          distribute_change(global_var_index, dst.block(block_index));
         }
-      scalar_FEEval_ptr->distribute_local_to_global(dst);
     }
 }
 
@@ -311,6 +706,17 @@ variableContainer<dim, degree, number>::submission_valid(
                             "change gradient terms."));
 }
 
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::subset_size_valid() const
+{
+  Assert(subset_attributes.size() == 1 ||
+           subset_attributes.begin()->second.field_solve_type ==
+             fieldSolveType::NONEXPLICIT_CO_NONLINEAR,
+         dealii::ExcMessage("For nonexplicit solves, subset attributes should only be 1 "
+                            "variable, unless the variables are co-nonlinear."));
+}
+
 template <int dim, int degree, typename number>
 unsigned int
 variableContainer<dim, degree, number>::get_n_q_points() const
@@ -474,9 +880,7 @@ variableContainer<dim, degree, number>::reinit_and_eval(
       return;
     }
 
-  Assert(subset_attributes.size() == 1,
-         dealii::ExcMessage(
-           "For nonexplicit solves, subset attributes should only be 1 variable."));
+  subset_size_valid();
 
   if (solve_type == solveType::NONEXPLICIT_LHS)
     {
@@ -497,7 +901,9 @@ variableContainer<dim, degree, number>::reinit_and_eval(const VectorType &src,
 {
   // Reinit and eval values for the given dependency set. Note the dependency set includes
   // the variable we're evaluating, which may or may not be an actually dependency. For
-  // this reason, I selectively read dofs and evaluate the flags.
+  // this reason, I selectively read dofs and evaluate the flags. The src is a Krylov
+  // vector that is never distributed, so the constraints, such as hanging nodes, are
+  // resolved on reading.
   auto reinit_and_eval_map =
     [&](const std::unordered_map<std::pair<unsigned int, dependencyType>,
                                  dealii::EvaluationFlags::EvaluationFlags,
@@ -523,7 +929,7 @@ variableContainer<dim, degree, number>::reinit_and_eval(const VectorType &src,
                 auto *scalar_FEEval_ptr =
                   scalar_vars_map.at(dependency_index).at(dependency_type).get();
                 scalar_FEEval_ptr->reinit(cell);
-                scalar_FEEval_ptr->read_dof_values_plain(src);
+                scalar_FEEval_ptr->read_dof_values(src);
                 scalar_FEEval_ptr->evaluate(eval_flag_set.at(pair));
               }
             else
@@ -533,7 +939,7 @@ variableContainer<dim, degree, number>::reinit_and_eval(const VectorType &src,
                 auto *vector_FEEval_ptr =
                   vector_vars_map.at(dependency_index).at(dependency_type).get();
                 vector_FEEval_ptr->reinit(cell);
-                vector_FEEval_ptr->read_dof_values_plain(src);
+                vector_FEEval_ptr->read_dof_values(src);
                 vector_FEEval_ptr->evaluate(eval_flag_set.at(pair));
               }
           }
@@ -557,6 +963,75 @@ variableContainer<dim, degree, number>::reinit_and_eval(const VectorType &src,
     }
 }
 
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::reinit_and_eval(const BlockVectorType &src,
+                                                        unsigned int           cell)
+{
+  Assert(solve_type == solveType::NONEXPLICIT_LHS,
+         dealii::ExcMessage(
+           "reinit_and_eval(src) should only be called for LHS evaluations"));
+
+  // Only the change terms are read from the block vector. All other dependencies are
+  // read from the src subset. Like for a single field, the constraints of the change are
+  // resolved on reading.
+  const auto &eval_flag_set  = subset_attributes.begin()->second.eval_flag_set_LHS;
+  const auto &dependency_set = subset_attributes.begin()->second.dependency_set_LHS;
+  for (const auto &[dependency_index, map] : dependency_set)
+    {
+      const auto iterator = map.find(dependencyType::CHANGE);
+      if (iterator == map.end())
+        {
+          continue;
+        }
+
+      const auto &pair = std::make_pair(dependency_index, dependencyType::CHANGE);
+
+      Assert(global_to_local_solution.find(pair) != global_to_local_solution.end(),
+             dealii::ExcMessage(
+               "The global to local mapping does not exists for global index = " +
+               std::to_string(dependency_index) +
+               "  and type = " + to_string(dependencyType::CHANGE)));
+
+      const unsigned int &block_index = global_to_local_solution.at(pair);
+
+      Assert(src.n_blocks() > block_index,
+             dealii::ExcMessage(
+               "The provided src block vector's size is below the given block index = " +
+               std::to_string(block_index) +
+               " for global index = " + std::to_string(dependency_index)));
+
+      if (iterator->second == fieldType::SCALAR)
+        {
+          scalar_FEEval_exists(dependency_index, dependencyType::CHANGE);
+
+          auto *scalar_FEEval_ptr =
+            scalar_vars_map.at(dependency_index).at(dependencyType::CHANGE).get();
+          scalar_FEEval_ptr->reinit(cell);
+
+          if (eval_flag_set.find(pair) != eval_flag_set.end())
+            {
+              scalar_FEEval_ptr->read_dof_values(src.block(block_index));
+              scalar_FEEval_ptr->evaluate(eval_flag_set.at(pair));
+            }
+        }
+      else
+        {
+          vector_FEEval_exists(dependency_index, dependencyType::CHANGE);
+
+          auto *vector_FEEval_ptr =
+            vector_vars_map.at(dependency_index).at(dependencyType::CHANGE).get();
+          vector_FEEval_ptr->reinit(cell);
+
+          if (eval_flag_set.find(pair) != eval_flag_set.end())
+            {
+              vector_FEEval_ptr->read_dof_values(src.block(block_index));
+              vector_FEEval_ptr->evaluate(eval_flag_set.at(pair));
+            }
+        }
+    }
+}
+
 template <int dim, int degree, typename number>
 void
 variableContainer<dim, degree, number>::reinit(unsigned int        cell,
@@ -704,9 +1179,7 @@ variableContainer<dim, degree, number>::read_dof_values(
       return;
     }
 
-  Assert(subset_attributes.size() == 1,
-         dealii::ExcMessage(
-           "For nonexplicit solves, subset attributes should only be 1 variable."));
+  subset_size_valid();
 
   reinit_and_eval_map(subset_attributes.begin()->second.eval_flag_set_LHS,
                       subset_attributes.begin()->second.dependency_set_LHS);
@@ -808,6 +1281,195 @@ variableContainer<dim, degree, number>::integrate(
     }
 }
 
+template <int dim, int degree, typename number>
+unsigned int
+variableContainer<dim, degree, number>::get_change_dofs_per_cell(
+  const unsigned int &global_variable_index) const
+{
+  Assert(subset_attributes.find(global_variable_index) != subset_attributes.end(),
+         dealii::ExcMessage(
+           "The subset attribute entry does not exists for global index = " +
+           std::to_string(global_variable_index)));
+
+  if (subset_attributes.at(global_variable_index).field_type == fieldType::SCALAR)
+    {
+      scalar_FEEval_exists(global_variable_index, dependencyType::CHANGE);
+
+      return scalar_vars_map.at(global_variable_index)
+        .at(dependencyType::CHANGE)
+        ->dofs_per_cell;
+    }
+  vector_FEEval_exists(global_variable_index, dependencyType::CHANGE);
+
+  return vector_vars_map.at(global_variable_index)
+    .at(dependencyType::CHANGE)
+    ->dofs_per_cell;
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::zero_change_dof_values(
+  const unsigned int &global_variable_index)
+{
+  if (subset_attributes.at(global_variable_index).field_type == fieldType::SCALAR)
+    {
+      auto *scalar_FEEval_ptr =
+        scalar_vars_map.at(global_variable_index).at(dependencyType::CHANGE).get();
+      for (unsigned int i = 0; i < scalar_FEEval_ptr->dofs_per_component; ++i)
+        {
+          scalar_FEEval_ptr->submit_dof_value(size_type(), i);
+        }
+    }
+  else
+    {
+      // The value type is a tensor of all components for dim > 1 and a vectorized array
+      // for dim = 1, both of which are value-initialized to zero.
+      auto *vector_FEEval_ptr =
+        vector_vars_map.at(global_variable_index).at(dependencyType::CHANGE).get();
+      for (unsigned int i = 0; i < vector_FEEval_ptr->dofs_per_component; ++i)
+        {
+          vector_FEEval_ptr->submit_dof_value(typename vector_FEEval::value_type(), i);
+        }
+    }
+}
+
+template <int dim, int degree, typename number>
+typename variableContainer<dim, degree, number>::size_type &
+variableContainer<dim, degree, number>::change_dof_value(
+  const unsigned int &global_variable_index,
+  unsigned int        dof_index)
+{
+  Assert(dof_index < get_change_dofs_per_cell(global_variable_index),
+         dealii::ExcIndexRange(dof_index,
+                               0,
+                               get_change_dofs_per_cell(global_variable_index)));
+
+  // The dof values are stored component by component, so vector fields are indexed
+  // with component * dofs_per_component + i.
+  if (subset_attributes.at(global_variable_index).field_type == fieldType::SCALAR)
+    {
+      return scalar_vars_map.at(global_variable_index)
+        .at(dependencyType::CHANGE)
+        ->begin_dof_values()[dof_index];
+    }
+  return vector_vars_map.at(global_variable_index)
+    .at(dependencyType::CHANGE)
+    ->begin_dof_values()[dof_index];
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::distribute_change(
+  const unsigned int &global_variable_index,
+  VectorType         &dst)
+{
+  if (subset_attributes.at(global_variable_index).field_type == fieldType::SCALAR)
+    {
+      scalar_vars_map.at(global_variable_index)
+        .at(dependencyType::CHANGE)
+        ->distribute_local_to_global(dst);
+    }
+  else
+    {
+      vector_vars_map.at(global_variable_index)
+        .at(dependencyType::CHANGE)
+        ->distribute_local_to_global(dst);
+    }
+}
+
+template <int dim, int degree, typename number>
+dealii::EvaluationFlags::EvaluationFlags
+variableContainer<dim, degree, number>::get_change_eval_flags(
+  const unsigned int &global_variable_index) const
+{
+  Assert(subset_attributes.find(global_variable_index) != subset_attributes.end(),
+         dealii::ExcMessage(
+           "The subset attribute entry does not exists for global index = " +
+           std::to_string(global_variable_index)));
+
+  const auto &eval_flag_set =
+    subset_attributes.at(global_variable_index).eval_flag_set_LHS;
+  const auto iterator =
+    eval_flag_set.find(std::make_pair(global_variable_index, dependencyType::CHANGE));
+  if (iterator == eval_flag_set.end())
+    {
+      return dealii::EvaluationFlags::nothing;
+    }
+  return iterator->second;
+}
+
+template <int dim, int degree, typename number>
+unsigned int
+variableContainer<dim, degree, number>::get_n_change_terms(
+  const unsigned int                             &global_variable_index,
+  const dealii::EvaluationFlags::EvaluationFlags &flags) const
+{
+  const unsigned int n_components =
+    subset_attributes.at(global_variable_index).field_type == fieldType::SCALAR ? 1
+                                                                                 : dim;
+
+  unsigned int n_terms = 0;
+  if (flags & dealii::EvaluationFlags::values)
+    {
+      n_terms += n_components;
+    }
+  if (flags & dealii::EvaluationFlags::gradients)
+    {
+      n_terms += n_components * dim;
+    }
+  return n_terms;
+}
+
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::get_change_quad_terms(
+  const unsigned int                             &global_variable_index,
+  const dealii::EvaluationFlags::EvaluationFlags &flags,
+  std::vector<size_type *>                       &terms)
+{
+  size_type   *values       = nullptr;
+  size_type   *gradients    = nullptr;
+  unsigned int n_components = 1;
+  unsigned int n_q_points   = 0;
+  if (subset_attributes.at(global_variable_index).field_type == fieldType::SCALAR)
+    {
+      auto *scalar_FEEval_ptr =
+        scalar_vars_map.at(global_variable_index).at(dependencyType::CHANGE).get();
+      values     = scalar_FEEval_ptr->begin_values();
+      gradients  = scalar_FEEval_ptr->begin_gradients();
+      n_q_points = scalar_FEEval_ptr->n_q_points;
+    }
+  else
+    {
+      auto *vector_FEEval_ptr =
+        vector_vars_map.at(global_variable_index).at(dependencyType::CHANGE).get();
+      values       = vector_FEEval_ptr->begin_values();
+      gradients    = vector_FEEval_ptr->begin_gradients();
+      n_components = dim;
+      n_q_points   = vector_FEEval_ptr->n_q_points;
+    }
+
+  // deal.II stores the values as [component][q] and the gradients as
+  // [component][direction][q]. The non-const begin_values() and begin_gradients() are
+  // deal.II's raw access to the quadrature data, so writing through them counts as
+  // submitting the data for integrate().
+  terms.clear();
+  if (flags & dealii::EvaluationFlags::values)
+    {
+      for (unsigned int component = 0; component < n_components; ++component)
+        {
+          terms.push_back(values + component * n_q_points);
+        }
+    }
+  if (flags & dealii::EvaluationFlags::gradients)
+    {
+      for (unsigned int term = 0; term < n_components * dim; ++term)
+        {
+          terms.push_back(gradients + term * n_q_points);
+        }
+    }
+}
+
 template <int dim, int degree, typename number>
 void
 variableContainer<dim, degree, number>::integrate_and_distribute(
@@ -926,6 +1588,54 @@ variableContainer<dim, degree, number>::integrate_and_distribute(VectorType &dst
     }
 }
 
+template <int dim, int degree, typename number>
+void
+variableContainer<dim, degree, number>::integrate_and_distribute(BlockVectorType &dst)
+{
+  // Each variable of the subset has its own block. For the LHS that is the change term
+  // and for the RHS the normal term.
+  const dependencyType dependency_type = solve_type == solveType::NONEXPLICIT_LHS
+                                           ? dependencyType::CHANGE
+                                           : dependencyType::NORMAL;
+
+  for (const auto &[index, variable] : subset_attributes)
+    {
+      const auto &pair = std::make_pair(index, dependency_type);
+
+      Assert(global_to_local_solution.find(pair) != global_to_local_solution.end(),
+             dealii::ExcMessage(
+               "The global to local mapping does not exists for global index = " +
+               std::to_string(index) + "  and type = " + to_string(dependency_type)));
+
+      const unsigned int &block_index = global_to_local_solution.at(pair);
+
+      Assert(dst.n_blocks() > block_index,
+             dealii::ExcMessage(
+               "The provided dst block vector's size is below the given block index = " +
+               std::to_string(block_index) + " for global index = " +
+               std::to_string(index)));
+
+      const dealii::EvaluationFlags::EvaluationFlags &residual_flag_set =
+        solve_type == solveType::NONEXPLICIT_LHS ? variable.eval_flags_residual_LHS
+                                                 : variable.eval_flags_residual_RHS;
+
+      if (variable.field_type == fieldType::SCALAR)
+        {
+          scalar_FEEval_exists(index, dependency_type);
+
+          auto *scalar_FEEval_ptr = scalar_vars_map.at(index).at(dependency_type).get();
+          scalar_FEEval_ptr->integrate_scatter(residual_flag_set, dst.block(block_index));
+        }
+      else
+        {
+          vector_FEEval_exists(index, dependency_type);
+
+          auto *vector_FEEval_ptr = vector_vars_map.at(index).at(dependency_type).get();
+          vector_FEEval_ptr->integrate_scatter(residual_flag_set, dst.block(block_index));
+        }
+    }
+}
+
 template <int dim, int degree, typename number>
 typename variableContainer<dim, degree, number>::size_type
 variableContainer<dim, degree, number>::get_scalar_value(
@@ -285,6 +285,7 @@ inputFileReader::declare_parameters()
   declare_output_parameters();
   declare_load_IC_parameters();
   declare_checkpoint_parameters();
+  declare_parareal_parameters();
   declare_BC_parameters();
   declare_pinning_parameters();
   declare_nucleation_parameters();
@@ -353,6 +354,13 @@ inputFileReader::declare_mesh()
   }
   parameter_handler.leave_subsection();
 
+  parameter_handler.declare_entry(
+    "fully distributed mesh",
+    "false",
+    dealii::Patterns::Bool(),
+    "Whether each process only creates its own partition of the rectangular mesh, "
+    "rather than the whole coarse mesh. This reduces the memory and setup time of "
+    "meshes with many subdivisions, but doesn't support mesh adaptivity.");
   parameter_handler.declare_entry("mesh adaptivity",
                                   "false",
                                   dealii::Patterns::Bool(),
@@ -370,6 +378,25 @@ inputFileReader::declare_mesh()
     "2147483647",
     dealii::Patterns::Integer(1, INT_MAX),
     "The number of time steps between mesh refinement operations.");
+  parameter_handler.declare_entry(
+    "active field cost",
+    "0",
+    dealii::Patterns::Double(0.0, DBL_MAX),
+    "The extra cost of a cell for each field that varies over it, relative to the cost "
+    "of a bulk cell. This weights the partitioning of the mesh after remeshing. Zero "
+    "partitions by the number of cells.");
+  parameter_handler.declare_entry(
+    "calibrate active field cost",
+    "true",
+    dealii::Patterns::Bool(),
+    "Whether to fit the active field cost to the measured cost of each process before "
+    "each remeshing. The input value is used until a fit is possible.");
+  parameter_handler.declare_entry(
+    "active field threshold",
+    "1e-3",
+    dealii::Patterns::Double(0.0, DBL_MAX),
+    "A field is active on a cell if its variation over the cell exceeds this fraction "
+    "of its maximum magnitude.");
 
   for (const auto &[index, variable] : var_attributes)
     {
@@ -421,6 +448,18 @@ inputFileReader::declare_time_discretization()
     "0.0",
     dealii::Patterns::Double(0.0, DBL_MAX),
     "The value of simulated time where the simulation ends.");
+  parameter_handler.declare_entry(
+    "steady state tolerance",
+    "0.0",
+    dealii::Patterns::Double(0.0, DBL_MAX),
+    "The relative change of the time-dependent fields between increments below which "
+    "the simulation is considered to be at steady-state and is stopped. A value of "
+    "zero disables steady-state detection.");
+  parameter_handler.declare_entry(
+    "steady state check period",
+    "1",
+    dealii::Patterns::Integer(1, INT_MAX),
+    "The number of time steps between steady-state checks.");
 }
 
 void
@@ -452,11 +491,97 @@ inputFileReader::declare_solver_parameters()
               dealii::Patterns::Integer(1, INT_MAX),
               "The maximum number of linear solver iterations before the loop "
               "is stopped.");
+            parameter_handler.declare_entry(
+              "solver type",
+              "CG",
+              dealii::Patterns::Selection("CG|GMRES|FGMRES|BICGSTAB|PIPELINED_CG"),
+              "The Krylov method for the linear solver. CG and PIPELINED_CG require a "
+              "symmetric positive definite operator.");
+            parameter_handler.declare_entry(
+              "gmres restart",
+              "30",
+              dealii::Patterns::Integer(1, INT_MAX),
+              "The number of GMRES or FGMRES iterations between restarts.");
+            parameter_handler.declare_entry(
+              "recycled subspace size",
+              "0",
+              dealii::Patterns::Integer(0, INT_MAX),
+              "The number of approximate eigenvectors that CG keeps between solves to "
+              "deflate the slowest modes. A value of zero disables this.");
+            parameter_handler.declare_entry(
+              "initial guess",
+              "NONE",
+              dealii::Patterns::Selection("NONE|LINEAR|QUADRATIC|POD"),
+              "The initial guess for the linear solver. LINEAR and QUADRATIC "
+              "extrapolate the updates of the previous solves and POD projects the "
+              "system onto the span of the previous updates.");
+            parameter_handler.declare_entry(
+              "initial guess history",
+              "4",
+              dealii::Patterns::Integer(1, INT_MAX),
+              "The number of previous updates used for the POD initial guess.");
+            parameter_handler.declare_entry(
+              "frozen linearization",
+              "false",
+              dealii::Patterns::Bool(),
+              "Whether to linearize the LHS once per solve and cache the coefficients at "
+              "each quadrature point for all operator applications of the solve.");
+            parameter_handler.declare_entry(
+              "mixed precision",
+              "false",
+              dealii::Patterns::Bool(),
+              "Whether to run the Krylov iterations in single precision and correct "
+              "them with the residual in double precision.");
+            parameter_handler.declare_entry(
+              "mixed precision reduction",
+              "1.0e-3",
+              dealii::Patterns::Double(DBL_MIN, 1.0),
+              "The residual reduction of the single precision solve in each "
+              "refinement step.");
+            parameter_handler.declare_entry(
+              "batched solve",
+              "false",
+              dealii::Patterns::Bool(),
+              "Whether to solve this field together with the other decoupled linear "
+              "fields that enable this, with a single batched CG.");
+            parameter_handler.declare_entry(
+              "resolve criterion",
+              "ALWAYS",
+              dealii::Patterns::Selection("ALWAYS|RESIDUAL|DEPENDENCY_CHANGE"),
+              "When a TIME_INDEPENDENT field is solved again. RESIDUAL and "
+              "DEPENDENCY_CHANGE keep the previous solution while the residual or the "
+              "relative change of the dependencies since the last solve is below the "
+              "resolve tolerance.");
+            parameter_handler.declare_entry(
+              "resolve tolerance",
+              "1.0e-3",
+              dealii::Patterns::Double(0.0),
+              "The threshold of the resolve criterion.");
+            parameter_handler.declare_entry(
+              "max skipped solves",
+              "10",
+              dealii::Patterns::Integer(0),
+              "The maximum number of consecutive increments without a solve. A value of "
+              "zero removes the limit.");
+            parameter_handler.declare_entry(
+              "jacobian free",
+              "false",
+              dealii::Patterns::Bool(),
+              "Whether to form the Jacobian-vector products by finite differences of the "
+              "residual. The LHS is then only used for the preconditioner.");
+            parameter_handler.declare_entry(
+              "check jacobian",
+              "false",
+              dealii::Patterns::Bool(),
+              "Whether to compare the LHS against finite differences of the residual "
+              "before each solve.");
             parameter_handler.declare_entry(
               "preconditioner type",
               "GMG",
-              dealii::Patterns::Selection("NONE|GMG"),
-              "The preconditioner type for the linear solver.");
+              dealii::Patterns::Selection("NONE|GMG|JACOBI|CHEBYSHEV|CELL_PATCH"),
+              "The preconditioner type for the linear solver. JACOBI and CHEBYSHEV are "
+              "built from the diagonal of the matrix-free operator. CELL_PATCH is an "
+              "additive Schwarz method with one fast diagonalization block per cell.");
             parameter_handler.declare_entry("smoothing range",
                                             "15.0",
                                             dealii::Patterns::Double(DBL_MIN, DBL_MAX),
@@ -470,6 +595,48 @@ inputFileReader::declare_solver_parameters()
               "10",
               dealii::Patterns::Integer(1, INT_MAX),
               "The maximum number of CG iterations used to find the maximum eigenvalue.");
+            parameter_handler.declare_entry(
+              "preconditioner rebuild period",
+              "1",
+              dealii::Patterns::Integer(0, INT_MAX),
+              "The number of solves between rebuilds of the preconditioner. A value of "
+              "zero never rebuilds it after the first solve.");
+            parameter_handler.declare_entry(
+              "preconditioner rebuild iteration growth",
+              "0.0",
+              dealii::Patterns::Double(0.0, DBL_MAX),
+              "The percentage growth of the number of linear iterations, relative to "
+              "the first solve after the last rebuild, that triggers a rebuild of the "
+              "preconditioner. A value of zero disables this.");
+            parameter_handler.declare_entry(
+              "polynomial coarsening",
+              "NONE",
+              dealii::Patterns::Selection("NONE|DECREASE_BY_ONE|BISECT|GO_TO_ONE"),
+              "The sequence of polynomial degrees for the multigrid preconditioner. "
+              "The degree is coarsened down to one before the mesh is coarsened.");
+            parameter_handler.declare_entry(
+              "smoother type",
+              "JACOBI",
+              dealii::Patterns::Selection("JACOBI|CELL_PATCH"),
+              "The preconditioner of the Chebyshev smoother of the multigrid "
+              "preconditioner. CELL_PATCH assumes Cartesian cells and a Laplace-like "
+              "operator and requires deal.II with LAPACK.");
+            parameter_handler.declare_entry(
+              "coarse solver",
+              "SMOOTHER",
+              dealii::Patterns::Selection("SMOOTHER|CG|AMG|DIRECT"),
+              "The solver for the coarsest multigrid level. AMG and DIRECT require "
+              "deal.II with Trilinos or PETSc.");
+            parameter_handler.declare_entry(
+              "coarse tolerance",
+              "1.0e-10",
+              dealii::Patterns::Double(DBL_MIN, DBL_MAX),
+              "The relative residual reduction for the iterative coarse solvers.");
+            parameter_handler.declare_entry(
+              "coarse max iterations",
+              "1000",
+              dealii::Patterns::Integer(1, INT_MAX),
+              "The maximum number of iterations for the iterative coarse solvers.");
           }
           parameter_handler.leave_subsection();
         }
@@ -518,12 +685,38 @@ inputFileReader::declare_solver_parameters()
               dealii::Patterns::Double(0.0, 1.0),
               "The constant that determines how much the residual must "
               "decrease to be accepted as sufficient. The 'c' parameter.");
+            parameter_handler.declare_entry(
+              "min step size",
+              "1.0e-4",
+              dealii::Patterns::Double(DBL_MIN, 1.0),
+              "The smallest step size the line search tries. If the residual has not "
+              "decreased sufficiently once the next backtrack would go below it, the "
+              "step is accepted and the newton iterations continue.");
             parameter_handler.declare_entry(
               "step size",
               "1.0",
               dealii::Patterns::Double(0.0, 1.0),
               "The constant damping value to be used if the backtrace "
               "line-search approach isn't used.");
+            parameter_handler.declare_entry(
+              "update tolerance value",
+              "0.0",
+              dealii::Patterns::Double(0.0, DBL_MAX),
+              "The l2-norm of the newton update relative to the l2-norm of the "
+              "solution below which the nonlinear solver is converged. A value of "
+              "zero disables this criterion.");
+            parameter_handler.declare_entry(
+              "use eisenstat walker",
+              "false",
+              dealii::Patterns::Bool(),
+              "Whether to use Eisenstat-Walker adaptive tolerances for the linear "
+              "solves. This overrides the linear solver tolerance.");
+            parameter_handler.declare_entry(
+              "max forcing term",
+              "0.9",
+              dealii::Patterns::Double(0.0, 1.0),
+              "The maximum Eisenstat-Walker forcing term, which is the linear solver "
+              "tolerance relative to the nonlinear residual.");
           }
           parameter_handler.leave_subsection();
         }
@@ -637,6 +830,38 @@ inputFileReader::declare_checkpoint_parameters()
   parameter_handler.leave_subsection();
 }
 
+void
+inputFileReader::declare_parareal_parameters()
+{
+  parameter_handler.enter_subsection("parareal");
+  {
+    parameter_handler.declare_entry(
+      "number of time slices",
+      "1",
+      dealii::Patterns::Integer(1, INT_MAX),
+      "The number of time slices that are solved concurrently. The MPI processes are "
+      "split evenly among the time slices. A value of 1 disables parareal.");
+    parameter_handler.declare_entry(
+      "coarse time step ratio",
+      "10",
+      dealii::Patterns::Integer(1, INT_MAX),
+      "The ratio of the coarse propagator time step to the fine time step.");
+    parameter_handler.declare_entry(
+      "max iterations",
+      "0",
+      dealii::Patterns::Integer(0, INT_MAX),
+      "The maximum number of parareal iterations. A value of 0 uses the number of time "
+      "slices.");
+    parameter_handler.declare_entry(
+      "tolerance",
+      "1.0e-8",
+      dealii::Patterns::Double(0.0, DBL_MAX),
+      "The relative change of the time slice states below which parareal is "
+      "converged.");
+  }
+  parameter_handler.leave_subsection();
+}
+
 void
 inputFileReader::declare_BC_parameters()
 {
@@ -33,16 +33,18 @@ userInputParameters<dim>::userInputParameters(inputFileReader          &input_fi
   assign_nonlinear_solve_parameters(parameter_handler);
   assign_output_parameters(parameter_handler);
   assign_checkpoint_parameters(parameter_handler);
+  assign_parareal_parameters(parameter_handler);
   assign_boundary_parameters(parameter_handler);
   load_model_constants(input_file_reader, parameter_handler);
 
   // Perform and postprocessing of user inputs and run checks
   spatial_discretization.postprocess_and_validate();
   temporal_discretization.postprocess_and_validate(var_attributes);
-  linear_solve_parameters.postprocess_and_validate();
-  nonlinear_solve_parameters.postprocess_and_validate();
+  linear_solve_parameters.postprocess_and_validate(var_attributes);
+  nonlinear_solve_parameters.postprocess_and_validate(var_attributes);
   output_parameters.postprocess_and_validate(temporal_discretization);
   checkpoint_parameters.postprocess_and_validate(temporal_discretization);
+  parareal_parameters.postprocess_and_validate(temporal_discretization);
   boundary_parameters.postprocess_and_validate(var_attributes);
 
   // Print all the parameters to summary.log
@@ -52,6 +54,7 @@ userInputParameters<dim>::userInputParameters(inputFileReader          &input_fi
   nonlinear_solve_parameters.print_parameter_summary();
   output_parameters.print_parameter_summary();
   checkpoint_parameters.print_parameter_summary();
+  parareal_parameters.print_parameter_summary();
   boundary_parameters.print_parameter_summary();
 }
 
@@ -84,11 +87,21 @@ userInputParameters<dim>::assign_spatial_discretization_parameters(
 
   spatial_discretization.degree = parameter_handler.get_integer("degree");
 
+  spatial_discretization.fully_distributed =
+    parameter_handler.get_bool("fully distributed mesh");
+
   spatial_discretization.has_adaptivity = parameter_handler.get_bool("mesh adaptivity");
 
   spatial_discretization.remeshing_period =
     parameter_handler.get_integer("remeshing period");
 
+  spatial_discretization.active_field_cost =
+    parameter_handler.get_double("active field cost");
+  spatial_discretization.calibrate_active_field_cost =
+    parameter_handler.get_bool("calibrate active field cost");
+  spatial_discretization.active_field_threshold =
+    parameter_handler.get_double("active field threshold");
+
   spatial_discretization.max_refinement = parameter_handler.get_integer("max refinement");
   spatial_discretization.min_refinement = parameter_handler.get_integer("min refinement");
 
@@ -148,6 +161,10 @@ userInputParameters<dim>::assign_temporal_discretization_parameters(
   temporal_discretization.final_time = parameter_handler.get_double("end time");
   temporal_discretization.total_increments =
     static_cast<unsigned int>(parameter_handler.get_integer("number steps"));
+  temporal_discretization.steady_state_tolerance =
+    parameter_handler.get_double("steady state tolerance");
+  temporal_discretization.steady_state_check_period =
+    static_cast<unsigned int>(parameter_handler.get_integer("steady state check period"));
 }
 
 template <int dim>
@@ -192,6 +209,24 @@ userInputParameters<dim>::assign_checkpoint_parameters(
   parameter_handler.leave_subsection();
 }
 
+template <int dim>
+void
+userInputParameters<dim>::assign_parareal_parameters(
+  dealii::ParameterHandler &parameter_handler)
+{
+  parameter_handler.enter_subsection("parareal");
+  {
+    parareal_parameters.n_time_slices =
+      static_cast<unsigned int>(parameter_handler.get_integer("number of time slices"));
+    parareal_parameters.coarse_timestep_ratio =
+      static_cast<unsigned int>(parameter_handler.get_integer("coarse time step ratio"));
+    parareal_parameters.max_iterations =
+      static_cast<unsigned int>(parameter_handler.get_integer("max iterations"));
+    parareal_parameters.tolerance = parameter_handler.get_double("tolerance");
+  }
+  parameter_handler.leave_subsection();
+}
+
 template <int dim>
 void
 userInputParameters<dim>::assign_boundary_parameters(
@@ -303,11 +338,148 @@ userInputParameters<dim>::assign_linear_solve_parameters(
           linear_solve_parameters.linear_solve[index].max_iterations =
             parameter_handler.get_integer("max iterations");
 
+          // Set the Krylov method
+          const std::string solver_string = parameter_handler.get("solver type");
+          if (boost::iequals(solver_string, "CG"))
+            {
+              linear_solve_parameters.linear_solve[index].solver_type =
+                linearSolverType::SOLVER_CG;
+            }
+          else if (boost::iequals(solver_string, "GMRES"))
+            {
+              linear_solve_parameters.linear_solve[index].solver_type =
+                linearSolverType::SOLVER_GMRES;
+            }
+          else if (boost::iequals(solver_string, "FGMRES"))
+            {
+              linear_solve_parameters.linear_solve[index].solver_type =
+                linearSolverType::SOLVER_FGMRES;
+            }
+          else if (boost::iequals(solver_string, "BICGSTAB"))
+            {
+              linear_solve_parameters.linear_solve[index].solver_type =
+                linearSolverType::SOLVER_BICGSTAB;
+            }
+          else if (boost::iequals(solver_string, "PIPELINED_CG"))
+            {
+              linear_solve_parameters.linear_solve[index].solver_type =
+                linearSolverType::SOLVER_PIPELINED_CG;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
+
+          linear_solve_parameters.linear_solve[index].gmres_restart =
+            parameter_handler.get_integer("gmres restart");
+
+          linear_solve_parameters.linear_solve[index].recycled_subspace_size =
+            parameter_handler.get_integer("recycled subspace size");
+
+          // Set the initial guess
+          const std::string guess_string = parameter_handler.get("initial guess");
+          if (boost::iequals(guess_string, "NONE"))
+            {
+              linear_solve_parameters.linear_solve[index].initial_guess =
+                initialGuessType::ZERO_INITIAL_GUESS;
+            }
+          else if (boost::iequals(guess_string, "LINEAR"))
+            {
+              linear_solve_parameters.linear_solve[index].initial_guess =
+                initialGuessType::LINEAR_EXTRAPOLATION;
+            }
+          else if (boost::iequals(guess_string, "QUADRATIC"))
+            {
+              linear_solve_parameters.linear_solve[index].initial_guess =
+                initialGuessType::QUADRATIC_EXTRAPOLATION;
+            }
+          else if (boost::iequals(guess_string, "POD"))
+            {
+              linear_solve_parameters.linear_solve[index].initial_guess =
+                initialGuessType::POD_PROJECTION;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
+
+          linear_solve_parameters.linear_solve[index].initial_guess_history =
+            parameter_handler.get_integer("initial guess history");
+
+          linear_solve_parameters.linear_solve[index].frozen_linearization =
+            parameter_handler.get_bool("frozen linearization");
+
+          linear_solve_parameters.linear_solve[index].mixed_precision =
+            parameter_handler.get_bool("mixed precision");
+          linear_solve_parameters.linear_solve[index].mixed_precision_reduction =
+            parameter_handler.get_double("mixed precision reduction");
+
+          linear_solve_parameters.linear_solve[index].batched_solve =
+            parameter_handler.get_bool("batched solve");
+
+          // Set the resolve criterion
+          const std::string resolve_string = parameter_handler.get("resolve criterion");
+          if (boost::iequals(resolve_string, "ALWAYS"))
+            {
+              linear_solve_parameters.linear_solve[index].resolve_criterion =
+                resolveCriterion::ALWAYS_RESOLVE;
+            }
+          else if (boost::iequals(resolve_string, "RESIDUAL"))
+            {
+              linear_solve_parameters.linear_solve[index].resolve_criterion =
+                resolveCriterion::RESIDUAL_RESOLVE;
+            }
+          else if (boost::iequals(resolve_string, "DEPENDENCY_CHANGE"))
+            {
+              linear_solve_parameters.linear_solve[index].resolve_criterion =
+                resolveCriterion::DEPENDENCY_CHANGE_RESOLVE;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
+          linear_solve_parameters.linear_solve[index].resolve_tolerance =
+            parameter_handler.get_double("resolve tolerance");
+          linear_solve_parameters.linear_solve[index].max_skipped_solves =
+            parameter_handler.get_integer("max skipped solves");
+
+          linear_solve_parameters.linear_solve[index].jacobian_free =
+            parameter_handler.get_bool("jacobian free");
+          linear_solve_parameters.linear_solve[index].check_jacobian =
+            parameter_handler.get_bool("check jacobian");
+
           // Set preconditioner type and related parameters
-          linear_solve_parameters.linear_solve[index].preconditioner =
-            boost::iequals(parameter_handler.get("preconditioner type"), "GMG")
-              ? preconditionerType::GMG
-              : preconditionerType::NONE;
+          const std::string preconditioner_string =
+            parameter_handler.get("preconditioner type");
+          if (boost::iequals(preconditioner_string, "NONE"))
+            {
+              linear_solve_parameters.linear_solve[index].preconditioner =
+                preconditionerType::NONE;
+            }
+          else if (boost::iequals(preconditioner_string, "GMG"))
+            {
+              linear_solve_parameters.linear_solve[index].preconditioner =
+                preconditionerType::GMG;
+            }
+          else if (boost::iequals(preconditioner_string, "JACOBI"))
+            {
+              linear_solve_parameters.linear_solve[index].preconditioner =
+                preconditionerType::JACOBI;
+            }
+          else if (boost::iequals(preconditioner_string, "CHEBYSHEV"))
+            {
+              linear_solve_parameters.linear_solve[index].preconditioner =
+                preconditionerType::CHEBYSHEV;
+            }
+          else if (boost::iequals(preconditioner_string, "CELL_PATCH"))
+            {
+              linear_solve_parameters.linear_solve[index].preconditioner =
+                preconditionerType::CELL_PATCH;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
 
           linear_solve_parameters.linear_solve[index].smoothing_range =
             parameter_handler.get_double("smoothing range");
@@ -318,6 +490,91 @@ userInputParameters<dim>::assign_linear_solve_parameters(
           linear_solve_parameters.linear_solve[index].eig_cg_n_iterations =
             parameter_handler.get_integer("eigenvalue cg iterations");
 
+          linear_solve_parameters.linear_solve[index].preconditioner_rebuild_period =
+            parameter_handler.get_integer("preconditioner rebuild period");
+
+          linear_solve_parameters.linear_solve[index]
+            .preconditioner_rebuild_iteration_growth =
+            parameter_handler.get_double("preconditioner rebuild iteration growth");
+
+          // Set the polynomial coarsening sequence
+          const std::string coarsening_string =
+            parameter_handler.get("polynomial coarsening");
+          if (boost::iequals(coarsening_string, "NONE"))
+            {
+              linear_solve_parameters.linear_solve[index].polynomial_coarsening =
+                polynomialCoarseningType::NO_POLYNOMIAL_COARSENING;
+            }
+          else if (boost::iequals(coarsening_string, "DECREASE_BY_ONE"))
+            {
+              linear_solve_parameters.linear_solve[index].polynomial_coarsening =
+                polynomialCoarseningType::DECREASE_BY_ONE;
+            }
+          else if (boost::iequals(coarsening_string, "BISECT"))
+            {
+              linear_solve_parameters.linear_solve[index].polynomial_coarsening =
+                polynomialCoarseningType::BISECT;
+            }
+          else if (boost::iequals(coarsening_string, "GO_TO_ONE"))
+            {
+              linear_solve_parameters.linear_solve[index].polynomial_coarsening =
+                polynomialCoarseningType::GO_TO_ONE;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
+
+          // Set the smoother type
+          const std::string smoother_string = parameter_handler.get("smoother type");
+          if (boost::iequals(smoother_string, "JACOBI"))
+            {
+              linear_solve_parameters.linear_solve[index].smoother_type =
+                smootherType::JACOBI_SMOOTHER;
+            }
+          else if (boost::iequals(smoother_string, "CELL_PATCH"))
+            {
+              linear_solve_parameters.linear_solve[index].smoother_type =
+                smootherType::CELL_PATCH_SMOOTHER;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
+
+          // Set the coarse solver and related parameters
+          const std::string coarse_string = parameter_handler.get("coarse solver");
+          if (boost::iequals(coarse_string, "SMOOTHER"))
+            {
+              linear_solve_parameters.linear_solve[index].coarse_solver =
+                coarseSolverType::COARSE_SMOOTHER;
+            }
+          else if (boost::iequals(coarse_string, "CG"))
+            {
+              linear_solve_parameters.linear_solve[index].coarse_solver =
+                coarseSolverType::COARSE_CG;
+            }
+          else if (boost::iequals(coarse_string, "AMG"))
+            {
+              linear_solve_parameters.linear_solve[index].coarse_solver =
+                coarseSolverType::COARSE_AMG;
+            }
+          else if (boost::iequals(coarse_string, "DIRECT"))
+            {
+              linear_solve_parameters.linear_solve[index].coarse_solver =
+                coarseSolverType::COARSE_DIRECT;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
+
+          linear_solve_parameters.linear_solve[index].coarse_tolerance =
+            parameter_handler.get_double("coarse tolerance");
+
+          linear_solve_parameters.linear_solve[index].coarse_max_iterations =
+            parameter_handler.get_integer("coarse max iterations");
+
           parameter_handler.leave_subsection();
         }
     }
@@ -337,12 +594,46 @@ userInputParameters<dim>::assign_nonlinear_solve_parameters(
           subsection_text.append(variable.name);
           parameter_handler.enter_subsection(subsection_text);
 
-          nonlinear_solve_parameters.nonlinear_solve[index].max_iterations =
+          auto &nonlinear_solve = nonlinear_solve_parameters.nonlinear_solve[index];
+
+          nonlinear_solve.max_iterations =
             parameter_handler.get_integer("max iterations");
-          nonlinear_solve_parameters.nonlinear_solve[index].step_length =
-            parameter_handler.get_double("step size");
+          nonlinear_solve.step_length = parameter_handler.get_double("step size");
+
+          // Set the tolerance type
+          const std::string type_string = parameter_handler.get("tolerance type");
+          if (boost::iequals(type_string, "ABSOLUTE_RESIDUAL"))
+            {
+              nonlinear_solve.tolerance_type = solverToleranceType::ABSOLUTE_RESIDUAL;
+            }
+          else if (boost::iequals(type_string, "RELATIVE_RESIDUAL_CHANGE"))
+            {
+              nonlinear_solve.tolerance_type =
+                solverToleranceType::RELATIVE_RESIDUAL_CHANGE;
+            }
+          else
+            {
+              AssertThrow(false, UnreachableCode());
+            }
 
-          // TODO: Implement backtracking line search
+          nonlinear_solve.tolerance = parameter_handler.get_double("tolerance value");
+          nonlinear_solve.update_tolerance =
+            parameter_handler.get_double("update tolerance value");
+
+          // Line search parameters
+          nonlinear_solve.backtrack_line_search =
+            parameter_handler.get_bool("use backtracking line search");
+          nonlinear_solve.step_modifier =
+            parameter_handler.get_double("step size modifier");
+          nonlinear_solve.residual_decrease_coefficient =
+            parameter_handler.get_double("residual decrease coefficient");
+          nonlinear_solve.min_step_length = parameter_handler.get_double("min step size");
+
+          // Inexact newton parameters
+          nonlinear_solve.use_eisenstat_walker =
+            parameter_handler.get_bool("use eisenstat walker");
+          nonlinear_solve.max_forcing_term =
+            parameter_handler.get_double("max forcing term");
 
           parameter_handler.leave_subsection();
         }
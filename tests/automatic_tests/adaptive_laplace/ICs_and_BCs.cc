@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <prismspf/config.h>
+#include <prismspf/core/initial_conditions.h>
+#include <prismspf/core/nonuniform_dirichlet.h>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+template <int dim>
+void
+customInitialCondition<dim>::set_initial_condition(
+  [[maybe_unused]] const unsigned int       &index,
+  [[maybe_unused]] const unsigned int       &component,
+  [[maybe_unused]] const dealii::Point<dim> &point,
+  [[maybe_unused]] double                   &scalar_value,
+  [[maybe_unused]] double                   &vector_component_value) const
+{
+  // The indicator field is the exact solution of the Laplace equation, so both fields
+  // are represented exactly on any mesh, including the hanging nodes
+  if (index == 1)
+    {
+      scalar_value = point[0];
+    }
+}
+
+template <int dim>
+void
+customNonuniformDirichlet<dim>::set_nonuniform_dirichlet(
+  [[maybe_unused]] const unsigned int       &index,
+  [[maybe_unused]] const unsigned int       &boundary_id,
+  [[maybe_unused]] const unsigned int       &component,
+  [[maybe_unused]] const dealii::Point<dim> &point,
+  [[maybe_unused]] double                   &scalar_value,
+  [[maybe_unused]] double                   &vector_component_value) const
+{}
+
+INSTANTIATE_UNI_TEMPLATE(customInitialCondition)
+INSTANTIATE_UNI_TEMPLATE(customNonuniformDirichlet)
+
+PRISMS_PF_END_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <prismspf/config.h>
+#include <prismspf/core/initial_conditions.h>
+#include <prismspf/core/nonuniform_dirichlet.h>
+
+#include <cmath>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+template <int dim>
+void
+customInitialCondition<dim>::set_initial_condition(
+  [[maybe_unused]] const unsigned int       &index,
+  [[maybe_unused]] const unsigned int       &component,
+  [[maybe_unused]] const dealii::Point<dim> &point,
+  [[maybe_unused]] double                   &scalar_value,
+  [[maybe_unused]] double                   &vector_component_value) const
+{
+  // The concentration is uniform, so it doesn't evolve and the chemical potential
+  // converges to f'(0.1) = 0.144 in the first increment. The initial guess of the
+  // chemical potential is perturbed, so that the newton iterations are coupled.
+  if (index == 0)
+    {
+      scalar_value = 0.1;
+    }
+  else if (index == 2)
+    {
+      scalar_value = 0.5 * std::cos(2.0 * M_PI * point[0] / 100.0) *
+                     std::cos(2.0 * M_PI * point[1] / 100.0);
+    }
+}
+
+template <int dim>
+void
+customNonuniformDirichlet<dim>::set_nonuniform_dirichlet(
+  [[maybe_unused]] const unsigned int       &index,
+  [[maybe_unused]] const unsigned int       &boundary_id,
+  [[maybe_unused]] const unsigned int       &component,
+  [[maybe_unused]] const dealii::Point<dim> &point,
+  [[maybe_unused]] double                   &scalar_value,
+  [[maybe_unused]] double                   &vector_component_value) const
+{}
+
+INSTANTIATE_UNI_TEMPLATE(customInitialCondition)
+INSTANTIATE_UNI_TEMPLATE(customNonuniformDirichlet)
+
+PRISMS_PF_END_NAMESPACE
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include "custom_pde.h"
+
+#include <prismspf/config.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attribute_loader.h>
+
+PRISMS_PF_BEGIN_NAMESPACE
+
+void
+customAttributeLoader::loadVariableAttributes()
+{
+  set_variable_name(0, "c");
+  set_variable_type(0, SCALAR);
+  set_variable_equation_type(0, IMPLICIT_TIME_DEPENDENT);
+  set_dependencies_value_term_RHS(0, "c, old_1(c)");
+  set_dependencies_gradient_term_RHS(0, "grad(mu)");
+  set_dependencies_value_term_LHS(0, "change(c)");
+  set_dependencies_gradient_term_LHS(0, "grad(change(mu))");
+
+  set_variable_name(1, "f_tot");
+  set_variable_type(1, SCALAR);
+  set_variable_equation_type(1, EXPLICIT_TIME_DEPENDENT);
+  set_is_postprocessed_field(1, true);
+  set_dependencies_value_term_RHS(1, "c, grad(c)");
+
+  set_variable_name(2, "mu");
+  set_variable_type(2, SCALAR);
+  set_variable_equation_type(2, TIME_INDEPENDENT);
+  set_dependencies_value_term_RHS(2, "c, mu");
+  set_dependencies_gradient_term_RHS(2, "grad(c)");
+  set_dependencies_value_term_LHS(2, "c, change(c), change(mu)");
+  set_dependencies_gradient_term_LHS(2, "grad(change(c))");
+}
+
+template <int dim, int degree, typename number>
+void
+customPDE<dim, degree, number>::compute_explicit_RHS(
+  [[maybe_unused]] variableContainer<dim, degree, number> &variable_list,
+  [[maybe_unused]] const dealii::Point<dim, dealii::VectorizedArray<number>> &q_point_loc)
+  const
+{}
+
+template <int dim, int degree, typename number>
+void
+customPDE<dim, degree, number>::compute_nonexplicit_RHS(
+  [[maybe_unused]] variableContainer<dim, degree, number> &variable_list,
+  [[maybe_unused]] const dealii::Point<dim, dealii::VectorizedArray<number>> &q_point_loc)
+  const
+{
+  // c and mu are co-nonlinear, so both residuals are submitted together
+  scalarValue c     = variable_list.get_scalar_value(0);
+  scalarValue old_c = variable_list.get_scalar_value(0, OLD_1);
+  scalarGrad  cx    = variable_list.get_scalar_gradient(0);
+  scalarValue mu    = variable_list.get_scalar_value(2);
+  scalarGrad  mux   = variable_list.get_scalar_gradient(2);
+
+  scalarValue fcV = 4.0 * (c - 1.0) * (c - 0.5) * c;
+
+  scalarValue eq_c  = old_c - c;
+  scalarGrad  eqx_c = -McV * this->user_inputs.temporal_discretization.dt * mux;
+
+  scalarValue eq_mu  = fcV - mu;
+  scalarGrad  eqx_mu = KcV * cx;
+
+  variable_list.set_scalar_value_term(0, eq_c);
+  variable_list.set_scalar_gradient_term(0, eqx_c);
+  variable_list.set_scalar_value_term(2, eq_mu);
+  variable_list.set_scalar_gradient_term(2, eqx_mu);
+}
+
+template <int dim, int degree, typename number>
+void
+customPDE<dim, degree, number>::compute_nonexplicit_LHS(
+  [[maybe_unused]] variableContainer<dim, degree, number> &variable_list,
+  [[maybe_unused]] const dealii::Point<dim, dealii::VectorizedArray<number>> &q_point_loc)
+  const
+{
+  scalarValue c          = variable_list.get_scalar_value(0);
+  scalarValue change_c   = variable_list.get_scalar_value(0, CHANGE);
+  scalarGrad  change_cx  = variable_list.get_scalar_gradient(0, CHANGE);
+  scalarValue change_mu  = variable_list.get_scalar_value(2, CHANGE);
+  scalarGrad  change_mux = variable_list.get_scalar_gradient(2, CHANGE);
+
+  scalarValue fccV = 12.0 * c * c - 12.0 * c + 2.0;
+
+  scalarValue eq_change_c = change_c;
+  scalarGrad  eqx_change_c =
+    McV * this->user_inputs.temporal_discretization.dt * change_mux;
+
+  scalarValue eq_change_mu  = change_mu - fccV * change_c;
+  scalarGrad  eqx_change_mu = -KcV * change_cx;
+
+  variable_list.set_scalar_value_term(0, eq_change_c, CHANGE);
+  variable_list.set_scalar_gradient_term(0, eqx_change_c, CHANGE);
+  variable_list.set_scalar_value_term(2, eq_change_mu, CHANGE);
+  variable_list.set_scalar_gradient_term(2, eqx_change_mu, CHANGE);
+}
+
+template <int dim, int degree, typename number>
+void
+customPDE<dim, degree, number>::compute_postprocess_explicit_RHS(
+  [[maybe_unused]] variableContainer<dim, degree, number> &variable_list,
+  [[maybe_unused]] const dealii::Point<dim, dealii::VectorizedArray<number>> &q_point_loc)
+  const
+{
+  scalarValue c  = variable_list.get_scalar_value(0);
+  scalarGrad  cx = variable_list.get_scalar_gradient(0);
+
+  scalarValue f_chem = c * c * c * c - 2.0 * c * c * c + c * c;
+  scalarValue f_grad = 0.5 * KcV * (cx * cx);
+
+  variable_list.set_scalar_value_term(1, f_chem + f_grad);
+}
+
+INSTANTIATE_TRI_TEMPLATE(customPDE)
+
+PRISMS_PF_END_NAMESPACE
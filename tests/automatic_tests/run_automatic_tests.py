@@ -57,7 +57,7 @@ def grab_cpu_information():
     return architecture, cpu_model, cpu_cores, cpu_max_freq, cpu_min_freq, hypervisor
 
 
-def compile_and_run_simulation(application_path, n_threads=1):
+def compile_and_run_simulation(application_path, n_threads=1, n_ranks=1):
     # Navigate to test application directory
     os.chdir(application_path)
 
@@ -102,7 +102,7 @@ def compile_and_run_simulation(application_path, n_threads=1):
     with open("output.txt", "w") as outfile:
         try:
             subprocess.run(
-                ["mpirun", "-n", "1", "./main"],
+                ["mpirun", "-n", f"{n_ranks}", "./main"],
                 stdout=outfile,
                 stderr=subprocess.PIPE,
                 check=True,
@@ -126,7 +126,9 @@ def run_regression_test(application, new_gold_standard, test_dir):
     application_path = os.path.join(test_dir, application)
 
     # Run the simulation and move the results to the test directory
-    test_time = compile_and_run_simulation(application_path)
+    test_time = compile_and_run_simulation(
+        application_path, n_ranks=applicationRanks.get(application, 1)
+    )
 
     # Compare the result against the gold standard, if it exists
     tolerance = 1e-3
@@ -237,6 +239,13 @@ applicationList = [
     "cahn_hilliard_explicit",
     "heat_equation_steady_state",
     "poisson",
+    "allen_cahn_parareal",
+    "poisson_mixed_precision",
+    "heat_equation_resolve",
+    "adaptive_laplace",
+    "heat_equation_fully_distributed",
+    "cahn_hilliard_implicit",
+    "poisson_gmg",
 ]
 getNewGoldStandardList = [
     False,
@@ -244,8 +253,24 @@ getNewGoldStandardList = [
     False,
     False,
     False,
+    False,
+    False,
+    False,
+    False,
+    False,
+    False,
+    False,
 ]
 
+# Number of MPI processes for the applications that don't run in serial. The parareal
+# test runs two time slices with two processes each. The fully distributed test spreads
+# the coarse cells over the processes, so it needs at least two of them to check the
+# periodic ghost cells.
+applicationRanks = {
+    "allen_cahn_parareal": 4,
+    "heat_equation_fully_distributed": 4,
+}
+
 # Grab cpu information
 architecture, cpu_model, cpu_cores, cpu_max_freq, cpu_min_freq, hypervisor = (
     grab_cpu_information()
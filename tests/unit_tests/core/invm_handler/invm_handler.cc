@@ -0,0 +1,272 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/core/invm_handler.h>
+#include <prismspf/core/matrix_free_operator.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attribute_loader.h>
+#include <prismspf/core/variable_attributes.h>
+#include <prismspf/core/variable_container.h>
+#include <prismspf/user_inputs/input_file_reader.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  constexpr int dim    = 2;
+  constexpr int degree = 2;
+
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+  using size_type  = dealii::VectorizedArray<double>;
+
+  /**
+   * Explicit field u with the degree of the problem and explicit field v with a reduced
+   * degree, which depend on each other.
+   */
+  class testAttributeLoader : public prisms::variableAttributeLoader
+  {
+  public:
+    void
+    loadVariableAttributes() override
+    {
+      set_variable_name(0, "u");
+      set_variable_type(0, prisms::SCALAR);
+      set_variable_equation_type(0, prisms::EXPLICIT_TIME_DEPENDENT);
+      set_dependencies_value_term_RHS(0, "u, v");
+
+      set_variable_name(1, "v");
+      set_variable_type(1, prisms::SCALAR);
+      set_variable_equation_type(1, prisms::EXPLICIT_TIME_DEPENDENT);
+      set_variable_degree_reduction(1, 1);
+      set_dependencies_value_term_RHS(1, "u, v");
+    }
+  };
+
+  /**
+   * Operator with the explicit updates u + v for both fields.
+   */
+  class testOperator : public prisms::matrixFreeOperator<dim, degree, double>
+  {
+  public:
+    using prisms::matrixFreeOperator<dim, degree, double>::matrixFreeOperator;
+
+  private:
+    void
+    compute_explicit_RHS(
+      prisms::variableContainer<dim, degree, double>       &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {
+      const size_type u = variable_list.get_scalar_value(0);
+      const size_type v = variable_list.get_scalar_value(1);
+
+      variable_list.set_scalar_value_term(0, u + v);
+      variable_list.set_scalar_value_term(1, u + v);
+    }
+
+    void
+    compute_nonexplicit_RHS(
+      [[maybe_unused]] prisms::variableContainer<dim, degree, double> &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {}
+
+    void
+    compute_nonexplicit_LHS(
+      [[maybe_unused]] prisms::variableContainer<dim, degree, double> &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {}
+
+    void
+    compute_postprocess_explicit_RHS(
+      [[maybe_unused]] prisms::variableContainer<dim, degree, double> &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {}
+  };
+
+  /**
+   * Assemble the row sums of the mass matrix of the given DoFs at the quadrature points
+   * of the problem degree.
+   */
+  dealii::Vector<double>
+  assemble_lumped_mass(const dealii::DoFHandler<dim> &dof_handler)
+  {
+    const dealii::QGaussLobatto<dim> quadrature(degree + 1);
+
+    dealii::FEValues<dim> fe_values(dof_handler.get_fe(),
+                                    quadrature,
+                                    dealii::update_values | dealii::update_JxW_values);
+
+    const unsigned int dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
+    std::vector<dealii::types::global_dof_index> local_dof_indices(dofs_per_cell);
+    dealii::Vector<double>                       lumped_mass(dof_handler.n_dofs());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        fe_values.reinit(cell);
+        cell->get_dof_indices(local_dof_indices);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            // The shape functions sum up to one, so the row sum is the integral of the
+            // shape function
+            for (unsigned int q = 0; q < quadrature.size(); ++q)
+              {
+                lumped_mass[local_dof_indices[i]] +=
+                  fe_values.shape_value(i, q) * fe_values.JxW(q);
+              }
+          }
+      }
+    return lumped_mass;
+  }
+} // namespace
+
+TEST_CASE("Reduced degree fields")
+{
+  testAttributeLoader attribute_loader;
+  attribute_loader.init_variable_attributes();
+  const std::map<unsigned int, prisms::variableAttributes> attributes =
+    attribute_loader.get_var_attributes();
+
+  const std::string parameters_filename = "reduced_degree_test.prm";
+  {
+    std::ofstream parameters(parameters_filename);
+    parameters << "set dim = 2\n"
+               << "set global refinement = 0\n"
+               << "set degree = 2\n"
+               << "subsection rectangular mesh\n"
+               << "  set x size = 1\n"
+               << "  set y size = 2\n"
+               << "  set x subdivisions = 3\n"
+               << "  set y subdivisions = 3\n"
+               << "end\n"
+               << "set time step = 1.0\n"
+               << "set number steps = 1\n"
+               << "set boundary condition for u = NATURAL\n"
+               << "set boundary condition for v = NATURAL\n";
+  }
+  prisms::inputFileReader          input_file_reader(parameters_filename, attributes);
+  prisms::userInputParameters<dim> user_inputs(input_file_reader,
+                                               input_file_reader.parameter_handler);
+
+  dealii::Triangulation<dim> triangulation;
+  dealii::GridGenerator::subdivided_hyper_rectangle(triangulation,
+                                                    {3, 3},
+                                                    dealii::Point<dim>(),
+                                                    dealii::Point<dim>(1.0, 2.0));
+
+  // Like the FESystem's of the problem, the degree of v is reduced by one
+  const dealii::FE_Q<dim>     fe_q(dealii::QGaussLobatto<1>(degree + 1));
+  const dealii::FE_Q<dim>     reduced_fe_q(dealii::QGaussLobatto<1>(degree));
+  const dealii::FESystem<dim> fe(fe_q, 1);
+  const dealii::FESystem<dim> reduced_fe(reduced_fe_q, 1);
+  dealii::DoFHandler<dim>     dof_handler(triangulation);
+  dealii::DoFHandler<dim>     reduced_dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+  reduced_dof_handler.distribute_dofs(reduced_fe);
+  REQUIRE(reduced_dof_handler.n_dofs() < dof_handler.n_dofs());
+
+  dealii::AffineConstraints<double> constraints;
+  constraints.close();
+
+  dealii::MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    (dealii::update_values | dealii::update_gradients | dealii::update_JxW_values |
+     dealii::update_quadrature_points);
+  auto matrix_free = std::make_shared<dealii::MatrixFree<dim, double>>();
+  matrix_free->reinit(dealii::MappingQ1<dim>(),
+                      std::vector<const dealii::DoFHandler<dim> *>(
+                        {&dof_handler, &reduced_dof_handler}),
+                      std::vector<const dealii::AffineConstraints<double> *>(
+                        {&constraints, &constraints}),
+                      dealii::QGaussLobatto<1>(degree + 1),
+                      additional_data);
+
+  prisms::invmHandler<dim, degree, double> invm_handler(attributes);
+  invm_handler.initialize(matrix_free);
+  invm_handler.compute_invm();
+
+  SECTION("Inverse mass matrix")
+  {
+    // Each degree has its own invm, which matches the assembled lumped mass
+    const std::vector<const dealii::DoFHandler<dim> *> dof_handlers = {
+      &dof_handler,
+      &reduced_dof_handler};
+    for (unsigned int index = 0; index < dof_handlers.size(); ++index)
+      {
+        const VectorType            &invm = invm_handler.get_invm(index);
+        const dealii::Vector<double> lumped_mass =
+          assemble_lumped_mass(*dof_handlers[index]);
+
+        REQUIRE(invm.size() == dof_handlers[index]->n_dofs());
+        for (unsigned int i = 0; i < invm.locally_owned_size(); ++i)
+          {
+            REQUIRE(std::abs(invm.local_element(i) * lumped_mass[i] - 1.0) < 1.0e-12);
+          }
+      }
+  }
+
+  SECTION("Explicit update")
+  {
+    // The lumped mass reproduces constants exactly, so u = 1 and v = 2 are both updated
+    // to 3, which checks that the fields of each degree are read and submitted at the
+    // same quadrature points.
+    VectorType u;
+    VectorType v;
+    VectorType new_u;
+    VectorType new_v;
+    matrix_free->initialize_dof_vector(u, 0);
+    matrix_free->initialize_dof_vector(v, 1);
+    matrix_free->initialize_dof_vector(new_u, 0);
+    matrix_free->initialize_dof_vector(new_v, 1);
+    u = 1.0;
+    v = 2.0;
+
+    std::unordered_map<std::pair<unsigned int, prisms::dependencyType>,
+                       unsigned int,
+                       prisms::pairHash>
+      global_to_local_solution;
+    global_to_local_solution.emplace(std::make_pair(0U, prisms::NORMAL), 0);
+    global_to_local_solution.emplace(std::make_pair(1U, prisms::NORMAL), 1);
+
+    testOperator system_matrix(user_inputs, attributes);
+    system_matrix.initialize(matrix_free);
+    system_matrix.add_global_to_local_mapping(global_to_local_solution);
+
+    std::vector<VectorType *> src = {&u, &v};
+    std::vector<VectorType *> dst = {&new_u, &new_v};
+    system_matrix.compute_explicit_update(dst, src);
+    new_u.scale(invm_handler.get_invm(0));
+    new_v.scale(invm_handler.get_invm(1));
+
+    for (unsigned int i = 0; i < new_u.locally_owned_size(); ++i)
+      {
+        REQUIRE(std::abs(new_u.local_element(i) - 3.0) < 1.0e-12);
+      }
+    for (unsigned int i = 0; i < new_v.locally_owned_size(); ++i)
+      {
+        REQUIRE(std::abs(new_v.local_element(i) - 3.0) < 1.0e-12);
+      }
+  }
+}
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
+// SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <prismspf/core/matrix_free_operator.h>
+#include <prismspf/core/type_enums.h>
+#include <prismspf/core/variable_attribute_loader.h>
+#include <prismspf/core/variable_attributes.h>
+#include <prismspf/core/variable_container.h>
+#include <prismspf/user_inputs/input_file_reader.h>
+#include <prismspf/user_inputs/user_input_parameters.h>
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  constexpr int dim    = 2;
+  constexpr int degree = 1;
+
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+  using size_type  = dealii::VectorizedArray<double>;
+
+  /**
+   * Single time-independent field whose LHS depends on the field itself.
+   */
+  class testAttributeLoader : public prisms::variableAttributeLoader
+  {
+  public:
+    void
+    loadVariableAttributes() override
+    {
+      set_variable_name(0, "u");
+      set_variable_type(0, prisms::SCALAR);
+      set_variable_equation_type(0, prisms::TIME_INDEPENDENT);
+      set_dependencies_value_term_RHS(0, "u");
+      set_dependencies_gradient_term_RHS(0, "grad(u)");
+      set_dependencies_value_term_LHS(0, "change(u), u");
+      set_dependencies_gradient_term_LHS(0, "grad(change(u))");
+    }
+  };
+
+  /**
+   * Operator with the LHS (1 + u^2) du + grad(du), which is linear in the change du, but
+   * has a coefficient that depends nonlinearly on u.
+   */
+  class testOperator : public prisms::matrixFreeOperator<dim, degree, double>
+  {
+  public:
+    using prisms::matrixFreeOperator<dim, degree, double>::matrixFreeOperator;
+
+  private:
+    void
+    compute_explicit_RHS(
+      [[maybe_unused]] prisms::variableContainer<dim, degree, double> &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {}
+
+    void
+    compute_nonexplicit_RHS(
+      [[maybe_unused]] prisms::variableContainer<dim, degree, double> &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {}
+
+    void
+    compute_nonexplicit_LHS(
+      prisms::variableContainer<dim, degree, double>       &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {
+      const size_type u        = variable_list.get_scalar_value(0);
+      const size_type change_u = variable_list.get_scalar_value(0, prisms::CHANGE);
+      const dealii::Tensor<1, dim, size_type> change_ux =
+        variable_list.get_scalar_gradient(0, prisms::CHANGE);
+
+      variable_list.set_scalar_value_term(0, (1.0 + u * u) * change_u, prisms::CHANGE);
+      variable_list.set_scalar_gradient_term(0, change_ux, prisms::CHANGE);
+    }
+
+    void
+    compute_postprocess_explicit_RHS(
+      [[maybe_unused]] prisms::variableContainer<dim, degree, double> &variable_list,
+      [[maybe_unused]] const dealii::Point<dim, size_type> &q_point_loc) const override
+    {}
+  };
+} // namespace
+
+TEST_CASE("Cached linearization")
+{
+  testAttributeLoader attribute_loader;
+  attribute_loader.init_variable_attributes();
+  const std::map<unsigned int, prisms::variableAttributes> attributes =
+    attribute_loader.get_var_attributes();
+
+  const std::string parameters_filename = "linearization_test.prm";
+  {
+    std::ofstream parameters(parameters_filename);
+    parameters << "set dim = 2\n"
+               << "set global refinement = 0\n"
+               << "set degree = 1\n"
+               << "subsection rectangular mesh\n"
+               << "  set x size = 1\n"
+               << "  set y size = 1\n"
+               << "  set x subdivisions = 4\n"
+               << "  set y subdivisions = 4\n"
+               << "end\n"
+               << "set boundary condition for u = NATURAL\n"
+               << "subsection linear solver parameters: u\n"
+               << "  set tolerance type = ABSOLUTE_RESIDUAL\n"
+               << "  set tolerance value = 1e-10\n"
+               << "  set max iterations = 100\n"
+               << "end\n";
+  }
+  prisms::inputFileReader          input_file_reader(parameters_filename, attributes);
+  prisms::userInputParameters<dim> user_inputs(input_file_reader,
+                                               input_file_reader.parameter_handler);
+
+  dealii::Triangulation<dim> triangulation;
+  dealii::GridGenerator::subdivided_hyper_rectangle(triangulation,
+                                                    {4, 4},
+                                                    dealii::Point<dim>(),
+                                                    dealii::Point<dim>(1.0, 1.0));
+  const dealii::FE_Q<dim>     fe_q(dealii::QGaussLobatto<1>(degree + 1));
+  const dealii::FESystem<dim> fe(fe_q, 1);
+  dealii::DoFHandler<dim>     dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  dealii::AffineConstraints<double> constraints;
+  constraints.close();
+
+  dealii::MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    (dealii::update_values | dealii::update_gradients | dealii::update_JxW_values |
+     dealii::update_quadrature_points);
+  auto matrix_free = std::make_shared<dealii::MatrixFree<dim, double>>();
+  matrix_free->reinit(dealii::MappingQ1<dim>(),
+                      dof_handler,
+                      constraints,
+                      dealii::QGaussLobatto<1>(degree + 1),
+                      additional_data);
+
+  // The src subset holds a placeholder for the change, followed by the dependencies of
+  // the LHS, like for the newton update of the solvers
+  VectorType solution;
+  VectorType placeholder;
+  VectorType change;
+  VectorType direct_product;
+  VectorType cached_product;
+  matrix_free->initialize_dof_vector(solution);
+  matrix_free->initialize_dof_vector(placeholder);
+  matrix_free->initialize_dof_vector(change);
+  matrix_free->initialize_dof_vector(direct_product);
+  matrix_free->initialize_dof_vector(cached_product);
+  for (unsigned int i = 0; i < solution.locally_owned_size(); ++i)
+    {
+      solution.local_element(i) = std::sin(1.0 + i);
+      change.local_element(i)   = std::cos(2.0 + i);
+    }
+
+  std::unordered_map<std::pair<unsigned int, prisms::dependencyType>,
+                     unsigned int,
+                     prisms::pairHash>
+    global_to_local_solution;
+  global_to_local_solution.emplace(std::make_pair(0U, prisms::CHANGE), 0);
+  global_to_local_solution.emplace(std::make_pair(0U, prisms::NORMAL), 1);
+
+  testOperator system_matrix(user_inputs, 0, attributes);
+  system_matrix.initialize(matrix_free);
+  system_matrix.add_global_to_local_mapping(global_to_local_solution);
+  system_matrix.add_src_solution_subset({&placeholder, &solution});
+
+  system_matrix.vmult(direct_product, change);
+  REQUIRE(direct_product.l2_norm() > 0.0);
+
+  // The LHS is linear in the change, so the cached linearization is exact
+  system_matrix.compute_linearization();
+  system_matrix.vmult(cached_product, change);
+  cached_product -= direct_product;
+  REQUIRE(cached_product.l2_norm() < 1.0e-12 * direct_product.l2_norm());
+
+  // Clearing the cache goes back to the user LHS
+  system_matrix.clear_linearization();
+  system_matrix.vmult(cached_product, change);
+  cached_product -= direct_product;
+  REQUIRE(cached_product.l2_norm() == 0.0);
+}
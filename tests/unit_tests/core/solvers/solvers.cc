@@ -1,2 +1,485 @@
 // SPDX-FileCopyrightText: © 2025 PRISMS Center at the University of Michigan
 // SPDX-License-Identifier: GNU Lesser General Public Version 2.1
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <prismspf/solvers/batched_cg.h>
+#include <prismspf/solvers/cell_patch_inverse.h>
+#include <prismspf/solvers/deflated_cg.h>
+#include <prismspf/solvers/jacobian_free_operator.h>
+#include <prismspf/solvers/pipelined_cg.h>
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+  /**
+   * Diagonal operator with a few isolated small eigenvalues, which are the slow modes
+   * for CG.
+   */
+  class diagonalOperator
+  {
+  public:
+    explicit diagonalOperator(unsigned int size)
+      : diagonal(size)
+    {
+      for (unsigned int i = 0; i < size; ++i)
+        {
+          diagonal[i] = i < 3 ? 1.0e-4 * (i + 1) : 1.0 + i;
+        }
+    }
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      for (unsigned int i = 0; i < dst.size(); ++i)
+        {
+          dst[i] = diagonal[i] * src[i];
+        }
+    }
+
+    double
+    operator()(unsigned int i) const
+    {
+      return diagonal[i];
+    }
+
+  private:
+    std::vector<double> diagonal;
+  };
+
+  /**
+   * Preconditioner that scales with the inverse square root of a diagonal operator, so
+   * that the preconditioned system is reasonably, but not perfectly, conditioned.
+   */
+  class diagonalPreconditioner
+  {
+  public:
+    explicit diagonalPreconditioner(const diagonalOperator &_matrix)
+      : matrix(_matrix)
+    {}
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      for (unsigned int i = 0; i < dst.size(); ++i)
+        {
+          dst[i] = src[i] / std::sqrt(matrix(i));
+        }
+    }
+
+  private:
+    const diagonalOperator &matrix;
+  };
+
+  using BlockVectorType = dealii::LinearAlgebra::distributed::BlockVector<double>;
+
+  /**
+   * Block diagonal operator with a differently scaled diagonal operator in each block.
+   */
+  class blockDiagonalOperator
+  {
+  public:
+    blockDiagonalOperator(unsigned int size, const std::vector<double> &_scaling)
+      : matrix(size)
+      , scaling(_scaling)
+    {}
+
+    void
+    vmult(BlockVectorType         &dst,
+          const BlockVectorType   &src,
+          const std::vector<bool> &active) const
+    {
+      for (unsigned int block = 0; block < dst.n_blocks(); ++block)
+        {
+          dst.block(block) = 0.0;
+          if (active[block])
+            {
+              matrix.vmult(dst.block(block), src.block(block));
+              dst.block(block) *= scaling[block];
+            }
+        }
+    }
+
+    double
+    operator()(unsigned int block, unsigned int i) const
+    {
+      return scaling[block] * matrix(i);
+    }
+
+  private:
+    diagonalOperator    matrix;
+    std::vector<double> scaling;
+  };
+
+  /**
+   * Residual b - (D u + u^3) of a diagonal operator D with a cubic nonlinearity.
+   */
+  class cubicResidual
+  {
+  public:
+    cubicResidual(const diagonalOperator &_matrix, const VectorType &_rhs)
+      : matrix(_matrix)
+      , rhs(_rhs)
+    {}
+
+    void
+    compute_residual(VectorType &dst, const VectorType &solution) const
+    {
+      for (unsigned int i = 0; i < dst.size(); ++i)
+        {
+          dst[i] = rhs[i] - (matrix(i) * solution[i]) -
+                   (solution[i] * solution[i] * solution[i]);
+        }
+    }
+
+  private:
+    const diagonalOperator &matrix;
+    const VectorType       &rhs;
+  };
+
+  constexpr int dim    = 2;
+  constexpr int degree = 3;
+
+  /**
+   * Matrix-free Laplace plus mass operator, applied to each component of the field.
+   */
+  template <int n_components>
+  class laplaceMassOperator
+  {
+  public:
+    using EvaluationType = dealii::FEEvaluation<dim, -1, 0, n_components, double>;
+
+    explicit laplaceMassOperator(
+      std::shared_ptr<const dealii::MatrixFree<dim, double>> _matrix_free)
+      : matrix_free(std::move(_matrix_free))
+    {}
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      matrix_free->cell_loop(&laplaceMassOperator::local_apply, this, dst, src, true);
+    }
+
+    void
+    compute_inverse_diagonal(VectorType &inverse_diagonal) const
+    {
+      matrix_free->initialize_dof_vector(inverse_diagonal);
+      dealii::MatrixFreeTools::compute_diagonal<dim,
+                                                -1,
+                                                0,
+                                                n_components,
+                                                double,
+                                                dealii::VectorizedArray<double>>(
+        *matrix_free,
+        inverse_diagonal,
+        [](EvaluationType &fe_eval)
+        {
+          apply_cell(fe_eval);
+        });
+      for (unsigned int i = 0; i < inverse_diagonal.locally_owned_size(); ++i)
+        {
+          inverse_diagonal.local_element(i) = 1.0 / inverse_diagonal.local_element(i);
+        }
+    }
+
+  private:
+    static void
+    apply_cell(EvaluationType &fe_eval)
+    {
+      fe_eval.evaluate(dealii::EvaluationFlags::values |
+                       dealii::EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < fe_eval.n_q_points; ++q)
+        {
+          fe_eval.submit_value(fe_eval.get_value(q), q);
+          fe_eval.submit_gradient(fe_eval.get_gradient(q), q);
+        }
+      fe_eval.integrate(dealii::EvaluationFlags::values |
+                        dealii::EvaluationFlags::gradients);
+    }
+
+    void
+    local_apply(const dealii::MatrixFree<dim, double>       &data,
+                VectorType                                  &dst,
+                const VectorType                            &src,
+                const std::pair<unsigned int, unsigned int> &cell_range) const
+    {
+      EvaluationType fe_eval(data);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+        {
+          fe_eval.reinit(cell);
+          fe_eval.read_dof_values(src);
+          apply_cell(fe_eval);
+          fe_eval.distribute_local_to_global(dst);
+        }
+    }
+
+    std::shared_ptr<const dealii::MatrixFree<dim, double>> matrix_free;
+  };
+
+  /**
+   * Create the matrix-free object of the given DoFs, without constraints.
+   */
+  std::shared_ptr<dealii::MatrixFree<dim, double>>
+  create_matrix_free(const dealii::DoFHandler<dim> &dof_handler)
+  {
+    dealii::AffineConstraints<double> constraints;
+    constraints.close();
+
+    dealii::MatrixFree<dim, double>::AdditionalData additional_data;
+    additional_data.mapping_update_flags =
+      (dealii::update_values | dealii::update_gradients | dealii::update_JxW_values);
+    auto matrix_free = std::make_shared<dealii::MatrixFree<dim, double>>();
+    matrix_free->reinit(dealii::MappingQ1<dim>(),
+                        dof_handler,
+                        constraints,
+                        dealii::QGauss<1>(degree + 1),
+                        additional_data);
+    return matrix_free;
+  }
+} // namespace
+
+#ifdef DEAL_II_WITH_LAPACK
+
+TEST_CASE("Deflated CG")
+{
+  const unsigned int size = 200;
+  diagonalOperator   matrix(size);
+
+  VectorType solution(size);
+  VectorType rhs(size);
+
+  prisms::deflatedCG<VectorType> solver(4);
+
+  // Solve twice with related right-hand sides. The second solve deflates the subspace
+  // recycled from the first one, so it doesn't have to resolve the slow modes again.
+  std::vector<unsigned int> n_iterations;
+  for (unsigned int solve = 0; solve < 2; ++solve)
+    {
+      for (unsigned int i = 0; i < size; ++i)
+        {
+          rhs[i] = std::sin(1.0 + i) + (solve == 0 ? 0.0 : 0.1 * std::cos(2.0 + i));
+        }
+      solution = 0.0;
+
+      dealii::SolverControl solver_control(1000, 1.0e-12 * rhs.l2_norm());
+      REQUIRE_NOTHROW(solver.solve(solver_control,
+                                   matrix,
+                                   solution,
+                                   rhs,
+                                   dealii::PreconditionIdentity()));
+
+      for (unsigned int i = 0; i < size; ++i)
+        {
+          REQUIRE(std::abs(solution[i] - rhs[i] / matrix(i)) < 1.0e-6);
+        }
+      REQUIRE(solver.get_subspace_dimension() > 0);
+      REQUIRE(solver.get_subspace_dimension() <= 4);
+      n_iterations.push_back(solver_control.last_step());
+    }
+
+  // The first solve is plain CG, since there is no subspace yet
+  REQUIRE(n_iterations[1] < n_iterations[0]);
+}
+
+TEST_CASE("Cell patch inverse")
+{
+  // On a single cell, the block is the whole operator, so the preconditioner is its
+  // exact inverse. The field has two components, which share the block.
+  dealii::Triangulation<dim> triangulation;
+  dealii::GridGenerator::hyper_rectangle(triangulation,
+                                         dealii::Point<dim>(),
+                                         dealii::Point<dim>(1.0, 0.5));
+  const dealii::FE_Q<dim>     fe_q(dealii::QGaussLobatto<1>(degree + 1));
+  const dealii::FESystem<dim> fe(fe_q, 2);
+  dealii::DoFHandler<dim>     dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  const auto                   matrix_free = create_matrix_free(dof_handler);
+  const laplaceMassOperator<2> matrix(matrix_free);
+
+  VectorType inverse_diagonal;
+  matrix.compute_inverse_diagonal(inverse_diagonal);
+  prisms::cellPatchInverse<dim, double> preconditioner;
+  preconditioner.initialize(matrix_free, inverse_diagonal, 0);
+
+  VectorType solution;
+  VectorType rhs;
+  VectorType result;
+  matrix_free->initialize_dof_vector(solution);
+  matrix_free->initialize_dof_vector(rhs);
+  matrix_free->initialize_dof_vector(result);
+  for (unsigned int i = 0; i < solution.locally_owned_size(); ++i)
+    {
+      solution.local_element(i) = std::sin(1.0 + i);
+    }
+
+  matrix.vmult(rhs, solution);
+  preconditioner.vmult(result, rhs);
+  result -= solution;
+  REQUIRE(result.l2_norm() < 1.0e-10 * solution.l2_norm());
+}
+
+TEST_CASE("Cell patch preconditioned CG")
+{
+  dealii::Triangulation<dim> triangulation;
+  dealii::GridGenerator::subdivided_hyper_rectangle(triangulation,
+                                                    {4, 4},
+                                                    dealii::Point<dim>(),
+                                                    dealii::Point<dim>(1.0, 1.0));
+  triangulation.refine_global(2);
+  const dealii::FE_Q<dim>     fe_q(dealii::QGaussLobatto<1>(degree + 1));
+  const dealii::FESystem<dim> fe(fe_q, 1);
+  dealii::DoFHandler<dim>     dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  const auto                   matrix_free = create_matrix_free(dof_handler);
+  const laplaceMassOperator<1> matrix(matrix_free);
+
+  VectorType inverse_diagonal;
+  matrix.compute_inverse_diagonal(inverse_diagonal);
+  dealii::DiagonalMatrix<VectorType> jacobi;
+  jacobi.reinit(inverse_diagonal);
+  prisms::cellPatchInverse<dim, double> cell_patch;
+  cell_patch.initialize(matrix_free, inverse_diagonal, 0);
+
+  VectorType solution;
+  VectorType rhs;
+  matrix_free->initialize_dof_vector(solution);
+  matrix_free->initialize_dof_vector(rhs);
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    {
+      rhs.local_element(i) = std::sin(1.0 + i);
+    }
+
+  // The cell blocks capture the coupling within the cells, which point-Jacobi misses
+  dealii::SolverControl        jacobi_control(1000, 1.0e-10 * rhs.l2_norm());
+  dealii::SolverCG<VectorType> jacobi_solver(jacobi_control);
+  REQUIRE_NOTHROW(jacobi_solver.solve(matrix, solution, rhs, jacobi));
+
+  solution = 0.0;
+  dealii::SolverControl        cell_patch_control(1000, 1.0e-10 * rhs.l2_norm());
+  dealii::SolverCG<VectorType> cell_patch_solver(cell_patch_control);
+  REQUIRE_NOTHROW(cell_patch_solver.solve(matrix, solution, rhs, cell_patch));
+
+  REQUIRE(cell_patch_control.last_step() < jacobi_control.last_step());
+}
+
+#endif
+
+TEST_CASE("Pipelined CG")
+{
+  const unsigned int size = 200;
+  diagonalOperator   matrix(size);
+
+  VectorType solution(size);
+  VectorType rhs(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      rhs[i] = std::sin(1.0 + i);
+    }
+
+  dealii::SolverControl           solver_control(1000, 1.0e-12 * rhs.l2_norm());
+  prisms::pipelinedCG<VectorType> solver(solver_control);
+  REQUIRE_NOTHROW(solver.solve(matrix, solution, rhs, diagonalPreconditioner(matrix)));
+
+  // The residual is updated by recurrence, so compare against the exact solution
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      REQUIRE(std::abs(solution[i] - rhs[i] / matrix(i)) < 1.0e-6);
+    }
+}
+
+TEST_CASE("Batched CG")
+{
+  const unsigned int    size = 200;
+  blockDiagonalOperator matrix(size, {1.0, 1.0e3});
+
+  BlockVectorType solution(2, size);
+  BlockVectorType rhs(2, size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      rhs.block(0)[i] = std::sin(1.0 + i);
+      rhs.block(1)[i] = std::cos(2.0 + i);
+    }
+
+  // The blocks have their own tolerances, so they converge after a different number of
+  // iterations
+  dealii::SolverControl first_control(1000, 1.0e-12 * rhs.block(0).l2_norm());
+  dealii::SolverControl second_control(1000, 1.0e-6 * rhs.block(1).l2_norm());
+  prisms::batchedCG<BlockVectorType> solver({&first_control, &second_control});
+  REQUIRE_NOTHROW(solver.solve(matrix, solution, rhs, dealii::PreconditionIdentity()));
+
+  REQUIRE(first_control.last_step() > second_control.last_step());
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      REQUIRE(std::abs(solution.block(0)[i] - rhs.block(0)[i] / matrix(0, i)) < 1.0e-6);
+    }
+  REQUIRE(second_control.last_value() < 1.0e-6 * rhs.block(1).l2_norm());
+}
+
+TEST_CASE("Jacobian-free operator")
+{
+  const unsigned int size = 200;
+  diagonalOperator   matrix(size);
+
+  VectorType solution(size);
+  VectorType rhs(size);
+  VectorType direction(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      solution[i]  = std::sin(1.0 + i);
+      rhs[i]       = std::cos(2.0 + i);
+      direction[i] = std::cos(3.0 + i);
+    }
+  const VectorType original_solution = solution;
+
+  dealii::AffineConstraints<double> constraints;
+  constraints.close();
+
+  const cubicResidual residual_operator(matrix, rhs);
+  VectorType          residual(size);
+  residual_operator.compute_residual(residual, solution);
+
+  prisms::jacobianFreeOperator<cubicResidual, VectorType> jacobian(residual_operator,
+                                                                   solution,
+                                                                   constraints);
+  jacobian.reinit(residual);
+
+  VectorType product(size);
+  jacobian.vmult(product, direction);
+
+  // Compare against the exact Jacobian D + 3 u^2
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      const double exact =
+        (matrix(i) + (3.0 * solution[i] * solution[i])) * direction[i];
+      REQUIRE(std::abs(product[i] - exact) < 1.0e-5 * (1.0 + std::abs(exact)));
+      REQUIRE(solution[i] == original_solution[i]);
+    }
+}